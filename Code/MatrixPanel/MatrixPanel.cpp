@@ -1,15 +1,25 @@
 // MatrixPanel.cpp
 #include "MatrixPanel.h"
 
-MatrixPanel::MatrixPanel(uint8_t pinPanel0, uint8_t pinPanel1)
-  : pin0(pinPanel0), pin1(pinPanel1) {}
+// Meldet jede Kachel aus MatrixPanelLayout mit ihrem Datenpin bei FastLED an
+struct AddMatrixControllers {
+  CRGB* leds;
+
+  template<typename PanelTile>
+  void visit(uint8_t index) {
+    FastLED.addLeds<WS2812, PanelTile::pin, GRB>(
+      leds + index * MatrixPanelLayout::LEDS_PER_TILE,
+      MatrixPanelLayout::LEDS_PER_TILE);
+  }
+};
+
+MatrixPanel::MatrixPanel() {}
 
 void MatrixPanel::begin() {
   delay(50);
 
-  FastLED.addLeds<WS2812, 25, GRB>(leds, ledsPerPanel);
-  FastLED.addLeds<WS2812, 26, GRB>(leds + ledsPerPanel,
-                                              ledsPerPanel);
+  AddMatrixControllers controllers = { leds };
+  MatrixPanelLayout::forEachTile(controllers);
 
   FastLED.setBrightness(120);
 
@@ -19,27 +29,7 @@ void MatrixPanel::begin() {
 
 uint16_t MatrixPanel::XY(uint16_t x, uint16_t y) {
   if (x >= totalWidth || y >= totalHeight) return UINT16_MAX;
-
-  uint8_t panel = (y < panelHeight) ? 0 : 1;
-  uint16_t panelOffset = panel * ledsPerPanel;
-
-  uint16_t localY = y % panelHeight;
-  uint16_t localX = x;
-
-  if (panel == 1) {
-    localX = (panelWidth - 1) - localX;
-    localY = (panelHeight - 1) - localY;
-  }
-
-  uint16_t indexInPanel;
-
-  if ((localX & 1) == 0) {
-    indexInPanel = localX * panelHeight + localY;
-  } else {
-    indexInPanel = localX * panelHeight + (panelHeight - 1 - localY);
-  }
-
-  return panelOffset + indexInPanel;
+  return MatrixPanelLayout::XY(x, y);
 }
 
 void MatrixPanel::setPixelXY(uint16_t x, uint16_t y,
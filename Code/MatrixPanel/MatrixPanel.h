@@ -3,10 +3,17 @@
 #define MATRIXPANEL_H
 
 #include <FastLED.h>
+#include <PanelLayout.h>   // Bibliothek PixelLayout (lib_deps: symlink://../PixelLayout)
+
+// Zwei 32x8 Panels übereinander, das untere (Pin 26) kopfüber montiert
+typedef PanelLayout<32, 8, 1, 2,
+                    Tile<25>,
+                    Tile<26, TileOrientation::ROTATE_180>
+                   > MatrixPanelLayout;
 
 class MatrixPanel {
 public:
-  MatrixPanel(uint8_t pinPanel0, uint8_t pinPanel1);
+  MatrixPanel();
 
   void begin();
   void setPixelXY(uint16_t x, uint16_t y, const CRGB &color);
@@ -15,20 +22,13 @@ public:
   void clearAll();
 
 private:
-  static const uint8_t panelHeight = 8;
-  static const uint8_t panelWidth  = 32;
-  static const uint8_t panelCount  = 2;
-
-  static const uint16_t totalWidth  = panelWidth;
-  static const uint16_t totalHeight = panelHeight * panelCount;
+  static const uint16_t totalWidth  = MatrixPanelLayout::WIDTH;
+  static const uint16_t totalHeight = MatrixPanelLayout::HEIGHT;
 
-  static const uint16_t ledsPerPanel = panelHeight * panelWidth;
-  static const uint16_t ledsTotal    = ledsPerPanel * panelCount;
+  static const uint16_t ledsPerPanel = MatrixPanelLayout::LEDS_PER_TILE;
+  static const uint16_t ledsTotal    = MatrixPanelLayout::LED_COUNT;
 
   CRGB leds[ledsTotal];
-
-  uint8_t pin0;
-  uint8_t pin1;
 };
 
 #endif
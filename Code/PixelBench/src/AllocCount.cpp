@@ -0,0 +1,43 @@
+/**
+ * @file AllocCount.cpp
+ * @brief Zählt Heap-Allokationen über ersetzte globale operator new.
+ *
+ * String, std::string und std::vector gehen alle über operator new,
+ * damit sieht der Bench jede Allokation der App-Stufen.
+ */
+
+#include "Bench.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint32_t> allocations(0);
+
+uint32_t benchAllocations() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  void* p = std::malloc(size ? size : 1);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+  return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
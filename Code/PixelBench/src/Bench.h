@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_CYCLES 1
+#else
+#define BENCH_HAS_CYCLES 0
+#endif
+
+// Jede Stufe läuft BENCH_RUNS-mal über eine feste Anzahl Frames, der
+// Median je Frame zählt. Der erste Durchlauf wärmt nur Caches und Tabellen.
+#define BENCH_RUNS  7
+
+struct BenchResult {
+  const char* name;
+  double nsPerFrame;
+  double cyclesPerFrame;   // TSC-Takte, 0 wenn nicht verfügbar
+};
+
+// Aufrufe von operator new seit Programmstart (AllocCount.cpp)
+uint32_t benchAllocations();
+
+// Verhindert, dass der Compiler Ergebnisse oder Speicherzugriffe wegoptimiert
+inline void benchClobber() {
+  asm volatile("" ::: "memory");
+}
+
+template<typename T>
+inline void benchKeep(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline uint64_t benchCycles() {
+#if BENCH_HAS_CYCLES
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+template<typename Frame>
+BenchResult benchRun(const char* name, uint32_t frames, Frame frame) {
+  double ns[BENCH_RUNS];
+  double cycles[BENCH_RUNS];
+
+  for (uint8_t run = 0; run <= BENCH_RUNS; run++) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t cycleStart = benchCycles();
+
+    for (uint32_t i = 0; i < frames; i++) {
+      frame();
+      benchClobber();
+    }
+
+    uint64_t cycleEnd = benchCycles();
+    auto end = std::chrono::steady_clock::now();
+    if (run == 0) continue;
+
+    ns[run - 1] = std::chrono::duration<double, std::nano>(end - start).count() / frames;
+    cycles[run - 1] = (double)(cycleEnd - cycleStart) / frames;
+  }
+
+  std::sort(ns, ns + BENCH_RUNS);
+  std::sort(cycles, cycles + BENCH_RUNS);
+  return BenchResult{ name, ns[BENCH_RUNS / 2], cycles[BENCH_RUNS / 2] };
+}
@@ -0,0 +1,140 @@
+#include "Stages.h"
+
+// DisplayManager mit Ausgabe-Task, unverändert übernommen; ausgegeben wird
+// über das Zeitmodell statt über FastLED
+#include "../../Zeit_anzeigen/src/DisplayManager.cpp"
+#include "../../Zeit_anzeigen/src/TimingModelOutput.cpp"
+
+// ==================== AUSGABE ÜBER DAS ZEITMODELL ====================
+//
+// Prüft, was DisplayManager an die Ausgabe weitergibt: welche Panels
+// (Maske), wie lange der Draht parallel bzw. nacheinander belegt wäre und
+// welche Bytes herauskämen (GRB, Helligkeit wie scale8). Mitgeführt wird
+// ein eigenes LED-Bild, gegen das die kodierten Bytes verglichen werden.
+
+#define DISPLAY_WAIT_MS       1000
+#define DISPLAY_RACE_FRAMES   2000
+
+static CRGB expectedLeds[BoardLayout::LED_COUNT];
+
+static void displaySet(DisplayManager* display, uint8_t x, uint8_t y, CRGB color) {
+  display->setPixel(x, y, color);
+  expectedLeds[BoardLayout::XY(x, y)] = color;
+}
+
+// Bis der Ausgabe-Task frames Bilder ausgegeben hat; false bei Timeout
+static bool waitForFrames(const TimingModelOutput* model, uint32_t frames) {
+  for (uint16_t ms = 0; ms < DISPLAY_WAIT_MS; ms++) {
+    if (model->getFrameCount() >= frames) return true;
+    delay(1);
+  }
+  return false;
+}
+
+// Bis der Ausgabe-Task 20 ms lang kein Bild mehr ausgegeben hat
+static void waitForIdle(const TimingModelOutput* model) {
+  uint32_t frames = model->getFrameCount();
+  for (uint16_t quiet = 0; quiet < 20; quiet++) {
+    delay(1);
+    if (model->getFrameCount() != frames) {
+      frames = model->getFrameCount();
+      quiet = 0;
+    }
+  }
+}
+
+// Ein Bild zeigen und prüfen, dass genau die Panels aus mask rausgehen
+static bool expectPush(DisplayManager* display, const TimingModelOutput* model,
+                       uint8_t mask, const char* step) {
+  const uint32_t frames = model->getFrameCount();
+  display->show();
+  if (!waitForFrames(model, frames + 1)) {
+    Serial.printf("FEHLER: Ausgabe (%s): kein Bild vom Ausgabe-Task\n", step);
+    return false;
+  }
+
+  uint8_t panels = 0;
+  for (uint8_t i = 0; i < PANEL_COUNT; i++) {
+    if (mask & (1 << i)) panels++;
+  }
+  const uint32_t wire = LedOutput::wireTimeUs(LEDS_PER_PANEL);
+  if (model->getLastMask() != mask ||
+      model->getLastFrameUs() != wire ||
+      model->getLastSequentialUs() != wire * panels) {
+    Serial.printf("FEHLER: Ausgabe (%s): Maske %02x statt %02x, %u/%u µs statt %u/%u µs\n",
+                  step, model->getLastMask(), mask,
+                  model->getLastFrameUs(), model->getLastSequentialUs(), wire, wire * panels);
+    return false;
+  }
+  return true;
+}
+
+// Kodierte Bytes jedes Panels gegen das mitgeführte Bild
+static bool expectEncoded(const TimingModelOutput* model, uint8_t brightness, const char* step) {
+  static uint8_t expected[LEDS_PER_PANEL * 3];
+  for (uint8_t i = 0; i < PANEL_COUNT; i++) {
+    LedOutput::encodeGRB(expectedLeds + i * LEDS_PER_PANEL, LEDS_PER_PANEL, brightness, expected);
+    if (memcmp(model->getEncoded(i), expected, sizeof(expected)) != 0) {
+      Serial.printf("FEHLER: Ausgabe (%s): Panel %u zeigt nicht das aktuelle Bild\n", step, i);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool displayOutputCheck() {
+  DisplayManager* display = DisplayManager::getInstance();
+  display->init(OutputBackend::TIMING_MODEL);
+  const TimingModelOutput* model = static_cast<const TimingModelOutput*>(display->getOutput());
+  if (strcmp(model->getName(), "Timing model") != 0 || model->getFrameCount() != 1) {
+    Serial.printf("FEHLER: Ausgabe: %s statt Zeitmodell, oder init() ohne Startbild\n", model->getName());
+    return false;
+  }
+
+  // Erstes show() schiebt alle Panels raus, danach nur geänderte
+  display->clear();
+  if (!expectPush(display, model, 0x03, "erstes Bild")) return false;
+  displaySet(display, 5, 2, CRGB::Red);
+  if (!expectPush(display, model, 0x01, "oberes Panel")) return false;
+  displaySet(display, 20, 12, CRGB::Blue);
+  if (!expectPush(display, model, 0x02, "unteres Panel")) return false;
+  displaySet(display, 0, 7, CRGB::Green);
+  displaySet(display, 31, 8, CRGB::Green);
+  if (!expectPush(display, model, 0x03, "beide Panels")) return false;
+
+  // Unverändertes Bild: kein Push
+  const uint32_t frames = model->getFrameCount();
+  const uint32_t skipped = display->getFramesSkipped();
+  display->show();
+  delay(5);
+  if (model->getFrameCount() != frames || display->getFramesSkipped() != skipped + 1) {
+    Serial.printf("FEHLER: Ausgabe: unverändertes Bild wurde ausgegeben\n");
+    return false;
+  }
+
+  // Kodierung: GRB, Helligkeit wie scale8, neue Helligkeit schiebt alles raus
+  const uint8_t brightness = 100;
+  display->setBrightness(brightness);
+  displaySet(display, 7, 9, CRGB(200, 50, 10));
+  if (!expectPush(display, model, 0x03, "Helligkeit")) return false;
+  const uint16_t led = BoardLayout::XY(7, 9) % LEDS_PER_PANEL;
+  const uint8_t* bytes = model->getEncoded(BoardLayout::XY(7, 9) / LEDS_PER_PANEL) + led * 3;
+  if (bytes[0] != scale8(50, brightness) || bytes[1] != scale8(200, brightness) || bytes[2] != scale8(10, brightness)) {
+    Serial.printf("FEHLER: Ausgabe: Pixel kodiert als %u/%u/%u statt GRB %u/%u/%u\n",
+                  bytes[0], bytes[1], bytes[2],
+                  scale8(50, brightness), scale8(200, brightness), scale8(10, brightness));
+    return false;
+  }
+  if (!expectEncoded(model, brightness, "Helligkeit")) return false;
+
+  // Ohne Warten: der Ausgabe-Task verpasst Zwischenbilder, deren Panels
+  // müssen trotzdem mit dem nächsten Bild raus
+  static const CRGB colors[] = { CRGB::Red, CRGB::Green, CRGB::Blue, CRGB::White, CRGB::Yellow };
+  for (uint16_t frame = 0; frame < DISPLAY_RACE_FRAMES; frame++) {
+    const uint8_t y = random(BoardLayout::HEIGHT);
+    displaySet(display, random(BoardLayout::WIDTH), y, colors[random(5)]);
+    display->show();
+  }
+  waitForIdle(model);
+  return expectEncoded(model, brightness, "ohne Warten");
+}
@@ -0,0 +1,83 @@
+#include "Stages.h"
+#include <JoystickFilter.h>
+#include <SimRuntime.h>
+
+// ==================== JOYSTICK-SPUREN ====================
+//
+// Jede Spur in traces/ (Pfad per BENCH_TRACES änderbar) ist eine
+// Abtastung pro Zeile, "X Y" roh. Im Kopf stehen die Zahl der Richtungen
+// ("# wege: 4") und die Folge der Richtungswechsel, die herauskommen muss
+// ("# erwartet: R C U C"). Ein Wechsel zu viel heißt: der Filter flattert.
+// Die Spuren und ihre erwartete Folge erzeugt traces/generate.py.
+
+static const char* TRACE_FILES[] = { "snake_4wege.txt", "menu_8wege.txt", "mitte_drift.txt" };
+
+static const char* DIRECTION_NAMES[] = { "C", "U", "R", "D", "L", "UR", "DR", "DL", "UL" };
+
+#define TRACE_SEQUENCE_LENGTH 160
+
+static bool replayTrace(const char* dir, const char* name) {
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s", dir, name);
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) {
+    Serial.printf("FEHLER: Joystick-Spur %s fehlt\n", path);
+    return false;
+  }
+
+  char expected[TRACE_SEQUENCE_LENGTH] = "";
+  char actual[TRACE_SEQUENCE_LENGTH] = "";
+  int ways = 4;
+  JoystickFilter filter;
+  InputDirection last = INPUT_CENTER;
+  uint32_t samples = 0;
+
+  char line[TRACE_SEQUENCE_LENGTH];
+  while (fgets(line, sizeof(line), file)) {
+    unsigned x, y;
+    if (sscanf(line, "# wege: %d", &ways) == 1) {
+      filter.setWays(ways);
+    } else if (strncmp(line, "# erwartet:", 11) == 0) {
+      sscanf(line + 11, " %159[^\n]", expected);
+      if (strcmp(expected, "-") == 0) expected[0] = '\0';
+    } else if (line[0] != '#' && sscanf(line, "%u %u", &x, &y) == 2) {
+      samples++;
+      const InputDirection direction = filter.update(x, y);
+      if (direction != last) {
+        last = direction;
+        const size_t used = strlen(actual);
+        snprintf(actual + used, sizeof(actual) - used, "%s%s", used ? " " : "", DIRECTION_NAMES[direction]);
+      }
+    }
+  }
+  fclose(file);
+
+  if (!filter.isCalibrated() || strcmp(expected, actual) != 0) {
+    Serial.printf("FEHLER: Joystick-Spur %s (%u Abtastungen, %d Richtungen, Mitte %u/%u)\n"
+                  "  erwartet: %s\n  erhalten: %s\n",
+                  name, samples, ways, filter.getCenterX(), filter.getCenterY(), expected, actual);
+    return false;
+  }
+  return true;
+}
+
+bool joystickReplayTraces() {
+  const char* dir = simEnv("BENCH_TRACES", "traces");
+  bool ok = true;
+  for (const char* name : TRACE_FILES) {
+    if (!replayTrace(dir, name)) ok = false;
+  }
+  return ok;
+}
+
+// Ein voller Kreis in 256 Abtastungen mit Radius 1500, dazwischen Ruhe,
+// damit Totzone, Hysterese und Nachführen der Mitte alle drankommen
+static JoystickFilter benchFilter(8);
+
+uint8_t joystickFilterSample(uint32_t n) {
+  static const int8_t circle[16] = { 0, 49, 90, 118, 127, 118, 90, 49, 0, -49, -90, -118, -127, -118, -90, -49 };
+  const bool resting = (n >> 8) & 1;
+  const int right = resting ? 0 : circle[(n >> 4) & 15] * 12;
+  const int up = resting ? 0 : circle[((n >> 4) + 4) & 15] * 12;
+  return benchFilter.update(1900 + up + (n & 7), 1950 + right - (n & 3));
+}
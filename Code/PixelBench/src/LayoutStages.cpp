@@ -0,0 +1,189 @@
+#include "Stages.h"
+#include "../../Zeit_anzeigen/include/DisplayManager.h"
+
+static BoardCanvas boardCanvas;
+
+void layoutBlit(const CRGB* canvas, CRGB* leds) {
+  BoardLayout::blit<CANVAS_WIDTH>(canvas, leds);
+}
+
+uint16_t layoutXY(uint8_t x, uint8_t y) {
+  return BoardLayout::XY(x, y);
+}
+
+uint16_t layoutWidth() {
+  return BoardLayout::WIDTH;
+}
+
+// ==================== GRÖSSERE BOARDS ====================
+
+// Dieselben 32x8-Kacheln zu 2, 4 und 8 zusammengesetzt, obere Reihe
+// kopfüber wie bei zwei übereinander montierten Panels. XY() und blit()
+// sollen pro LED gleich teuer bleiben, egal wie groß das Board ist.
+typedef PanelLayout<32, 8, 1, 2,
+                    Tile<25, TileOrientation::ROTATE_180>,
+                    Tile<26>> Layout2Tiles;
+typedef PanelLayout<32, 8, 2, 2,
+                    Tile<25, TileOrientation::ROTATE_180>, Tile<26, TileOrientation::ROTATE_180>,
+                    Tile<27>, Tile<14>> Layout4Tiles;
+typedef PanelLayout<32, 8, 4, 2,
+                    Tile<25, TileOrientation::ROTATE_180>, Tile<26, TileOrientation::ROTATE_180>,
+                    Tile<27, TileOrientation::ROTATE_180>, Tile<14, TileOrientation::ROTATE_180>,
+                    Tile<12>, Tile<13>, Tile<32>, Tile<33>> Layout8Tiles;
+
+template<typename Layout>
+struct ScaledStage {
+  static CRGB canvas[Layout::WIDTH * Layout::HEIGHT];
+  static CRGB leds[Layout::LED_COUNT];
+
+  static void blit() {
+    Layout::template blit<Layout::WIDTH>(canvas, leds);
+  }
+
+  static uint32_t xySum() {
+    uint32_t sum = 0;
+    for (uint16_t y = 0; y < Layout::HEIGHT; y++) {
+      for (uint16_t x = 0; x < Layout::WIDTH; x++) sum += Layout::XY(x, y);
+    }
+    return sum;
+  }
+
+  // Jede LED genau einmal, und blit() legt jedes Pixel auf XY()
+  static bool check() {
+    static bool hit[Layout::LED_COUNT];
+    for (uint16_t i = 0; i < Layout::WIDTH * Layout::HEIGHT; i++) {
+      canvas[i] = CRGB(random(256), random(256), random(256));
+    }
+    blit();
+    memset(hit, 0, sizeof(hit));
+    for (uint16_t y = 0; y < Layout::HEIGHT; y++) {
+      for (uint16_t x = 0; x < Layout::WIDTH; x++) {
+        const uint16_t led = Layout::XY(x, y);
+        if (led >= Layout::LED_COUNT || hit[led] || leds[led] != canvas[y * Layout::WIDTH + x]) {
+          Serial.printf("FEHLER: %u Kacheln: XY(%u, %u) = %u passt nicht zu blit()\n",
+                        Layout::TILE_COUNT, x, y, led);
+          return false;
+        }
+        hit[led] = true;
+      }
+    }
+    return true;
+  }
+};
+
+template<typename Layout> CRGB ScaledStage<Layout>::canvas[Layout::WIDTH * Layout::HEIGHT];
+template<typename Layout> CRGB ScaledStage<Layout>::leds[Layout::LED_COUNT];
+
+template<typename Layout>
+static ScaledLayout scaledLayout(const char* blitName, const char* xyName) {
+  return ScaledLayout{ Layout::TILE_COUNT, Layout::LED_COUNT, blitName, xyName,
+                       ScaledStage<Layout>::blit, ScaledStage<Layout>::xySum,
+                       ScaledStage<Layout>::check };
+}
+
+const ScaledLayout SCALED_LAYOUTS[SCALED_LAYOUT_COUNT] = {
+  scaledLayout<Layout2Tiles>("layout.2tiles.blit", "layout.2tiles.XY"),
+  scaledLayout<Layout4Tiles>("layout.4tiles.blit", "layout.4tiles.XY"),
+  scaledLayout<Layout8Tiles>("layout.8tiles.blit", "layout.8tiles.XY"),
+};
+
+void boardCanvasDraw(const CRGB* canvas) {
+  for (uint16_t y = 0; y < CANVAS_HEIGHT; y++) {
+    for (uint16_t x = 0; x < CANVAS_WIDTH; x++) {
+      boardCanvas.set(x, y, canvas[y * CANVAS_WIDTH + x]);
+    }
+  }
+}
+
+void boardCanvasClear() {
+  boardCanvas.clear();
+}
+
+void boardCanvasBlit(CRGB* leds) {
+  BoardLayout::blit(boardCanvas, leds);
+}
+
+uint16_t boardCanvasColors() {
+  return boardCanvas.colorsUsed();
+}
+
+// ==================== EBENEN ====================
+
+// Wie MenuManager: Rand unter der Basis-Ebene, Uhr auf der Basis-Ebene,
+// Menü darüber. Die Uhr läuft jeden Frame weiter, das Menü rückt alle
+// 50 Frames um einen Balken.
+static BoardLayer borderLayer(0);
+static BoardLayer clockLayer(DISPLAY_BASE_Z);
+static BoardLayer menuLayer(20);
+static BoardLayers boardLayers;
+static ComposedCanvas composedCanvas;
+static BoardCanvas flatCanvas;
+static int drawnMenuOffset = -1;
+
+template<typename Target>
+static void drawBorder(Target& target) {
+  for (uint16_t x = 0; x < CANVAS_WIDTH; x++) target.setPixel(x, 0, CRGB::White);
+}
+
+// Dünn besetzte "Ziffern", die nach links laufen (Zeilen 4-11)
+template<typename Target>
+static void drawClock(Target& target, uint16_t frame) {
+  for (uint16_t y = 4; y < 12; y++) {
+    for (uint16_t x = 0; x < CANVAS_WIDTH; x++) {
+      if (((x + frame / 3) * 7 + y * 3) % 5 == 0) target.setPixel(x, y, CRGB(255 - (frame % 3) * 60, 0, 0));
+    }
+  }
+}
+
+template<typename Target>
+static void drawMenuBars(Target& target, int offset) {
+  for (int i = 0; i < 4; i++) {
+    const CRGB color = i == 1 ? CRGB(CRGB::White) : CRGB(80, 80, 120);
+    const int startX = offset + i * 10;
+    for (int y = 13; y < 16; y++) {
+      for (int x = startX; x < startX + 8 && x < CANVAS_WIDTH; x++) target.setPixel(x, y, color);
+    }
+  }
+}
+
+static int menuOffsetAt(uint16_t frame) {
+  return 2 + (frame / 50) % 3 * 10;
+}
+
+struct FlatTarget {
+  void setPixel(uint16_t x, uint16_t y, const CRGB& color) { flatCanvas.set(x, y, color); }
+};
+
+void layersInit() {
+  boardLayers.add(&borderLayer);
+  boardLayers.add(&clockLayer);
+  boardLayers.add(&menuLayer);
+  drawBorder(borderLayer);
+  drawnMenuOffset = -1;
+}
+
+void layersFrame(uint16_t frame, bool menuVisible, CRGB* leds) {
+  clockLayer.clear();
+  drawClock(clockLayer, frame);
+
+  menuLayer.setVisible(menuVisible);
+  const int offset = menuOffsetAt(frame);
+  if (menuVisible && offset != drawnMenuOffset) {
+    drawnMenuOffset = offset;
+    menuLayer.clear();
+    drawMenuBars(menuLayer, offset);
+  }
+
+  if (boardLayers.compose(composedCanvas) != 0) {
+    BoardLayout::blit(composedCanvas, leds);
+  }
+}
+
+void flatFrame(uint16_t frame, bool menuVisible, CRGB* leds) {
+  FlatTarget target;
+  flatCanvas.clear();
+  drawBorder(target);
+  drawClock(target, frame);
+  if (menuVisible) drawMenuBars(target, menuOffsetAt(frame));
+  BoardLayout::blit(flatCanvas, leds);
+}
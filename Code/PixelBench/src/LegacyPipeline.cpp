@@ -0,0 +1,204 @@
+#include "LegacyPipeline.h"
+#include <LEDMatrix.h>
+
+#define panelWidth     32
+#define panelHeight     8
+#define canvasWidth8   64
+#define canvasHeight8   8
+#define canvasWidth16  64
+#define canvasHeight16 16
+
+static CRGB canvas16Leds[canvasWidth16 * canvasHeight16];
+
+static cLEDMatrix<canvasWidth8, canvasHeight8, HORIZONTAL_MATRIX> canvas8;
+static cLEDMatrix<canvasWidth16, canvasHeight16, HORIZONTAL_MATRIX> canvas16;
+static cLEDMatrix<panelWidth, panelHeight, VERTICAL_ZIGZAG_MATRIX> panelTop;
+static cLEDMatrix<panelWidth, panelHeight, VERTICAL_ZIGZAG_MATRIX> panelBottom;
+
+void legacyInit(CRGB* canvas8Leds, CRGB* ledsTop, CRGB* ledsBottom) {
+  canvas8.SetLEDArray(canvas8Leds);
+  canvas16.SetLEDArray(canvas16Leds);
+  panelTop.SetLEDArray(ledsBottom);
+  panelBottom.SetLEDArray(ledsTop);
+}
+
+void legacyScaleVertTo16() {
+  for (uint8_t y8 = 0; y8 < canvasHeight8; y8++) {
+    const uint8_t y16a = 2 * y8;
+    const uint8_t y16b = y16a + 1;
+
+    for (uint8_t x = 0; x < canvasWidth8; x++) {
+      const CRGB c = canvas8(x, y8);
+      canvas16(x, y16a) = c;
+      canvas16(x, y16b) = c;
+    }
+  }
+}
+
+void legacyShiftCanvas16Down() {
+  for (int y = canvasHeight16 - 1; y > 0; y--) {
+    for (uint8_t x = 0; x < canvasWidth16; x++) {
+      canvas16(x, y) = canvas16(x, y - 1);
+    }
+  }
+
+  for (uint8_t x = 0; x < canvasWidth16; x++) {
+    canvas16(x, 0) = CRGB::Black;
+  }
+}
+
+void legacyBlitPanelsFromCanvas16() {
+  for (uint8_t y = 0; y < panelHeight; y++) {
+    const uint8_t ySrc = y + panelHeight;
+    for (uint8_t x = 0; x < panelWidth; x++) {
+      panelTop(x, y) = canvas16(x, ySrc);
+    }
+  }
+
+  for (uint8_t y = 0; y < panelHeight; y++) {
+    for (uint8_t x = 0; x < panelWidth; x++) {
+      panelBottom(x, y) = canvas16(x, y);
+    }
+  }
+}
+
+template<typename Panel>
+static void mirrorHorizontal(Panel& panel) {
+  for (uint8_t y = 0; y < panelHeight; y++) {
+    for (uint8_t x = 0; x < panelWidth / 2; x++) {
+      const uint8_t xo = panelWidth - 1 - x;
+      CRGB tmp      = panel(x, y);
+      panel(x, y)   = panel(xo, y);
+      panel(xo, y)  = tmp;
+    }
+  }
+}
+
+void legacyMirrorPanelHorizontal(bool top) {
+  if (top) mirrorHorizontal(panelTop);
+  else mirrorHorizontal(panelBottom);
+}
+
+void legacyRotatePanel180() {
+  for (uint8_t y = 0; y < panelHeight; y++) {
+    for (uint8_t x = 0; x < panelWidth / 2; x++) {
+      const uint8_t xo = panelWidth - 1 - x;
+      const uint8_t yo = panelHeight - 1 - y;
+
+      CRGB tmp          = panelTop(x, y);
+      panelTop(x, y)    = panelTop(xo, yo);
+      panelTop(xo, yo)  = tmp;
+    }
+  }
+}
+
+void legacyPipeline() {
+  legacyScaleVertTo16();
+  legacyShiftCanvas16Down();
+  legacyBlitPanelsFromCanvas16();
+  legacyMirrorPanelHorizontal(true);
+  legacyMirrorPanelHorizontal(false);
+  legacyRotatePanel180();
+}
+
+uint16_t legacyMatrixPanelXY(uint16_t x, uint16_t y) {
+  if (x >= 32 || y >= 16) return UINT16_MAX;
+
+  uint8_t panel = (y < panelHeight) ? 0 : 1;
+  uint16_t panelOffset = panel * LEGACY_PANEL_LEDS;
+
+  uint16_t localY = y % panelHeight;
+  uint16_t localX = x;
+
+  if (panel == 1) {
+    localX = (panelWidth - 1) - localX;
+    localY = (panelHeight - 1) - localY;
+  }
+
+  uint16_t indexInPanel;
+
+  if ((localX & 1) == 0) {
+    indexInPanel = localX * panelHeight + localY;
+  } else {
+    indexInPanel = localX * panelHeight + (panelHeight - 1 - localY);
+  }
+
+  return panelOffset + indexInPanel;
+}
+
+// ==================== SNAKE ====================
+
+#define legacySnakeCells  (32 * 16)
+
+static int snakeX[legacySnakeCells], snakeY[legacySnakeCells];
+static int snakeLength = 3;
+static int foodX, foodY;
+
+static void generateFood() {
+  if (snakeLength >= legacySnakeCells) return;
+  bool valid;
+  do {
+    valid = true;
+    foodX = random(32);
+    foodY = random(16);
+    for (int i = 0; i < snakeLength; i++) {
+      if (foodX == snakeX[i] && foodY == snakeY[i]) valid = false;
+    }
+  } while (!valid);
+}
+
+void legacySnakeReset() {
+  snakeLength = 3;
+  for (int i = 0; i < snakeLength; i++) {
+    snakeX[i] = 32 / 2 - i;
+    snakeY[i] = 16 / 2;
+  }
+  generateFood();
+}
+
+int legacySnakeStep(uint8_t direction) {
+  // Wie moveSnake(), aber ohne den Körper anzufassen, wenn der Kopf crasht.
+  // Gewachsen wird vor dem Verschieben, das neue letzte Glied ist also der
+  // alte Schwanz (im Original blieb dort ein veralteter Wert stehen).
+  int headX = snakeX[0], headY = snakeY[0];
+  switch (direction) {
+    case 0: headY--; break;
+    case 1: headX++; break;
+    case 2: headY++; break;
+    case 3: headX--; break;
+  }
+
+  if (headX < 0 || headX >= 32 || headY < 0 || headY >= 16) return LEGACY_SNAKE_CRASHED;
+
+  for (int i = 0; i < snakeLength - 1; i++) {
+    if (headX == snakeX[i] && headY == snakeY[i]) return LEGACY_SNAKE_CRASHED;
+  }
+
+  const bool eats = headX == foodX && headY == foodY;
+  if (eats && snakeLength < legacySnakeCells) snakeLength++;
+
+  for (int i = snakeLength - 1; i > 0; i--) {
+    snakeX[i] = snakeX[i - 1];
+    snakeY[i] = snakeY[i - 1];
+  }
+  snakeX[0] = headX;
+  snakeY[0] = headY;
+
+  if (!eats) return LEGACY_SNAKE_MOVED;
+  generateFood();
+  return LEGACY_SNAKE_ATE;
+}
+
+void legacySnakeSetFood(int x, int y) {
+  foodX = x;
+  foodY = y;
+}
+
+int legacySnakeLength() {
+  return snakeLength;
+}
+
+void legacySnakeSegment(int i, int& x, int& y) {
+  x = snakeX[i];
+  y = snakeY[i];
+}
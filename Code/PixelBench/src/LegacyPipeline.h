@@ -0,0 +1,34 @@
+#pragma once
+
+#include <FastLED.h>
+
+// Referenz: die Fünf-Pass-Pipeline der Laufschrift, das alte
+// MatrixPanel::XY und der alte Snake-Schritt, so wie sie vor PanelBlit,
+// PanelLayout und SnakeGame im Code standen. Dient als Vergleichswert und
+// zur Prüfung, dass die neuen Fassungen dasselbe Ergebnis liefern.
+
+#define LEGACY_PANEL_LEDS  256
+
+void legacyInit(CRGB* canvas8Leds, CRGB* ledsTop, CRGB* ledsBottom);
+
+void legacyScaleVertTo16();
+void legacyShiftCanvas16Down();
+void legacyBlitPanelsFromCanvas16();    // nur Kopieren, ohne Spiegeln/Drehen
+void legacyMirrorPanelHorizontal(bool top);
+void legacyRotatePanel180();             // panelTop
+void legacyPipeline();                   // alle fünf Schritte
+
+uint16_t legacyMatrixPanelXY(uint16_t x, uint16_t y);
+
+// Snake mit Arrays wie im alten moveSnake()/generateFood(): jeder Schritt
+// verschiebt den ganzen Körper, Kollision und Futtersuche scannen ihn.
+// Ohne die alte Grenze von 100 Gliedern, damit beide gleich lang spielen.
+#define LEGACY_SNAKE_MOVED    0
+#define LEGACY_SNAKE_ATE      1
+#define LEGACY_SNAKE_CRASHED  -1
+
+void legacySnakeReset();
+int legacySnakeStep(uint8_t direction);   // UP, RIGHT, DOWN, LEFT wie in SnakeGame.h
+void legacySnakeSetFood(int x, int y);    // statt des gewürfelten Futters
+int legacySnakeLength();
+void legacySnakeSegment(int i, int& x, int& y);
@@ -0,0 +1,8 @@
+#include "Stages.h"
+#include "../../MatrixPanel/MatrixPanel.cpp"
+
+static MatrixPanel panel;
+
+uint16_t matrixPanelXY(uint16_t x, uint16_t y) {
+  return panel.XY(x, y);
+}
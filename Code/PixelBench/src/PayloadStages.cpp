@@ -0,0 +1,152 @@
+#include "Stages.h"
+#include <WiFi.h>
+#include <PollClient.h>
+#include <SimRuntime.h>
+#include <cstddef>
+
+// ==================== WETTER-ANTWORTEN ====================
+//
+// Die aufgezeichneten Antworten aus PixelSim/payloads/ (Pfad per
+// BENCH_PAYLOADS änderbar) nehmen denselben Weg wie im Betrieb: SimNet
+// liefert sie als HTTP/1.1-Server aus, ein PollClient holt sie über eine
+// Keep-Alive-Verbindung, der Parser der App liest den Stream mit ihrem
+// Filter. Jede Antwort kommt einmal mit Content-Length und einmal
+// chunked. Geprüft werden die Werte und wie viel Speicher das Dokument
+// danach noch hält.
+
+#define PAYLOAD_DOC_MAX_BYTES  512    // gefiltert bleiben nur ein paar Zahlen und Schlüssel
+#define PAYLOAD_WIFI_WAIT_MS   2000
+
+// Zählt, was das Dokument vom Heap hält; vor jedem Block steht seine Größe
+class CountingAllocator : public ArduinoJson::Allocator {
+private:
+  static const size_t HEADER = alignof(std::max_align_t);
+
+  void add(size_t size) {
+    current += size;
+    if (current > peak) peak = current;
+  }
+
+public:
+  size_t current = 0;
+  size_t peak = 0;
+
+  void* allocate(size_t size) override {
+    char* block = static_cast<char*>(malloc(size + HEADER));
+    if (block == nullptr) return nullptr;
+    *reinterpret_cast<size_t*>(block) = size;
+    add(size);
+    return block + HEADER;
+  }
+
+  void deallocate(void* pointer) override {
+    if (pointer == nullptr) return;
+    char* block = static_cast<char*>(pointer) - HEADER;
+    current -= *reinterpret_cast<size_t*>(block);
+    free(block);
+  }
+
+  void* reallocate(void* pointer, size_t size) override {
+    if (pointer == nullptr) return allocate(size);
+    char* block = static_cast<char*>(realloc(static_cast<char*>(pointer) - HEADER, size + HEADER));
+    if (block == nullptr) return nullptr;
+    current -= *reinterpret_cast<size_t*>(block);
+    *reinterpret_cast<size_t*>(block) = size;
+    add(size);
+    return block + HEADER;
+  }
+};
+
+typedef bool (*PayloadParser)(Stream& body, JsonDocument& doc, ParsedWeather& parsed);
+
+// Eine Antwort holen und parsen; docBytes = was das Dokument danach hält
+static bool fetchPayload(PollClient& http, const char* name, const char* url,
+                         PayloadParser parse, ParsedWeather& parsed, size_t& docBytes) {
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s", simEnv("BENCH_PAYLOADS", "../PixelSim/payloads"), name);
+  FILE* file = fopen(path, "rb");
+  if (file == nullptr) {
+    Serial.printf("FEHLER: Wetter-Antwort %s fehlt\n", path);
+    return false;
+  }
+  fclose(file);
+  setenv("SIM_HTTP_FILE", path, 1);   // der Stand-in-Server liest die Datei bei jedem GET
+
+  http.begin(url);
+  int code = http.GET();
+  if (code != POLL_HTTP_OK) {
+    Serial.printf("FEHLER: %s: HTTP %d (%s)\n", name, code, PollClient::errorToString(code).c_str());
+    http.end();
+    return false;
+  }
+
+  CountingAllocator allocator;
+  bool ok;
+  {
+    JsonDocument doc(&allocator);
+    ok = parse(http.getStream(), doc, parsed);
+    docBytes = allocator.current;
+  }
+  http.end();
+
+  if (!ok) {
+    Serial.printf("FEHLER: %s: JSON nicht lesbar\n", name);
+    return false;
+  }
+  if (docBytes > PAYLOAD_DOC_MAX_BYTES) {
+    Serial.printf("FEHLER: %s: Dokument hält %u B (max. %u B, Spitze %u B), Filter wirkt nicht\n",
+                  name, (unsigned)docBytes, PAYLOAD_DOC_MAX_BYTES, (unsigned)allocator.peak);
+    return false;
+  }
+  return true;
+}
+
+static bool near(float value, float expected) {
+  return fabsf(value - expected) < 0.001f;
+}
+
+bool weatherPayloadCheck() {
+  WiFi.begin("bench");
+  for (uint16_t ms = 0; ms < PAYLOAD_WIFI_WAIT_MS && !WiFi.isConnected(); ms += 10) delay(10);
+  if (!WiFi.isConnected()) {
+    Serial.printf("FEHLER: Wetter-Antworten: WLAN im Simulator nicht verbunden\n");
+    return false;
+  }
+
+  PollClient http;
+  http.setTimeout(2000);
+  bool ok = true;
+
+  for (uint8_t chunked = 0; chunked < 2 && ok; chunked++) {
+    setenv("SIM_HTTP_CHUNKED", chunked ? "1" : "0", 1);
+    ParsedWeather parsed = {};
+    size_t docBytes = 0;
+
+    if (!fetchPayload(http, "openweathermap.json",
+                      "http://api.openweathermap.org/data/2.5/weather?q=Innsbruck&units=metric",
+                      weatherParseOpenWeatherMap, parsed, docBytes)) {
+      ok = false;
+    } else if (!near(parsed.temperature, -2.46f) || parsed.humidity != 78 ||
+               !near(parsed.windSpeed, 3.09f) || parsed.observedAt != 1740825600u) {
+      Serial.printf("FEHLER: openweathermap.json%s: %.2f °C, %d %%, %.2f m/s, dt %u\n",
+                    chunked ? " (chunked)" : "", parsed.temperature, parsed.humidity,
+                    parsed.windSpeed, parsed.observedAt);
+      ok = false;
+    }
+
+    parsed = {};
+    if (ok && !fetchPayload(http, "open-meteo.json",
+                            "http://api.open-meteo.com/v1/forecast?latitude=47.27&longitude=11.40&current_weather=true",
+                            pixelboardParseOpenMeteo, parsed, docBytes)) {
+      ok = false;
+    } else if (ok && (!near(parsed.temperature, 13.4f) || parsed.weatherCode != 3)) {
+      Serial.printf("FEHLER: open-meteo.json%s: %.2f °C, Code %d\n",
+                    chunked ? " (chunked)" : "", parsed.temperature, parsed.weatherCode);
+      ok = false;
+    }
+  }
+
+  unsetenv("SIM_HTTP_CHUNKED");
+  http.stop();
+  return ok;
+}
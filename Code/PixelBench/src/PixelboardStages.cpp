@@ -0,0 +1,134 @@
+#include "Stages.h"
+
+// drawTextToPanels() aus der Laufschrift, unverändert übernommen
+#include "../../Pixelboard/src/PanelBlit.cpp"
+
+// Lauftexte der Uhr und des Wetters, ebenfalls unverändert
+#include "../../Pixelboard/src/TickerText.cpp"
+
+// Open-Meteo-Antwort lesen, wie im Wetter-Lauftext
+#include "../../Pixelboard/src/OpenMeteo.cpp"
+
+// Laufschrift: LEDText (bisher) gegen den vorgerasterten TextStrip
+#include <LEDMatrix.h>
+#include <LEDText.h>
+#include <FontMatrise.h>
+#include <TextStrip.h>
+
+// Wie laufText in Laufschrift_2_panels.cpp
+static const char tickerText[] =
+  "   HTL Anichstrasse  |  ESP32 Laufschrift  |  Q-LABS   ";
+
+static CRGB tickerCanvas[64 * 8];
+static cLEDMatrix<64, 8, HORIZONTAL_MATRIX> tickerMatrix;
+static cLEDText ledText;
+static TextStrip textStrip;
+static TextStrip panelStrip;     // wie in den Apps: 32 breit, 16 Zeilen geglättet
+static TextStrip compareNarrow;  // 8 Zeilen, für die alte Pipeline
+static TextStrip compareDouble;  // 16 Zeilen ohne Glättung
+static cLEDMatrix<64, 8, HORIZONTAL_MATRIX> compareMatrix;
+static cLEDText compareLedText;  // wie vor PanelBlit: LEDText rastert ins 64x8-Canvas
+static const CRGB* compareCanvas8;
+
+// LEDText scrollt bei jedem Aufruf eine Spalte weiter (Frame-Rate 0), der
+// Streifen 0,75 Spalten: 37,5 px/s bei 50 Frames/s, also fast immer gemischt
+#define TICKER_FRAME_MS  20
+
+static uint32_t tickerClockMs = 0;
+
+void tickerInit() {
+  tickerMatrix.SetLEDArray(tickerCanvas);
+
+  ledText.SetFont(MatriseFontData);
+  ledText.Init(&tickerMatrix, tickerMatrix.Width(), tickerMatrix.Height(), 0, 0);
+  ledText.SetScrollDirection(SCROLL_LEFT);
+  ledText.SetFrameRate(0);
+  ledText.SetTextColrOptions(COLR_RGB | COLR_SINGLE, 255, 0, 255);
+  ledText.SetText((unsigned char*)tickerText, sizeof(tickerText) - 1);
+
+  textStrip.init(MatriseFontData, 64);
+  textStrip.setSpeed(TEXT_STRIP_SPEED(37.5));
+  textStrip.setText(tickerText, sizeof(tickerText) - 1, CRGB(255, 0, 255));
+
+  panelStrip.init(MatriseFontData, 32, TEXT_STRIP_SMOOTH_2X);
+  panelStrip.setSpeed(TEXT_STRIP_SPEED(37.5));
+  panelStrip.setText(tickerText, sizeof(tickerText) - 1, CRGB(255, 0, 255));
+}
+
+void tickerLedTextFrame() {
+  if (ledText.UpdateText() == -1) {
+    ledText.SetText((unsigned char*)tickerText, sizeof(tickerText) - 1);
+  }
+}
+
+void tickerStripFrame() {
+  tickerClockMs += TICKER_FRAME_MS;
+  textStrip.update(tickerClockMs);
+  textStrip.render(tickerCanvas);
+}
+
+void tickerStripSetText() {
+  textStrip.setText(tickerText, sizeof(tickerText) - 1, CRGB(255, 0, 255));
+}
+
+void tickerPanelFrame(CRGB* panelLeds) {
+  tickerClockMs += TICKER_FRAME_MS;
+  panelStrip.update(tickerClockMs);
+  drawTextToPanels(panelStrip, panelLeds);
+}
+
+void tickerPanelSetText() {
+  panelStrip.setText(tickerText, sizeof(tickerText) - 1, CRGB(255, 0, 255));
+}
+
+void tickerCompareInit() {
+  compareNarrow.init(MatriseFontData, 32);
+  compareDouble.init(MatriseFontData, 32, TEXT_STRIP_SCALE_2X);
+  compareNarrow.setSpeed(TEXT_STRIP_SPEED(37.5));
+  compareDouble.setSpeed(TEXT_STRIP_SPEED(37.5));
+  compareNarrow.setText(tickerText, sizeof(tickerText) - 1, CRGB(255, 0, 255));
+  compareDouble.setText(tickerText, sizeof(tickerText) - 1, CRGB(255, 0, 255));
+  compareNarrow.setColorFrom(20, CRGB(0, 255, 255));
+  compareDouble.setColorFrom(20, CRGB(0, 255, 255));
+}
+
+void tickerCompareFrame(uint32_t nowMs, CRGB* canvas8Leds, CRGB* panelLeds) {
+  compareNarrow.update(nowMs);
+  compareDouble.update(nowMs);
+
+  // 32 sichtbare Spalten links im 64x8-Canvas, der Rest bleibt schwarz
+  fill_solid(canvas8Leds, 64 * 8, CRGB::Black);
+  compareNarrow.draw(canvas8Leds, 64);
+  drawTextToPanels(compareDouble, panelLeds);
+}
+
+void tickerLedTextCompareInit(CRGB* canvas8Leds) {
+  compareCanvas8 = canvas8Leds;
+  compareMatrix.SetLEDArray(canvas8Leds);
+  compareLedText.SetFont(MatriseFontData);
+  compareLedText.Init(&compareMatrix, compareMatrix.Width(), compareMatrix.Height(), 0, 0);
+  compareLedText.SetScrollDirection(SCROLL_LEFT);
+  compareLedText.SetFrameRate(0);
+  compareLedText.SetTextColrOptions(COLR_RGB | COLR_SINGLE, 255, 0, 255);
+  compareLedText.SetText((unsigned char*)tickerText, sizeof(tickerText) - 1);
+}
+
+void tickerLedTextCompareFrame(CRGB* panelLeds) {
+  if (compareLedText.UpdateText() == -1) {
+    compareLedText.SetText((unsigned char*)tickerText, sizeof(tickerText) - 1);
+  }
+
+  // Dieselbe Tabelle wie drawTextToPanels(), gespeist aus dem Canvas:
+  // Textzeile t ist Canvas-Zeile t / 2 (ungeglättet verdoppelt)
+  fill_solid(panelLeds, 2 * ledsPerPanel, CRGB::Black);
+  for (uint8_t t = 0; t < textRows; t++) {
+    for (uint8_t x = 0; x < panelWidth; x++) {
+      const uint16_t led = textZiel[t * panelWidth + x];
+      if (led != TEXT_STRIP_NO_PIXEL) panelLeds[led] = compareCanvas8[(t / 2) * 64 + x];
+    }
+  }
+}
+
+bool pixelboardParseOpenMeteo(Stream& body, JsonDocument& doc, ParsedWeather& parsed) {
+  return parseCurrentWeather(body, doc, parsed.temperature, parsed.weatherCode);
+}
@@ -0,0 +1,183 @@
+#include "Stages.h"
+
+// Alle Header, die Snake/src/main.cpp braucht, vorher global einbinden;
+// im Namespace sind die Includes dann leer.
+#include <FastLED.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <PixelLog.h>
+#include <Snapshot.h>
+#include <GameLoop.h>
+#include <InputSampler.h>
+#include "../../Snake/src/SnakeGame.h"
+
+namespace snake {
+#include "../../Snake/src/main.cpp"
+}
+
+CRGB* snakeMapXY(int x, int y) {
+  snake::LedAddress addr = snake::mapXY(x, y);
+  return addr.array + addr.index;
+}
+
+// ==================== SPIELKERN ====================
+
+#include "LegacyPipeline.h"
+#include "../../Snake/src/SnakeGame.cpp"
+
+static SnakeGame benchGame;
+
+// Autopilot auf einem Hamiltonkreis: Spalte 0 führt nach oben zurück, die
+// Spalten 1-31 laufen als Schlangenlinie nach unten. Die Schlange crasht
+// nie und füllt das Brett, bis step() STEP_WON liefert.
+static Direction cycleDirection(int x, int y) {
+  if (x == 0) return y == 0 ? RIGHT : UP;
+  if (y % 2 == 0) return x < SNAKE_WIDTH - 1 ? RIGHT : DOWN;
+  if (x > 1) return LEFT;
+  return y == SNAKE_HEIGHT - 1 ? LEFT : DOWN;
+}
+
+void snakeGameReset() {
+  randomSeed(7);
+  benchGame.reset();
+}
+
+void snakeGameStep() {
+  const uint16_t head = benchGame.getHead();
+  const StepResult result = benchGame.step(cycleDirection(SnakeGame::cellX(head), SnakeGame::cellY(head)));
+  if (result == STEP_CRASHED || result == STEP_WON) benchGame.reset();
+}
+
+void legacySnakeGameReset() {
+  randomSeed(7);
+  legacySnakeReset();
+}
+
+void legacySnakeGameStep() {
+  int x, y;
+  legacySnakeSegment(0, x, y);
+  if (legacySnakeStep(cycleDirection(x, y)) == LEGACY_SNAKE_CRASHED || legacySnakeLength() == SNAKE_CELLS) {
+    legacySnakeReset();
+  }
+}
+
+uint16_t snakeGameLength() {
+  return benchGame.getLength();
+}
+
+// Beide im Gleichschritt, das Futter gibt SnakeGame vor. Nach jedem
+// Schritt Kopf und Länge, alle 1000 Schritte Körper und Bitbrett.
+bool snakeCompareLegacy(uint32_t steps) {
+  randomSeed(11);
+  benchGame.reset();
+  legacySnakeReset();
+  legacySnakeSetFood(SnakeGame::cellX(benchGame.getFood()), SnakeGame::cellY(benchGame.getFood()));
+
+  uint32_t games = 0;
+  for (uint32_t n = 0; n < steps; n++) {
+    const uint16_t head = benchGame.getHead();
+    const Direction dir = cycleDirection(SnakeGame::cellX(head), SnakeGame::cellY(head));
+    const StepResult result = benchGame.step(dir);
+    const int legacy = legacySnakeStep(dir);
+
+    if (result == STEP_CRASHED || legacy == LEGACY_SNAKE_CRASHED ||
+        (result != STEP_MOVED) != (legacy == LEGACY_SNAKE_ATE)) {
+      Serial.printf("FEHLER: SnakeGame und alter Schritt trennen sich in Schritt %u\n", n);
+      return false;
+    }
+
+    int x, y;
+    legacySnakeSegment(0, x, y);
+    if (benchGame.getLength() != legacySnakeLength() || benchGame.getHead() != SnakeGame::cellAt(x, y)) {
+      Serial.printf("FEHLER: SnakeGame weicht in Schritt %u ab (Länge %u statt %d)\n",
+                    n, benchGame.getLength(), legacySnakeLength());
+      return false;
+    }
+
+    if (n % 1000 == 0 || result == STEP_WON) {
+      uint16_t occupied = 0;
+      for (uint16_t cell = 0; cell < SNAKE_CELLS; cell++) occupied += benchGame.isOccupied(cell);
+      for (int i = 0; i < legacySnakeLength(); i++) {
+        legacySnakeSegment(i, x, y);
+        if (benchGame.segment(i) != SnakeGame::cellAt(x, y) || !benchGame.isOccupied(benchGame.segment(i))) {
+          Serial.printf("FEHLER: SnakeGame-Glied %d weicht in Schritt %u ab\n", i, n);
+          return false;
+        }
+      }
+      if (occupied != benchGame.getLength()) {
+        Serial.printf("FEHLER: Bitbrett hat %u Zellen belegt, Schlange ist %u lang\n",
+                      occupied, benchGame.getLength());
+        return false;
+      }
+    }
+
+    if (result == STEP_WON) {
+      games++;
+      benchGame.reset();
+      legacySnakeReset();
+    }
+    if (result != STEP_MOVED && benchGame.getFood() != SNAKE_NO_FOOD) {
+      legacySnakeSetFood(SnakeGame::cellX(benchGame.getFood()), SnakeGame::cellY(benchGame.getFood()));
+    }
+  }
+
+  if (games == 0) {
+    Serial.printf("FEHLER: Snake hat in %u Schritten das Brett nie gefüllt\n", steps);
+    return false;
+  }
+  return true;
+}
+
+void snakeDrawFrame(uint32_t frame) {
+  snake::drawGame(snake::framePool[0], frame * 16, frame * 20);
+}
+
+// ==================== SPIELSCHLEIFE ====================
+
+#define LOOP_TICK_MS   10
+#define LOOP_MAX_FPS   50
+#define LOOP_RUNS      600      // unter GAME_LOOP_REPORT_MS, die Statistik bleibt stehen
+
+// Zählt nur; jeder vierte Takt ändert das Bild
+class CountingGame : public Game {
+public:
+  uint32_t ticks = 0;
+  uint32_t renders = 0;
+
+  bool tick() override { return ++ticks % 4 == 0; }
+  bool render(uint8_t alpha, uint32_t nowMs) override { renders++; return true; }
+};
+
+bool gameLoopCheck() {
+  CountingGame counter;
+  GameLoop loop(counter, LOOP_TICK_MS, LOOP_MAX_FPS);
+
+  randomSeed(3);
+  const uint32_t startUs = 0xFFFFFFFFu - 500000;   // micros() läuft nach 0,5 s über
+  uint32_t nowUs = startUs;
+  loop.start(nowUs);
+  for (uint32_t n = 0; n < LOOP_RUNS; n++) {
+    nowUs += loop.run(nowUs) * 1000 + random(1500);   // bis 1,5 ms zu spät geweckt
+    if (n == LOOP_RUNS / 2) nowUs += 200000;          // Hänger über 20 Takte
+  }
+  loop.run(nowUs);
+
+  const GameLoopStats& stats = loop.getStats();
+  const uint32_t elapsedUs = nowUs - startUs;
+  const uint32_t expected = elapsedUs / (LOOP_TICK_MS * 1000);
+  if (counter.ticks + stats.skippedTicks != expected || stats.ticks != counter.ticks) {
+    Serial.printf("FEHLER: GameLoop hat %u + %u verworfene Takte statt %u\n",
+                  counter.ticks, stats.skippedTicks, expected);
+    return false;
+  }
+  if (stats.skippedTicks == 0) {
+    Serial.printf("FEHLER: GameLoop hat nach dem Hänger alles nachgeholt\n");
+    return false;
+  }
+  if (counter.renders == 0 || counter.renders > elapsedUs / (1000000 / LOOP_MAX_FPS) + 1) {
+    Serial.printf("FEHLER: GameLoop hat %u-mal gezeichnet in %u ms\n", counter.renders, elapsedUs / 1000);
+    return false;
+  }
+  return true;
+}
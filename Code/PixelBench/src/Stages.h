@@ -0,0 +1,119 @@
+#pragma once
+
+#include <FastLED.h>
+#include <ArduinoJson.h>
+#include <TextWriter.h>
+#include <time.h>
+
+// Zugriff auf die Stufen der einzelnen Apps. Die Quellen werden jeweils in
+// einer eigenen Übersetzungseinheit eingebunden, damit sich ihre Makros
+// und globalen Namen nicht in die Quere kommen.
+
+// Zeit_anzeigen: DisplayManager-Layout
+void layoutBlit(const CRGB* canvas, CRGB* leds);
+uint16_t layoutXY(uint8_t x, uint8_t y);
+uint16_t layoutWidth();
+
+// PanelLayout mit 2, 4 und 8 Kacheln (32x8): je Board ein Bild blitten
+// bzw. XY() für jede Koordinate. check() vergleicht blit() mit XY().
+struct ScaledLayout {
+  uint8_t tiles;
+  uint16_t ledCount;
+  const char* blitName;
+  const char* xyName;
+  void (*blit)();
+  uint32_t (*xySum)();
+  bool (*check)();
+};
+#define SCALED_LAYOUT_COUNT 3
+extern const ScaledLayout SCALED_LAYOUTS[SCALED_LAYOUT_COUNT];
+
+// Zeit_anzeigen: Canvas im Pixelformat des DisplayManagers (BoardCanvas)
+void boardCanvasDraw(const CRGB* canvas);   // 64x16 RGB, Pixel für Pixel über set()
+void boardCanvasClear();
+void boardCanvasBlit(CRGB* leds);
+uint16_t boardCanvasColors();
+
+// Zeit_anzeigen: Ebenen wie im Menü (Rand, Uhr auf der Basis-Ebene, Menü).
+// layersFrame zeichnet nur die Uhr und ggf. das Menü neu und mischt die
+// geänderten Zeilen, flatFrame zeichnet alles in einen Canvas wie früher.
+void layersInit();
+void layersFrame(uint16_t frame, bool menuVisible, CRGB* leds);
+void flatFrame(uint16_t frame, bool menuVisible, CRGB* leds);
+
+// Zeit_anzeigen: DisplayManager über das Zeitmodell (TimingModelOutput).
+// false, wenn Maske, Drahtzeit oder kodierte Bytes nicht stimmen.
+bool displayOutputCheck();
+
+// Pixelboard: Lauftexte (TickerText.cpp)
+void buildWeatherTicker(TextWriter& text, float temperature, const char* description);
+void buildClockTicker(TextWriter& text, const struct tm& timeInfo);
+
+// Pixelboard: Laufschrift mit LEDText bzw. TextStrip, ein Frame je Aufruf
+void tickerInit();
+void tickerLedTextFrame();
+void tickerStripFrame();
+void tickerStripSetText();
+
+// Pixelboard: geglättete 16 Zeilen direkt in die Panels (ledsTop, ledsBottom am Stück)
+void tickerPanelFrame(CRGB* panelLeds);
+void tickerPanelSetText();
+
+// Gleicher Text einmal 8 Zeilen ins 64x8-Canvas (für die alte Pipeline),
+// einmal ohne Glättung verdoppelt direkt in die Panels
+void tickerCompareInit();
+void tickerCompareFrame(uint32_t nowMs, CRGB* canvas8Leds, CRGB* panelLeds);
+
+// Wie vor der Umstellung: LEDText::UpdateText() rastert ins 64x8-Canvas
+// (canvas8Leds der alten Pipeline), die Tabelle von drawTextToPanels()
+// bringt dasselbe Canvas verdoppelt in die Panels
+void tickerLedTextCompareInit(CRGB* canvas8Leds);
+void tickerLedTextCompareFrame(CRGB* panelLeds);
+
+// MatrixPanel
+uint16_t matrixPanelXY(uint16_t x, uint16_t y);
+
+// Snake: Spielkern (SnakeGame) gegen den alten Array-Schritt, beide mit
+// einem Autopiloten, der das ganze Brett füllt. Ein Schritt je Aufruf.
+void snakeGameReset();
+void snakeGameStep();
+uint16_t snakeGameLength();
+void legacySnakeGameReset();
+void legacySnakeGameStep();
+bool snakeCompareLegacy(uint32_t steps);   // Gleichschritt, false bei Abweichung
+void snakeDrawFrame(uint32_t frame);      // drawGame mit Überblendung und Futterpuls
+
+// Joystick (PixelInput): Spuren aus traces/ durch den JoystickFilter,
+// false, wenn die Richtungswechsel nicht die erwarteten sind
+bool joystickReplayTraces();
+uint8_t joystickFilterSample(uint32_t n); // eine Abtastung, liefert die Richtung
+
+// Spielschleife (PixelGame) gegen eine künstliche Uhr mit Weckverspätung,
+// einem Hänger und dem Überlauf von micros(); false, wenn Takte fehlen
+// oder öfter gezeichnet wird als erlaubt
+bool gameLoopCheck();
+
+// Wetter-Antworten: Body → gefiltertes Dokument → Werte, mit den Filtern
+// der Apps (WeatherAPI_PixelBoard: OpenWeatherMap, Pixelboard: Open-Meteo)
+struct ParsedWeather {
+  float temperature;
+  int humidity;
+  float windSpeed;
+  uint32_t observedAt;
+  int weatherCode;
+};
+bool weatherParseOpenWeatherMap(Stream& body, JsonDocument& doc, ParsedWeather& parsed);
+bool pixelboardParseOpenMeteo(Stream& body, JsonDocument& doc, ParsedWeather& parsed);
+
+// Aufgezeichnete Antworten über SimNet und PollClient durch beide Parser;
+// false bei falschen Werten oder zu großem Dokument
+bool weatherPayloadCheck();
+
+// Snake und WeatherAPI_PixelBoard (main.cpp jeweils im eigenen Namespace)
+CRGB* snakeMapXY(int x, int y);
+CRGB* weatherMapXY(int x, int y);
+void weatherClearAll();
+void weatherDrawTextCentered(const char* text);
+void weatherDrawReading(uint8_t page);
+void weatherPublishReading(float temperature);
+float weatherReadTemperature();
@@ -0,0 +1,57 @@
+#include "Stages.h"
+
+// Alle Header, die WeatherAPI_PixelBoard/src/main.cpp braucht, vorher
+// global einbinden; im Namespace sind die Includes dann leer.
+#include <WiFi.h>
+#include <Preferences.h>
+#include <ArduinoJson.h>
+#include <FastLED.h>
+#include <LEDMatrix.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <PixelLog.h>
+#include <PollClient.h>
+#include <WlanManager.h>
+#include <TextWriter.h>
+#include <Snapshot.h>
+
+namespace weather {
+#include "../../WeatherAPI_PixelBoard/src/main.cpp"
+}
+
+CRGB* weatherMapXY(int x, int y) {
+  weather::LedAddress addr = weather::mapXY(x, y);
+  return addr.array + addr.index;
+}
+
+void weatherClearAll() {
+  weather::clearAll();
+}
+
+void weatherDrawTextCentered(const char* text) {
+  weather::drawTextCentered(text, 6, CRGB::Green);
+}
+
+void weatherDrawReading(uint8_t page) {
+  static const weather::WeatherReading reading = { -12.5f, 87, 3.4f, 0 };
+  weather::drawReading(reading, page);
+}
+
+void weatherPublishReading(float temperature) {
+  weather::WeatherReading reading = { temperature, 87, 3.4f, 0 };
+  weather::weatherReading.publish(reading);
+}
+
+float weatherReadTemperature() {
+  return weather::weatherReading.read().temperature;
+}
+
+bool weatherParseOpenWeatherMap(Stream& body, JsonDocument& doc, ParsedWeather& parsed) {
+  weather::WeatherReading reading = {};
+  if (!weather::parseWeatherReading(body, doc, reading)) return false;
+  parsed.temperature = reading.temperature;
+  parsed.humidity = reading.humidity;
+  parsed.windSpeed = reading.windSpeed;
+  parsed.observedAt = reading.observedAt;
+  return true;
+}
@@ -0,0 +1,581 @@
+/**
+ * @file main.cpp
+ * @brief Mikrobenchmarks für jede Stufe der Pixel-Pipeline (Host).
+ *
+ * Jede Stufe läuft isoliert mit fester Frame-Anzahl, ausgegeben werden
+ * ns und TSC-Takte pro Frame. Ein Frame ist jeweils ein komplettes Bild:
+ * die Laufschrift auf beiden Panels bzw. eine Abfrage je Board-Koordinate.
+ *
+ * Vorher wird geprüft, dass ein Update-Zyklus der Textstufen (Lauftext
+ * bauen, Anzeige-Seite formatieren und zeichnen) keinen Heap anfasst
+ * und dass ein Snapshot unter Last nie halb geschriebene Daten liefert.
+ *
+ * Die Prüfungen sind ein eigener Schritt mit eigenem Ergebnis: schlägt
+ * eine fehl, endet das Programm mit 2, 3 oder 4, bevor überhaupt gemessen
+ * wird. BENCH_CHECKS_ONLY=1 endet nach den Prüfungen mit 0.
+ *
+ * Vergleich mit thresholds.txt (Pfad per BENCH_THRESHOLDS änderbar): die
+ * Werte sind Vielfache der Referenzstufe BENCH_REFERENCE aus demselben
+ * Lauf, also unabhängig davon, wie schnell der Rechner gerade ist. Liegt
+ * eine Stufe darüber, gibt es eine Warnung; mit BENCH_STRICT=1 endet das
+ * Programm dann mit 1. BENCH_UPDATE=1 schreibt die Datei mit Messwert
+ * + 50 % neu. Ebenso gewarnt wird, wenn XY() oder blit() auf 4 oder 8
+ * Kacheln pro LED teurer werden als auf 2 (LAYOUT_SCALE_LIMIT).
+ *
+ * Die Werte sind Host-Werte. Sie taugen zum Vergleich zweier Stände auf
+ * derselben Maschine, nicht als Vorhersage für den ESP32.
+ */
+
+#include <Arduino.h>
+#include <SimRuntime.h>
+#include <Snapshot.h>
+#include <thread>
+#include <vector>
+
+#include "Bench.h"
+#include "LegacyPipeline.h"
+#include "Stages.h"
+#include "../../Pixelboard/src/PanelBlit.h"
+
+#define BENCH_FRAMES      20000
+#define BENCH_XY_FRAMES   20000
+#define BENCH_TEXT_FRAMES 50000
+#define COMPARE_FRAMES    600     // 12 s Laufschrift bei 50 Frames/s
+#define SNAKE_STEPS       1000000 // je Durchlauf, mehrere volle Bretter
+#define SNAKE_COMPARE     300000
+#define INPUT_SAMPLES     1000000
+#define BENCH_MARGIN      1.5
+#define BENCH_REFERENCE   "legacy.pipeline"   // Maßstab für die Schwellwerte
+#define LAYOUT_SCALE_LIMIT 1.5  // max. Zeit/LED größerer Boards ÷ Zeit/LED bei 2 Kacheln
+
+#define BOARD_WIDTH   32
+#define BOARD_HEIGHT  16
+
+static CRGB canvas8Leds[64 * 8];
+static CRGB ledsTop[LEGACY_PANEL_LEDS];
+static CRGB ledsBottom[LEGACY_PANEL_LEDS];
+static CRGB panelLeds[2 * LEGACY_PANEL_LEDS];
+
+static CRGB layoutCanvas[64 * BOARD_HEIGHT];
+static CRGB layoutLeds[2 * LEGACY_PANEL_LEDS];
+static CRGB boardLeds[2 * LEGACY_PANEL_LEDS];
+static CRGB menuCanvas[64 * BOARD_HEIGHT];   // höchstens 12 Farben, wie Uhr + Menü
+static CRGB layerLeds[2 * LEGACY_PANEL_LEDS];
+
+static std::vector<BenchResult> results;
+
+static void fillRandom(CRGB* leds, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    leds[i] = CRGB(random(256), random(256), random(256));
+  }
+}
+
+static void fillFewColors(CRGB* leds, uint16_t count, uint8_t colors) {
+  CRGB palette[16];
+  fillRandom(palette, colors);
+  for (uint16_t i = 0; i < count; i++) {
+    leds[i] = palette[random(colors)];
+  }
+}
+
+// ==================== PLAUSIBILITÄT ====================
+
+// Die Tabellen müssen dasselbe Bild liefern wie die alte Pipeline,
+// sonst wären die Zahlen wertlos. Ohne Glättung muss der verdoppelt
+// gerasterte Text genau das ergeben, was scaleVertTo16() & Co. aus dem
+// 8-Zeilen-Canvas gemacht haben.
+static bool checkEquivalence() {
+  bool ok = true;
+
+  tickerCompareInit();
+  for (uint16_t frame = 0; frame < COMPARE_FRAMES; frame++) {
+    tickerCompareFrame(frame * 20, canvas8Leds, panelLeds);
+    legacyPipeline();
+
+    if (memcmp(ledsTop, panelLeds, sizeof(ledsTop)) != 0 ||
+        memcmp(ledsBottom, panelLeds + LEGACY_PANEL_LEDS, sizeof(ledsBottom)) != 0) {
+      Serial.printf("FEHLER: drawTextToPanels weicht in Frame %u von der alten Pipeline ab\n", frame);
+      ok = false;
+      break;
+    }
+  }
+
+  // Dasselbe mit dem Text, den LEDText vor der Umstellung ins Canvas
+  // gerastert hat: alte Pipeline und Tabelle müssen Bit für Bit gleich sein
+  tickerLedTextCompareInit(canvas8Leds);
+  for (uint16_t frame = 0; frame < COMPARE_FRAMES && ok; frame++) {
+    tickerLedTextCompareFrame(panelLeds);
+    legacyPipeline();
+
+    if (memcmp(ledsTop, panelLeds, sizeof(ledsTop)) != 0 ||
+        memcmp(ledsBottom, panelLeds + LEGACY_PANEL_LEDS, sizeof(ledsBottom)) != 0) {
+      Serial.printf("FEHLER: Tabelle weicht mit LEDText in Frame %u von der alten Pipeline ab\n", frame);
+      ok = false;
+    }
+  }
+
+  // Bis 15 Farben (plus Schwarz auf Index 0) muss der indizierte Canvas
+  // dasselbe Bild liefern wie RGB
+  for (uint8_t round = 0; round < 15 && ok; round++) {
+    fillFewColors(menuCanvas, 64 * BOARD_HEIGHT, round + 1);
+    boardCanvasClear();
+    boardCanvasDraw(menuCanvas);
+    boardCanvasBlit(boardLeds);
+    layoutBlit(menuCanvas, layoutLeds);
+    if (memcmp(boardLeds, layoutLeds, sizeof(layoutLeds)) != 0) {
+      Serial.printf("FEHLER: BoardCanvas mit %u Farben weicht vom RGB-Canvas ab\n", boardCanvasColors());
+      ok = false;
+    }
+  }
+
+  // Nur geänderte Zeilen mischen muss dasselbe Bild ergeben wie jeden
+  // Frame alles neu zeichnen, auch wenn das Menü auf- und zugeht
+  layersInit();
+  for (uint16_t frame = 0; frame < COMPARE_FRAMES && ok; frame++) {
+    const bool menuVisible = (frame / 120) % 2 == 1;
+    layersFrame(frame, menuVisible, layerLeds);
+    flatFrame(frame, menuVisible, boardLeds);
+    if (memcmp(layerLeds, boardLeds, sizeof(boardLeds)) != 0) {
+      Serial.printf("FEHLER: Ebenen weichen in Frame %u vom flachen Neuzeichnen ab\n", frame);
+      ok = false;
+    }
+  }
+
+  // Größere Boards: jede LED genau einmal, blit() und XY() einig
+  for (const ScaledLayout& layout : SCALED_LAYOUTS) {
+    if (ok && !layout.check()) ok = false;
+  }
+
+  // DisplayManager → Ausgabe-Task → Zeitmodell: richtige Panels,
+  // Drahtzeit parallel/nacheinander, GRB mit Helligkeit
+  if (ok && !displayOutputCheck()) ok = false;
+
+  // Ringpuffer und Bitbrett müssen Zug für Zug dasselbe Spiel ergeben
+  // wie die alten Arrays, bis das Brett voll ist
+  if (ok && !snakeCompareLegacy(SNAKE_COMPARE)) ok = false;
+  if (ok && !gameLoopCheck()) ok = false;
+
+  // Aufgezeichnete Joystick-Spuren: Mitte, Totzone und Hysterese müssen
+  // genau die erwarteten Richtungswechsel ergeben
+  if (!joystickReplayTraces()) ok = false;
+
+  // Aufgezeichnete Wetter-Antworten: Server → PollClient → Filter → Werte
+  if (!weatherPayloadCheck()) ok = false;
+
+  for (uint16_t y = 0; y < BOARD_HEIGHT; y++) {
+    for (uint16_t x = 0; x < BOARD_WIDTH; x++) {
+      if (matrixPanelXY(x, y) != legacyMatrixPanelXY(x, y)) {
+        Serial.printf("FEHLER: MatrixPanel::XY(%u, %u) weicht ab\n", x, y);
+        return false;
+      }
+    }
+  }
+
+  return ok;
+}
+
+// ==================== HEAP ====================
+
+static char tickerBuffer[160];
+
+// Ein Update-Zyklus aller Textstufen, wie ihn die Apps im Betrieb fahren
+static void textUpdateCycle(uint8_t round) {
+  TextWriter ticker(tickerBuffer, sizeof(tickerBuffer));
+  buildWeatherTicker(ticker, -12.5f + round * 0.7f, "leicht_bewoelkt");
+
+  struct tm timeInfo;
+  memset(&timeInfo, 0, sizeof(timeInfo));
+  timeInfo.tm_hour = round % 24;
+  timeInfo.tm_min = round % 60;
+  buildClockTicker(ticker, timeInfo);
+
+  weatherDrawReading(round % 3);
+}
+
+// Geräte laufen monatelang: jede Allokation pro Update fragmentiert den Heap
+static bool checkNoAllocations() {
+  textUpdateCycle(0);   // statische Initialisierung nicht mitzählen
+
+  uint32_t before = benchAllocations();
+  for (uint8_t round = 0; round < 100; round++) {
+    textUpdateCycle(round);
+  }
+  uint32_t count = benchAllocations() - before;
+
+  if (count > 0) {
+    Serial.printf("FEHLER: %u Heap-Allokationen in 100 Update-Zyklen\n", count);
+    return false;
+  }
+  return true;
+}
+
+// ==================== SNAPSHOT ====================
+
+#define SNAPSHOT_PUBLISHES  200000
+
+struct SnapshotProbe {
+  uint32_t words[8];   // alle gleich, sonst hat der Leser einen Mix gesehen
+};
+
+// Ein Schreiber-Thread veröffentlicht ohne Pause, der Leser prüft jede Kopie
+static bool checkSnapshotConsistency() {
+  static Snapshot<SnapshotProbe> snapshot;
+
+  std::thread writer([]() {
+    SnapshotProbe probe;
+    for (uint32_t n = 1; n <= SNAPSHOT_PUBLISHES; n++) {
+      for (uint8_t i = 0; i < 8; i++) probe.words[i] = n;
+      snapshot.publish(probe);
+    }
+  });
+
+  uint32_t torn = 0;
+  uint32_t lastVersion = 0;
+  bool ordered = true;
+  SnapshotProbe probe;
+
+  while (lastVersion < SNAPSHOT_PUBLISHES) {
+    uint32_t version = snapshot.read(probe);
+    for (uint8_t i = 1; i < 8; i++) {
+      if (probe.words[i] != probe.words[0]) {
+        torn++;
+        break;
+      }
+    }
+    if (version < lastVersion || probe.words[0] != version) ordered = false;
+    lastVersion = version;
+  }
+  writer.join();
+
+  if (torn > 0 || !ordered) {
+    Serial.printf("FEHLER: Snapshot lieferte %u gemischte Datensätze%s\n",
+                  torn, ordered ? "" : ", Version passt nicht zu den Daten");
+    return false;
+  }
+  return true;
+}
+
+// ==================== STUFEN ====================
+
+static void runStages() {
+  fillRandom(canvas8Leds, 64 * 8);
+  fillRandom(layoutCanvas, 64 * BOARD_HEIGHT);
+  legacyPipeline();
+
+  results.push_back(benchRun("legacy.scaleVertTo16", BENCH_FRAMES, []() {
+    legacyScaleVertTo16();
+  }));
+  results.push_back(benchRun("legacy.shiftCanvas16Down", BENCH_FRAMES, []() {
+    legacyShiftCanvas16Down();
+  }));
+  results.push_back(benchRun("legacy.blitPanelsFromCanvas16", BENCH_FRAMES, []() {
+    legacyBlitPanelsFromCanvas16();
+  }));
+  results.push_back(benchRun("legacy.mirrorPanelHorizontal", BENCH_FRAMES, []() {
+    legacyMirrorPanelHorizontal(true);
+    legacyMirrorPanelHorizontal(false);
+  }));
+  results.push_back(benchRun("legacy.rotatePanel180", BENCH_FRAMES, []() {
+    legacyRotatePanel180();
+  }));
+  results.push_back(benchRun("legacy.pipeline", BENCH_FRAMES, []() {
+    legacyPipeline();
+  }));
+
+  results.push_back(benchRun("zeit.BoardLayout::blit", BENCH_FRAMES, []() {
+    layoutBlit(layoutCanvas, layoutLeds);
+  }));
+
+  // DisplayManager-Canvas im eingestellten Pixelformat: wie pro Frame
+  // löschen und ganzes Bild setzen, dann mit Palettenauflösung auf die Panels
+  fillFewColors(menuCanvas, 64 * BOARD_HEIGHT, 12);
+  results.push_back(benchRun("zeit.BoardCanvas::set", BENCH_FRAMES, []() {
+    boardCanvasClear();
+    boardCanvasDraw(menuCanvas);
+  }));
+  results.push_back(benchRun("zeit.BoardCanvas::clear", BENCH_FRAMES, []() {
+    boardCanvasClear();
+  }));
+  boardCanvasDraw(menuCanvas);
+  results.push_back(benchRun("zeit.BoardCanvas::blit", BENCH_FRAMES, []() {
+    boardCanvasBlit(boardLeds);
+  }));
+
+  // Menü-Frame mit laufender Uhr: Ebenen (nur Uhrzeilen mischen) gegen
+  // alles neu zeichnen. Das Menü steht, wie fast immer im Betrieb.
+  static uint16_t layerFrame = 0;
+  results.push_back(benchRun("zeit.layers.frame", BENCH_FRAMES, []() {
+    layersFrame(layerFrame++ % 50, true, layerLeds);
+  }));
+  results.push_back(benchRun("zeit.flat.frame", BENCH_FRAMES, []() {
+    flatFrame(layerFrame++ % 50, true, boardLeds);
+  }));
+
+  // Laufschrift: pro Frame Glyphen rastern (LEDText) gegen Fenster kopieren
+  tickerInit();
+  results.push_back(benchRun("pixelboard.LEDText::UpdateText", BENCH_FRAMES, []() {
+    tickerLedTextFrame();
+  }));
+  results.push_back(benchRun("pixelboard.TextStrip::render", BENCH_FRAMES, []() {
+    tickerStripFrame();
+  }));
+  results.push_back(benchRun("pixelboard.TextStrip::setText", BENCH_FRAMES, []() {
+    tickerStripSetText();
+  }));
+
+  // Wie in den Apps: geglättete 16 Zeilen direkt in die Panels, ersetzt
+  // TextStrip::render + blitPanelsFromCanvas8
+  results.push_back(benchRun("pixelboard.drawTextToPanels", BENCH_FRAMES, []() {
+    tickerPanelFrame(panelLeds);
+  }));
+  results.push_back(benchRun("pixelboard.TextStrip::setText2x", BENCH_FRAMES, []() {
+    tickerPanelSetText();
+  }));
+
+  results.push_back(benchRun("legacy.MatrixPanel::XY", BENCH_XY_FRAMES, []() {
+    uint32_t sum = 0;
+    for (uint16_t y = 0; y < BOARD_HEIGHT; y++) {
+      for (uint16_t x = 0; x < BOARD_WIDTH; x++) sum += legacyMatrixPanelXY(x, y);
+    }
+    benchKeep(sum);
+  }));
+  results.push_back(benchRun("matrixpanel.XY", BENCH_XY_FRAMES, []() {
+    uint32_t sum = 0;
+    for (uint16_t y = 0; y < BOARD_HEIGHT; y++) {
+      for (uint16_t x = 0; x < BOARD_WIDTH; x++) sum += matrixPanelXY(x, y);
+    }
+    benchKeep(sum);
+  }));
+  results.push_back(benchRun("zeit.BoardLayout::XY", BENCH_XY_FRAMES, []() {
+    uint32_t sum = 0;
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) {
+      for (uint8_t x = 0; x < layoutWidth(); x++) sum += layoutXY(x, y);
+    }
+    benchKeep(sum);
+  }));
+  // Dieselben Stufen auf 2, 4 und 8 Kacheln, pro LED ausgewertet in
+  // reportScaling()
+  for (const ScaledLayout& layout : SCALED_LAYOUTS) {
+    results.push_back(benchRun(layout.blitName, BENCH_FRAMES, layout.blit));
+    results.push_back(benchRun(layout.xyName, BENCH_XY_FRAMES, [&layout]() {
+      benchKeep(layout.xySum());
+    }));
+  }
+  results.push_back(benchRun("snake.mapXY", BENCH_XY_FRAMES, []() {
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+      for (int x = 0; x < BOARD_WIDTH; x++) benchKeep(snakeMapXY(x, y));
+    }
+  }));
+  results.push_back(benchRun("weather.mapXY", BENCH_XY_FRAMES, []() {
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+      for (int x = 0; x < BOARD_WIDTH; x++) benchKeep(weatherMapXY(x, y));
+    }
+  }));
+
+  // Snake: Millionen Schritte mit Autopilot, die Schlange wächst dabei
+  // jedes Mal bis zum vollen Brett (512 Glieder)
+  snakeGameReset();
+  results.push_back(benchRun("snake.step", SNAKE_STEPS, []() {
+    snakeGameStep();
+  }));
+  legacySnakeGameReset();
+  results.push_back(benchRun("legacy.snake.step", SNAKE_STEPS, []() {
+    legacySnakeGameStep();
+  }));
+  // Joystick: eine Abtastung durch Totzone und 8-Wege-Quantisierer
+  static uint32_t inputSample = 0;
+  results.push_back(benchRun("input.joystickFilter", INPUT_SAMPLES, []() {
+    benchKeep(joystickFilterSample(inputSample++));
+  }));
+
+  // Ein Snake-Bild mit Überblendung und Futterpuls (Ganzzahl-sin16)
+  static uint32_t snakeFrame = 0;
+  results.push_back(benchRun("snake.drawGame", BENCH_FRAMES, []() {
+    snakeDrawFrame(snakeFrame++);
+  }));
+
+  results.push_back(benchRun("weather.clearAll", BENCH_TEXT_FRAMES, []() {
+    weatherClearAll();
+  }));
+  results.push_back(benchRun("weather.drawTextCentered", BENCH_TEXT_FRAMES, []() {
+    weatherDrawTextCentered("-12.5*C");
+  }));
+  results.push_back(benchRun("weather.drawReading", BENCH_TEXT_FRAMES, []() {
+    weatherDrawReading(0);
+  }));
+
+  results.push_back(benchRun("weather.readingPublish", BENCH_TEXT_FRAMES, []() {
+    weatherPublishReading(-12.5f);
+  }));
+  results.push_back(benchRun("weather.readingRead", BENCH_TEXT_FRAMES, []() {
+    benchKeep(weatherReadTemperature());
+  }));
+
+  results.push_back(benchRun("pixelboard.buildWeatherTicker", BENCH_TEXT_FRAMES, []() {
+    TextWriter ticker(tickerBuffer, sizeof(tickerBuffer));
+    buildWeatherTicker(ticker, -12.5f, "leicht_bewoelkt");
+    benchKeep(ticker.size());
+  }));
+  results.push_back(benchRun("pixelboard.buildClockTicker", BENCH_TEXT_FRAMES, []() {
+    struct tm timeInfo;
+    memset(&timeInfo, 0, sizeof(timeInfo));
+    timeInfo.tm_hour = 13;
+    timeInfo.tm_min = 7;
+    TextWriter ticker(tickerBuffer, sizeof(tickerBuffer));
+    buildClockTicker(ticker, timeInfo);
+    benchKeep(ticker.size());
+  }));
+}
+
+// ==================== SCHWELLWERTE ====================
+//
+// Schwellwerte sind Verhältnisse zur Referenzstufe aus demselben Lauf,
+// keine absoluten ns: ein langsamerer oder belasteter Rechner verschiebt
+// Stufe und Referenz gleichermaßen.
+
+struct Threshold {
+  String name;
+  double ratio;   // max. ns/Frame der Stufe ÷ ns/Frame der Referenz
+};
+
+static std::vector<Threshold> loadThresholds(const char* path) {
+  std::vector<Threshold> thresholds;
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) return thresholds;
+
+  char line[160];
+  while (fgets(line, sizeof(line), file)) {
+    char name[128];
+    double value;
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%127s %lf", name, &value) == 2) {
+      thresholds.push_back(Threshold{ String(name), value });
+    }
+  }
+  fclose(file);
+  return thresholds;
+}
+
+static const Threshold* findThreshold(const std::vector<Threshold>& thresholds, const char* name) {
+  for (const Threshold& t : thresholds) {
+    if (t.name == name) return &t;
+  }
+  return nullptr;
+}
+
+static const BenchResult* findResult(const char* name) {
+  for (const BenchResult& r : results) {
+    if (strcmp(r.name, name) == 0) return &r;
+  }
+  return nullptr;
+}
+
+static void writeThresholds(const char* path, double referenceNs) {
+  FILE* file = fopen(path, "w");
+  if (file == nullptr) {
+    Serial.printf("Kann %s nicht schreiben\n", path);
+    return;
+  }
+  fprintf(file, "# Stufe  max. Zeit/Frame relativ zu %s (Messwert + 50 %%)\n", BENCH_REFERENCE);
+  fprintf(file, "# Neu schreiben: BENCH_UPDATE=1 pio run -e native -t exec\n");
+  for (const BenchResult& r : results) {
+    if (strcmp(r.name, BENCH_REFERENCE) == 0) continue;
+    fprintf(file, "%-36s %.4g\n", r.name, r.nsPerFrame / referenceNs * BENCH_MARGIN);
+  }
+  fclose(file);
+  Serial.printf("Schwellwerte nach %s geschrieben\n", path);
+}
+
+// Gibt die Tabelle aus und liefert die Anzahl überschrittener Schwellwerte
+static int report(const std::vector<Threshold>& thresholds, double referenceNs) {
+  int failed = 0;
+
+  printf("%-36s %12s %12s %10s %10s\n", "Stufe", "ns/Frame", "Takte/Frame", "relativ", "Schwelle");
+  for (const BenchResult& r : results) {
+    const double ratio = r.nsPerFrame / referenceNs;
+    const Threshold* t = findThreshold(thresholds, r.name);
+    bool over = t && ratio > t->ratio;
+    if (over) failed++;
+
+    printf("%-36s %12.1f ", r.name, r.nsPerFrame);
+    if (BENCH_HAS_CYCLES) printf("%12.0f ", r.cyclesPerFrame);
+    else printf("%12s ", "-");
+    printf("%10.4g ", ratio);
+    if (strcmp(r.name, BENCH_REFERENCE) == 0) printf("%10s\n", "Referenz");
+    else if (t) printf("%10.4g%s\n", t->ratio, over ? "  ZU LANGSAM" : "");
+    else printf("%10s\n", "neu");
+  }
+  return failed;
+}
+
+// Zeit pro LED bei 4 und 8 Kacheln relativ zu 2 Kacheln; liegt sie über
+// LAYOUT_SCALE_LIMIT, wächst die Abbildung schneller als die LED-Zahl.
+// Liefert die Anzahl überschrittener Verhältnisse.
+static int reportScaling() {
+  int failed = 0;
+  const ScaledLayout& base = SCALED_LAYOUTS[0];
+  const BenchResult* baseBlit = findResult(base.blitName);
+  const BenchResult* baseXY = findResult(base.xyName);
+
+  printf("\n%-10s %6s %14s %14s %10s %10s\n", "Kacheln", "LEDs", "blit ns/LED", "XY ns/LED", "blit rel.", "XY rel.");
+  for (const ScaledLayout& layout : SCALED_LAYOUTS) {
+    const double blitNs = findResult(layout.blitName)->nsPerFrame / layout.ledCount;
+    const double xyNs = findResult(layout.xyName)->nsPerFrame / layout.ledCount;
+    const double blitRatio = blitNs / (baseBlit->nsPerFrame / base.ledCount);
+    const double xyRatio = xyNs / (baseXY->nsPerFrame / base.ledCount);
+    const bool over = blitRatio > LAYOUT_SCALE_LIMIT || xyRatio > LAYOUT_SCALE_LIMIT;
+    if (over) failed++;
+    printf("%-10u %6u %14.3f %14.3f %10.3f %10.3f%s\n", layout.tiles, layout.ledCount,
+           blitNs, xyNs, blitRatio, xyRatio, over ? "  NICHT LINEAR" : "");
+  }
+  return failed;
+}
+
+// ==================== MAIN ====================
+
+void setup() {
+  randomSeed(1);
+
+  legacyInit(canvas8Leds, ledsTop, ledsBottom);
+  initPanelBlit();
+
+  if (!checkEquivalence()) {
+    exit(2);
+  }
+  if (!checkNoAllocations()) {
+    exit(3);
+  }
+  if (!checkSnapshotConsistency()) {
+    exit(4);
+  }
+  if (simEnvLong("BENCH_CHECKS_ONLY", 0)) {
+    printf("Alle Prüfungen bestanden\n");
+    exit(0);
+  }
+
+  runStages();
+
+  const BenchResult* reference = findResult(BENCH_REFERENCE);
+  const double referenceNs = reference->nsPerFrame;
+  const char* path = simEnv("BENCH_THRESHOLDS", "thresholds.txt");
+  if (simEnvLong("BENCH_UPDATE", 0)) {
+    report(std::vector<Threshold>(), referenceNs);
+    writeThresholds(path, referenceNs);
+    exit(0);
+  }
+
+  int failed = report(loadThresholds(path), referenceNs);
+  if (failed > 0) {
+    printf("\nWarnung: %d Stufe(n) relativ zu %s über dem Schwellwert\n", failed, BENCH_REFERENCE);
+  }
+  const int nonLinear = reportScaling();
+  if (nonLinear > 0) {
+    printf("\nWarnung: %d Board(s) pro LED mehr als %.1f-mal so teuer wie 2 Kacheln\n",
+           nonLinear, LAYOUT_SCALE_LIMIT);
+    failed += nonLinear;
+  }
+  exit(failed > 0 && simEnvLong("BENCH_STRICT", 0) ? 1 : 0);
+}
+
+void loop() {
+}
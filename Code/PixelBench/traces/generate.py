@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+# Erzeugt die synthetischen Joystick-Spuren für PixelBench neu.
+#
+#   python3 traces/generate.py      (im Ordner PixelBench)
+#
+# Jede Spur ist ein fest geseedeter Ablauf aus Gesten (halten, auslenken,
+# schwenken, Mitte wandern lassen), der eine Abtastung alle 2 ms schreibt.
+# Die Zeile "# erwartet:" steht hier von Hand neben den Gesten: sie ist die
+# Folge, die der Ablauf meint, und nicht das, was der JoystickFilter gerade
+# ausgibt. Ändert sich der Filter, bleiben die Spuren gleich.
+#
+# Parameter des nachgebildeten ESP32-ADC:
+#   Mitte       versetzt gegen 2048, je Spur (cx/cy)
+#   Rauschen    normalverteilt, Standardabweichung noise (22, Menü 28)
+#   Ausreißer   mit 0,4 % Wahrscheinlichkeit zusätzlich 60-140 Schritte
+#   Drift       nur mitte_drift.txt: 900/-360 Schritte in 18 s
+#
+# Auslenkung "right" landet auf Y, "up" auf X, so wie der Stick auf dem
+# Board eingebaut ist.
+
+import math
+import os
+import random
+
+OUT = os.path.dirname(os.path.abspath(__file__))
+SAMPLE_MS = 2
+OUTLIER_P = 0.004
+OUTLIER_MIN = 60
+OUTLIER_MAX = 140
+
+HEADER = 'Joystick-Spur: eine Abtastung pro Zeile (alle 2 ms), X und Y roh (0-4095)'
+
+
+class Trace:
+    def __init__(self, seed, cx, cy, noise=22):
+        self.rng = random.Random(seed)
+        self.cx = cx
+        self.cy = cy
+        self.noise = noise
+        self.right = 0.0
+        self.up = 0.0
+        self.rows = []
+
+    def sample_noise(self):
+        n = self.rng.gauss(0, self.noise)
+        if self.rng.random() < OUTLIER_P:
+            n += self.rng.choice([-1, 1]) * self.rng.randint(OUTLIER_MIN, OUTLIER_MAX)
+        return n
+
+    def emit(self):
+        x = int(round(self.cx + self.up + self.sample_noise()))
+        y = int(round(self.cy + self.right + self.sample_noise()))
+        self.rows.append((min(4095, max(0, x)), min(4095, max(0, y))))
+
+    # Stick stehen lassen
+    def hold(self, ms):
+        for _ in range(ms // SAMPLE_MS):
+            self.emit()
+
+    # Weich (smoothstep) auf eine neue Auslenkung
+    def move(self, right, up, ms):
+        r0, u0 = self.right, self.up
+        k = ms // SAMPLE_MS
+        for i in range(1, k + 1):
+            t = i / k
+            t = t * t * (3 - 2 * t)
+            self.right = r0 + (right - r0) * t
+            self.up = u0 + (up - u0) * t
+            self.emit()
+
+    @staticmethod
+    def polar(radius, deg):
+        return radius * math.cos(math.radians(deg)), radius * math.sin(math.radians(deg))
+
+    # Am Rand entlang von Winkel d0 nach d1 (0 = rechts, 90 = oben)
+    def sweep(self, radius, d0, d1, ms):
+        k = ms // SAMPLE_MS
+        for i in range(1, k + 1):
+            self.right, self.up = self.polar(radius, d0 + (d1 - d0) * i / k)
+            self.emit()
+
+    # Ruhelage wandert linear um dx/dy
+    def drift(self, dx, dy, ms):
+        k = ms // SAMPLE_MS
+        for _ in range(k):
+            self.cx += dx / k
+            self.cy += dy / k
+            self.emit()
+
+    def save(self, name, header, ways, expected):
+        with open(os.path.join(OUT, name), 'w') as f:
+            for line in [HEADER] + header:
+                f.write('# ' + line + '\n')
+            f.write('# wege: %d\n# erwartet: %s\n' % (ways, expected if expected else '-'))
+            for x, y in self.rows:
+                f.write('%d %d\n' % (x, y))
+
+
+def snake_4wege():
+    t = Trace(1, 1893, 1962)
+    t.hold(300)
+    # R, U, L, D einzeln (je ~90 % Ausschlag)
+    for r, u in [(1800, 0), (0, 1750), (-1850, 0), (0, -1800)]:
+        t.move(r * 0.9 + t.rng.uniform(-60, 60), u * 0.9 + t.rng.uniform(-60, 60), 40)
+        t.hold(250)
+        t.move(0, 0, 30)
+        t.hold(200)
+    # Knapp an der Totzone: 660-760 nach rechts, dann bis 560 zurück
+    for _ in range(12):
+        t.move(700 + t.rng.uniform(-40, 60), 20, 30)
+    for _ in range(8):
+        t.move(600 + t.rng.uniform(-40, 40), 20, 30)
+    t.move(0, 0, 40)
+    t.hold(200)
+    # Sektorgrenze bei 45 Grad: Zittern um 45 bleibt R, erst 60 ergibt U
+    t.move(*t.polar(1500, 30), 40)
+    t.sweep(1500, 30, 46, 300)
+    t.sweep(1500, 46, 44, 100)
+    t.sweep(1500, 44, 46, 100)
+    t.sweep(1500, 46, 60, 150)
+    t.hold(100)
+    t.sweep(1500, 60, 44, 200)
+    t.hold(100)
+    t.move(0, 0, 40)
+    t.hold(200)
+    t.save('snake_4wege.txt', [
+        'Synthetisch nach dem ESP32-ADC: Mitte versetzt (1893/1962), Rauschen und einzelne Ausreißer.',
+        'Vier Richtungen nacheinander, dann Zittern knapp an der Totzone (muss genau ein R ergeben)',
+        'und ein Schwenk über die 45-Grad-Grenze (Hysterese, kein Hin- und Herspringen).'],
+        4, 'R C U C L C D C R C R U C')
+
+
+def mitte_drift():
+    t = Trace(2, 1880, 2005)
+    t.hold(300)
+    t.drift(450, -180, 9000)
+    t.move(1700, 0, 40)
+    t.hold(300)
+    t.move(0, 0, 40)
+    t.drift(450, -180, 9000)
+    t.hold(300)
+    t.save('mitte_drift.txt', [
+        'Synthetisch: Stick in Ruhe, die Mitte wandert in 18 s um 900/-360 Schritte (weiter als die',
+        'Totzone). Nur der kurze Ausschlag nach rechts in der Mitte der Spur darf eine Richtung ergeben.'],
+        4, 'R C')
+
+
+def menu_8wege():
+    t = Trace(3, 1910, 1940, noise=28)
+    t.hold(300)
+    for deg in [0, 45, 90, 225]:
+        t.move(*t.polar(1750, deg + t.rng.uniform(-6, 6)), 40)
+        t.hold(250)
+        t.move(0, 0, 30)
+        t.hold(200)
+    # Einmal außen herum von rechts über oben nach links
+    t.move(*t.polar(1750, 0), 40)
+    t.sweep(1750, 0, 180, 1200)
+    t.hold(150)
+    t.move(0, 0, 40)
+    t.hold(200)
+    t.save('menu_8wege.txt', [
+        'Synthetisch nach dem ESP32-ADC: Mitte versetzt (1910/1940), etwas mehr Rauschen.',
+        'Acht Richtungen: R, UR, U, DL einzeln, dann ein Halbkreis von rechts über oben nach links.'],
+        8, 'R C UR C U C DL C R UR U UL L C')
+
+
+if __name__ == '__main__':
+    snake_4wege()
+    mitte_drift()
+    menu_8wege()
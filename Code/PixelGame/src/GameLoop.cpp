@@ -0,0 +1,82 @@
+/**
+ * @file GameLoop.cpp
+ * @brief Spielschleife mit festem Takt, siehe GameLoop.h.
+ *
+ * Alle Zeiten in µs als uint32_t; Differenzen bleiben über den Überlauf
+ * nach gut 71 Minuten hinweg richtig.
+ */
+
+#include "GameLoop.h"
+#include <PixelLog.h>
+
+GameLoop::GameLoop(Game& game, uint16_t tickMs, uint16_t maxFps)
+    : game(game), tickUs((uint32_t)tickMs * 1000), frameUs(maxFps ? 1000000u / maxFps : 0),
+      nextTickUs(0), lastRenderUs(0), lastReportUs(0), renderPending(true) {
+  resetStats();
+}
+
+void GameLoop::start(uint32_t nowUs) {
+  nextTickUs = nowUs + tickUs;
+  lastRenderUs = nowUs - frameUs;
+  lastReportUs = nowUs;
+  renderPending = true;
+}
+
+void GameLoop::resetStats() {
+  memset(&stats, 0, sizeof(stats));
+}
+
+uint32_t GameLoop::run(uint32_t nowUs) {
+  // Fällige Schritte auf dem festen Raster
+  uint8_t steps = 0;
+  while ((int32_t)(nowUs - nextTickUs) >= 0) {
+    if (steps == GAME_LOOP_MAX_CATCHUP) {
+      // Zu weit hinten: Rest verwerfen, Raster an jetzt anschließen
+      const uint32_t behind = (nowUs - nextTickUs) / tickUs + 1;
+      stats.skippedTicks += behind;
+      nextTickUs += behind * tickUs;
+      break;
+    }
+
+    const uint32_t lateUs = nowUs - nextTickUs;
+    stats.ticks++;
+    stats.sumLateUs += lateUs;
+    if (lateUs > stats.maxLateUs) stats.maxLateUs = lateUs;
+
+    if (game.tick()) renderPending = true;
+    nextTickUs += tickUs;
+    steps++;
+  }
+
+  // Zeichnen: nur bei Änderung oder Animation, nie öfter als maxFps
+  const bool wanted = renderPending || game.animating();
+  if (wanted && nowUs - lastRenderUs >= frameUs) {
+    const uint32_t sinceTickUs = tickUs - (nextTickUs - nowUs);
+    const uint8_t alpha = sinceTickUs >= tickUs ? 255 : (uint8_t)((uint64_t)sinceTickUs * 256 / tickUs);
+    if (game.render(alpha, nowUs / 1000)) {
+      // Bei laufender Animation im Raster bleiben, sonst driftet die
+      // Frame-Rate um die Weckverspätung nach unten
+      lastRenderUs = nowUs - lastRenderUs < 2 * frameUs ? lastRenderUs + frameUs : nowUs;
+      renderPending = false;
+      stats.renders++;
+    }
+  }
+
+#if GAME_LOOP_REPORT_MS > 0
+  if (nowUs - lastReportUs >= GAME_LOOP_REPORT_MS * 1000UL && stats.ticks > 0) {
+    lastReportUs = nowUs;
+    logLine("GameLoop: %u Schritte, Verspätung avg %u us / max %u us, %u verworfen, %u Frames",
+            stats.ticks, stats.avgLateUs(), stats.maxLateUs, stats.skippedTicks, stats.renders);
+    resetStats();
+  }
+#endif
+
+  // Bis zum nächsten Schritt, bei Animation höchstens bis zum nächsten Frame
+  uint32_t waitUs = nextTickUs - nowUs;
+  if (game.animating() || renderPending) {
+    const uint32_t untilFrameUs = frameUs - (nowUs - lastRenderUs < frameUs ? nowUs - lastRenderUs : frameUs);
+    if (untilFrameUs < waitUs) waitUs = untilFrameUs;
+  }
+  const uint32_t waitMs = waitUs / 1000;
+  return waitMs > 0 ? waitMs : 1;
+}
@@ -0,0 +1,112 @@
+#ifndef PIXEL_GAME_LOOP_H
+#define PIXEL_GAME_LOOP_H
+
+#include <Arduino.h>
+
+/**
+ * @file GameLoop.h
+ * @brief Spielschleife mit festem Simulationstakt, unabhängig von der
+ *        Frame-Rate.
+ *
+ * Das Spiel rechnet nur in festen Schritten (tick(), alle tickMs). Ist
+ * der Task zu spät dran, holt run() die fälligen Schritte nach, höchstens
+ * GAME_LOOP_MAX_CATCHUP; was darüber hinaus fehlt, wird verworfen statt
+ * in einem Schwall nachgeholt. Die Schritte liegen auf einem festen
+ * Raster (nächster = voriger + tickMs), Verspätungen summieren sich also
+ * nicht auf.
+ *
+ * Gezeichnet wird getrennt davon, höchstens maxFps-mal pro Sekunde und
+ * nur, wenn sich etwas geändert hat: nach einem Schritt, der das meldet,
+ * nach requestRender() oder solange das Spiel animating() meldet. render()
+ * bekommt den Anteil am nächsten Schritt (alpha, 0-255), damit Bewegung
+ * zwischen zwei Schritten weich überblendet werden kann.
+ *
+ * Wie spät jeder Schritt gegenüber seinem Rasterpunkt lief, sammelt
+ * GameLoopStats; alle GAME_LOOP_REPORT_MS steht das im Log.
+ *
+ * Beispiel:
+ *   class Snake : public Game { ... };
+ *   Snake snake;
+ *   GameLoop loop(snake, 10, 50);       // 100 Schritte/s, max. 50 Frames/s
+ *
+ *   loop.start(micros());
+ *   while (1) {
+ *     readJoystick();
+ *     uint32_t waitMs = loop.run(micros());
+ *     vTaskDelay(pdMS_TO_TICKS(waitMs));
+ *   }
+ */
+
+#define GAME_LOOP_MAX_CATCHUP  5        // Schritte pro run(), danach verwerfen
+#define GAME_LOOP_REPORT_MS    10000    // 0 = nie ins Log
+
+class Game {
+public:
+  virtual ~Game() {}
+
+  /**
+   * @brief Ein Simulationsschritt fester Länge.
+   * @return true, wenn sich dadurch das Bild ändert
+   */
+  virtual bool tick() = 0;
+
+  /**
+   * @param alpha  Anteil am nächsten Schritt in 1/256
+   * @param nowMs  für Animationen, die nicht am Takt hängen
+   * @return false, wenn nicht gezeichnet werden konnte (z. B. kein Puffer
+   *         frei); run() versucht es dann beim nächsten Mal wieder
+   */
+  virtual bool render(uint8_t alpha, uint32_t nowMs) = 0;
+
+  // true, solange render() auch ohne neuen Schritt ein anderes Bild ergibt
+  virtual bool animating() const { return false; }
+};
+
+struct GameLoopStats {
+  uint32_t ticks;
+  uint32_t skippedTicks;    // wegen GAME_LOOP_MAX_CATCHUP verworfen
+  uint32_t renders;
+  uint32_t maxLateUs;       // größte Verspätung eines Schritts
+  uint64_t sumLateUs;
+
+  uint32_t avgLateUs() const { return ticks ? (uint32_t)(sumLateUs / ticks) : 0; }
+};
+
+class GameLoop {
+private:
+  Game& game;
+  uint32_t tickUs;
+  uint32_t frameUs;          // Mindestabstand zweier render()
+  uint32_t nextTickUs;       // Rasterpunkt des nächsten Schritts
+  uint32_t lastRenderUs;
+  uint32_t lastReportUs;
+  bool renderPending;
+  GameLoopStats stats;
+
+public:
+  /**
+   * @param tickMs  Länge eines Simulationsschritts
+   * @param maxFps  Obergrenze für render()
+   */
+  GameLoop(Game& game, uint16_t tickMs, uint16_t maxFps);
+
+  /**
+   * @brief Raster ab jetzt neu beginnen, z. B. nach einer Pause; die
+   *        verpasste Zeit wird nicht nachgeholt.
+   */
+  void start(uint32_t nowUs);
+
+  /**
+   * @brief Fällige Schritte ausführen, dann bei Bedarf zeichnen.
+   * @return ms bis zum nächsten Schritt oder Frame, mindestens 1
+   */
+  uint32_t run(uint32_t nowUs);
+
+  // Zustand hat sich außerhalb von tick() geändert (Eingabe, Neustart)
+  void requestRender() { renderPending = true; }
+
+  const GameLoopStats& getStats() const { return stats; }
+  void resetStats();
+};
+
+#endif // PIXEL_GAME_LOOP_H
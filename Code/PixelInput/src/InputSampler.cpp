@@ -0,0 +1,129 @@
+/**
+ * @file InputSampler.cpp
+ * @brief Abtastung von Joystick und Taster, siehe InputSampler.h.
+ */
+
+#include "InputSampler.h"
+
+InputSampler* InputSampler::active = nullptr;
+
+InputSampler::InputSampler(uint8_t buttonPin, uint8_t xPin, uint8_t yPin, uint8_t ways)
+    : buttonPin(buttonPin), xPin(xPin), yPin(yPin), events(nullptr), task(nullptr), timer(nullptr),
+      edgeUs(0), edgePending(false), pressed(false), longPressSent(false), changedUs(0),
+      stick(ways), direction(INPUT_CENTER) {
+  memset(&stats, 0, sizeof(stats));
+}
+
+bool InputSampler::begin() {
+  pinMode(buttonPin, INPUT_PULLUP);
+  pinMode(xPin, INPUT);
+  pinMode(yPin, INPUT);
+
+  events = xQueueCreate(INPUT_QUEUE_LENGTH, sizeof(InputEvent));
+  if (events == nullptr) return false;
+
+  // Sperre läuft beim Start schon ab, der erste Druck zählt sofort
+  changedUs = micros() - INPUT_DEBOUNCE_MS * 1000UL;
+  active = this;
+  if (xTaskCreate(samplerTask, "InputTask", 2048, this, INPUT_TASK_PRIORITY, &task) != pdPASS) {
+    return false;
+  }
+
+  // Erst wenn der Task steht, dürfen die Interrupts ihn wecken
+  attachInterruptArg(digitalPinToInterrupt(buttonPin), onButtonEdge, this, CHANGE);
+  timer = timerBegin(INPUT_TIMER, 80, true);   // 80 MHz / 80 = 1 µs pro Zählschritt
+  timerAttachInterrupt(timer, onTimer, true);
+  timerAlarmWrite(timer, INPUT_SAMPLE_MS * 1000, true);
+  timerAlarmEnable(timer);
+  return true;
+}
+
+void IRAM_ATTR InputSampler::onTimer() {
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(active->task, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+// Weckt den Task nur für die erste Flanke seit der letzten Abtastung;
+// sample() gibt die Sperre wieder frei, auch beim Timer-Aufruf. Prellt
+// der Taster danach weiter, weckt jede neue Flanke den Task erneut,
+// ausgefiltert wird das erst durch die Sperre (INPUT_DEBOUNCE_MS) in process().
+void IRAM_ATTR InputSampler::onButtonEdge(void* arg) {
+  InputSampler* self = static_cast<InputSampler*>(arg);
+  if (self->edgePending) return;
+  self->edgeUs = micros();
+  self->edgePending = true;
+
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(self->task, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+void InputSampler::samplerTask(void* parameter) {
+  InputSampler* self = static_cast<InputSampler*>(parameter);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    self->sample();
+  }
+}
+
+void InputSampler::sample() {
+  const uint32_t nowUs = micros();
+  uint32_t edgeAtUs = nowUs;
+  if (edgePending) {
+    edgeAtUs = edgeUs;
+    edgePending = false;
+  }
+  const bool buttonDown = digitalRead(buttonPin) == LOW;
+  process(nowUs, buttonDown, readAxis(xPin), readAxis(yPin), edgeAtUs);
+}
+
+uint16_t InputSampler::readAxis(uint8_t pin) {
+  uint32_t sum = 0;
+  for (uint8_t i = 0; i < INPUT_OVERSAMPLE; i++) sum += analogRead(pin);
+  return sum / INPUT_OVERSAMPLE;
+}
+
+void InputSampler::process(uint32_t nowUs, bool buttonDown, uint16_t x, uint16_t y, uint32_t edgeAtUs) {
+  stats.samples++;
+
+  // Taster: Wechsel sofort übernehmen, wenn die Sperre abgelaufen ist
+  if (buttonDown != pressed && nowUs - changedUs >= INPUT_DEBOUNCE_MS * 1000UL) {
+    // Flanke aus dem Interrupt, sonst hat erst der Timer den Wechsel gesehen
+    const uint32_t atUs = nowUs - edgeAtUs < INPUT_DEBOUNCE_MS * 1000UL ? edgeAtUs : nowUs;
+    pressed = buttonDown;
+    changedUs = atUs;
+    if (pressed) {
+      longPressSent = false;
+      emit(INPUT_PRESS, atUs, nowUs);
+    } else {
+      emit(INPUT_RELEASE, atUs, nowUs);
+      if (!longPressSent) emit(INPUT_CLICK, atUs, nowUs);
+    }
+  }
+  if (pressed && !longPressSent && nowUs - changedUs >= INPUT_LONG_PRESS_MS * 1000UL) {
+    longPressSent = true;
+    emit(INPUT_LONG_PRESS, nowUs, nowUs);
+  }
+
+  const InputDirection next = stick.update(x, y);
+  if (next != direction) {
+    direction = next;
+    emit(INPUT_DIRECTION, nowUs, nowUs);
+  }
+}
+
+void InputSampler::emit(InputEventType type, uint32_t atUs, uint32_t nowUs) {
+  InputEvent event;
+  event.type = type;
+  event.direction = direction;
+  event.timeMs = millis() - (nowUs - atUs) / 1000;
+
+  if (xQueueSend(events, &event, 0) != pdTRUE) {
+    stats.dropped++;
+    return;
+  }
+  stats.events++;
+  const uint32_t latencyUs = micros() - atUs;
+  if (latencyUs > stats.maxLatencyUs) stats.maxLatencyUs = latencyUs;
+}
@@ -0,0 +1,123 @@
+#ifndef PIXEL_INPUT_SAMPLER_H
+#define PIXEL_INPUT_SAMPLER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include "JoystickFilter.h"
+
+/**
+ * @file InputSampler.h
+ * @brief Joystick und Taster im festen Takt abgetastet, Eingaben als
+ *        Ereignisse in einer FreeRTOS-Warteschlange.
+ *
+ * Ein Hardware-Timer weckt alle INPUT_SAMPLE_MS einen eigenen Task mit
+ * hoher Priorität. Der liest beide Achsen (INPUT_OVERSAMPLE-mal gemittelt,
+ * analogRead ist in einer Interrupt-Routine nicht erlaubt), gibt sie an
+ * einen JoystickFilter (Mitte, Totzone, Richtung), prüft die Entprellung
+ * und schickt Ereignisse an getEvents(). Wie oft die Apps selbst laufen,
+ * spielt für die Latenz keine Rolle mehr.
+ *
+ * Der Taster hängt zusätzlich an einem Pin-Interrupt: die erste Flanke
+ * seit der letzten Abtastung merkt sich ihre Zeit und weckt den Task sofort.
+ * Entprellt wird führend: der neue Zustand gilt ab der ersten Flanke,
+ * danach ist der Taster INPUT_DEBOUNCE_MS gesperrt, und der Timer liest
+ * den Pegel nach der Sperre neu, falls das Prellen ihn verfälscht hat.
+ *
+ * Ereignisse tragen die Zeit der Flanke bzw. der Abtastung (millis()).
+ * Ist die Warteschlange voll, gehen neue Ereignisse verloren statt dass
+ * der Task wartet; getStats() zählt sie und die größte Latenz von der
+ * Flanke bis zum Einreihen.
+ *
+ * Beispiel:
+ *   InputSampler input(32, 34, 35);     // Taster, X-Achse, Y-Achse, 4 Richtungen
+ *   input.begin();
+ *
+ *   InputEvent event;
+ *   while (xQueueReceive(input.getEvents(), &event, portMAX_DELAY) == pdTRUE) {
+ *     if (event.type == INPUT_CLICK) ...
+ *   }
+ */
+
+#define INPUT_SAMPLE_MS      2       // Timer-Periode
+#define INPUT_OVERSAMPLE     4       // analogRead pro Achse und Abtastung
+#define INPUT_DEBOUNCE_MS    20
+#define INPUT_LONG_PRESS_MS  1000
+#define INPUT_QUEUE_LENGTH   16
+#define INPUT_TIMER          0       // Hardware-Timer 0-3
+#define INPUT_TASK_PRIORITY  (configMAX_PRIORITIES - 2)
+
+enum InputEventType : uint8_t {
+  INPUT_DIRECTION,     // Joystick in neue Richtung, auch zurück in die Mitte
+  INPUT_PRESS,         // Taster gedrückt (entprellt)
+  INPUT_RELEASE,       // Taster losgelassen
+  INPUT_CLICK,         // nach INPUT_RELEASE, wenn kein INPUT_LONG_PRESS kam
+  INPUT_LONG_PRESS     // einmal pro Druck nach INPUT_LONG_PRESS_MS
+};
+
+struct InputEvent {
+  InputEventType type;
+  InputDirection direction;   // neue bzw. aktuelle Richtung
+  uint32_t timeMs;            // Flanke bzw. Abtastung
+};
+
+struct InputStats {
+  uint32_t samples;
+  uint32_t events;
+  uint32_t dropped;           // Warteschlange war voll
+  uint32_t maxLatencyUs;      // Flanke bzw. Abtastung bis Einreihen
+};
+
+class InputSampler {
+private:
+  const uint8_t buttonPin;
+  const uint8_t xPin;
+  const uint8_t yPin;
+  QueueHandle_t events;
+  TaskHandle_t task;
+  hw_timer_t* timer;
+
+  volatile uint32_t edgeUs;   // erste Flanke seit der letzten Abtastung
+  volatile bool edgePending;
+
+  bool pressed;               // entprellter Zustand
+  bool longPressSent;
+  uint32_t changedUs;         // letzter Wechsel von pressed
+  JoystickFilter stick;
+  InputDirection direction;   // zuletzt gemeldet
+  InputStats stats;
+
+  static InputSampler* active;   // für die Timer-Routine, die kein Argument kennt
+
+  static void IRAM_ATTR onTimer();
+  static void IRAM_ATTR onButtonEdge(void* arg);
+  static void samplerTask(void* parameter);
+
+  void sample();
+  // edgeAtUs = erste Flanke seit dem letzten Schritt, sonst nowUs
+  void process(uint32_t nowUs, bool buttonDown, uint16_t x, uint16_t y, uint32_t edgeAtUs);
+  uint16_t readAxis(uint8_t pin);
+  void emit(InputEventType type, uint32_t atUs, uint32_t nowUs);
+
+public:
+  // ways = 4 oder 8 Richtungen, siehe JoystickFilter
+  InputSampler(uint8_t buttonPin, uint8_t xPin, uint8_t yPin, uint8_t ways = 4);
+
+  /**
+   * @brief Warteschlange, Task, Timer und Pin-Interrupt anlegen. Nur ein
+   *        InputSampler pro Board.
+   * @return false, wenn Warteschlange oder Task nicht angelegt werden konnten
+   */
+  bool begin();
+
+  QueueHandle_t getEvents() const { return events; }
+
+  // Momentaufnahmen, aus jedem Task lesbar
+  InputDirection getDirection() const { return direction; }
+  const JoystickFilter& getStick() const { return stick; }
+  bool isPressed() const { return pressed; }
+  const InputStats& getStats() const { return stats; }
+};
+
+#endif // PIXEL_INPUT_SAMPLER_H
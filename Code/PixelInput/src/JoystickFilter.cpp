@@ -0,0 +1,84 @@
+/**
+ * @file JoystickFilter.cpp
+ * @brief Mitte, Totzone und Richtung des Joysticks, siehe JoystickFilter.h.
+ */
+
+#include "JoystickFilter.h"
+
+// Einheitsvektoren pro InputDirection: rechts, oben
+static const int8_t UNIT_RIGHT[] = { 0, 0, 1, 0, -1, 1, 1, -1, -1 };
+static const int8_t UNIT_UP[]    = { 0, 1, 0, -1, 0, 1, -1, -1, 1 };
+
+#define JOYSTICK_DIAGONAL_Q8  181   // 256 / √2
+
+JoystickFilter::JoystickFilter(uint8_t ways) {
+  setWays(ways);
+  reset();
+}
+
+void JoystickFilter::reset() {
+  centerX = (int32_t)JOYSTICK_ADC_CENTER << 8;
+  centerY = (int32_t)JOYSTICK_ADC_CENTER << 8;
+  calibrationSumX = 0;
+  calibrationSumY = 0;
+  calibrationCount = 0;
+  calibrated = false;
+  right = 0;
+  up = 0;
+  direction = INPUT_CENTER;
+}
+
+InputDirection JoystickFilter::update(uint16_t x, uint16_t y) {
+  // Mitte lernen: nur Werte, die nach Ruhe aussehen
+  if (!calibrated) {
+    if (abs((int)x - JOYSTICK_ADC_CENTER) < JOYSTICK_CENTER_TOLERANCE &&
+        abs((int)y - JOYSTICK_ADC_CENTER) < JOYSTICK_CENTER_TOLERANCE) {
+      calibrationSumX += x;
+      calibrationSumY += y;
+      if (++calibrationCount == JOYSTICK_CALIBRATION_SAMPLES) {
+        centerX = (calibrationSumX << 8) / JOYSTICK_CALIBRATION_SAMPLES;
+        centerY = (calibrationSumY << 8) / JOYSTICK_CALIBRATION_SAMPLES;
+        calibrated = true;
+      }
+    }
+  }
+
+  up = x - ((centerX + 128) >> 8);
+  right = y - ((centerY + 128) >> 8);
+  const int32_t radius2 = (int32_t)right * right + (int32_t)up * up;
+
+  // Totzone mit Hysterese
+  if (direction == INPUT_CENTER) {
+    if (radius2 <= (int32_t)JOYSTICK_DEAD_ZONE * JOYSTICK_DEAD_ZONE) {
+      // In Ruhe: Mitte nachführen
+      if (calibrated && radius2 < (int32_t)JOYSTICK_RELEASE_ZONE * JOYSTICK_RELEASE_ZONE) {
+        centerX += (((int32_t)x << 8) - centerX) >> JOYSTICK_DRIFT_SHIFT;
+        centerY += (((int32_t)y << 8) - centerY) >> JOYSTICK_DRIFT_SHIFT;
+      }
+      return direction;
+    }
+  } else if (radius2 < (int32_t)JOYSTICK_RELEASE_ZONE * JOYSTICK_RELEASE_ZONE) {
+    direction = INPUT_CENTER;
+    return direction;
+  }
+
+  direction = quantize();
+  return direction;
+}
+
+// Größtes Skalarprodukt mit den Einheitsvektoren, alle in Q8
+InputDirection JoystickFilter::quantize() const {
+  const uint8_t count = ways == 8 ? INPUT_UP_LEFT : INPUT_LEFT;
+  InputDirection best = INPUT_CENTER;
+  int32_t bestDot = 0;
+  for (uint8_t d = INPUT_UP; d <= count; d++) {
+    const int32_t sum = (int32_t)right * UNIT_RIGHT[d] + (int32_t)up * UNIT_UP[d];
+    int32_t dot = sum * (d >= INPUT_UP_RIGHT ? JOYSTICK_DIAGONAL_Q8 : 256);
+    if (d == direction && dot > 0) dot += dot >> JOYSTICK_HYSTERESIS_SHIFT;
+    if (dot > bestDot) {
+      bestDot = dot;
+      best = (InputDirection)d;
+    }
+  }
+  return best;
+}
@@ -0,0 +1,91 @@
+#ifndef PIXEL_JOYSTICK_FILTER_H
+#define PIXEL_JOYSTICK_FILTER_H
+
+#include <Arduino.h>
+
+/**
+ * @file JoystickFilter.h
+ * @brief Rohwerte des Joysticks zu einer Richtung: Mitte selbst gelernt,
+ *        runde Totzone, 4 oder 8 Richtungen mit Hysterese. Nur
+ *        Ganzzahlrechnung.
+ *
+ * Mitte: Die ersten JOYSTICK_CALIBRATION_SAMPLES Ruhewerte nach dem Start
+ * werden gemittelt (Werte weiter als JOYSTICK_CENTER_TOLERANCE von der
+ * ADC-Mitte zählen nicht, dann hält jemand den Stick). Danach folgt die
+ * Mitte langsam allen Werten, die innerhalb der Ruhezone liegen, und
+ * gleicht so Drift durch Temperatur und Alterung aus. Die Mitte liegt
+ * als Q8 vor, damit auch kleine Schritte ankommen.
+ *
+ * Totzone: Eine Richtung gibt es erst ab JOYSTICK_DEAD_ZONE Abstand zur
+ * Mitte, zurück in die Mitte geht es erst unter JOYSTICK_RELEASE_ZONE.
+ * Verglichen werden die Quadrate, ohne Wurzel.
+ *
+ * Richtung: Skalarprodukt der Auslenkung mit den Einheitsvektoren der 4
+ * bzw. 8 Richtungen (Diagonalen 181/256 = 1/√2), das größte gewinnt. Die
+ * aktuelle Richtung bekommt 1/2^JOYSTICK_HYSTERESIS_SHIFT Vorsprung,
+ * damit der Stick an einer Sektorgrenze nicht hin- und herspringt.
+ *
+ * Achsen wie am Board montiert: X+ = oben, Y+ = rechts.
+ */
+
+#define JOYSTICK_ADC_CENTER           2048   // bis die Mitte gelernt ist
+#define JOYSTICK_CALIBRATION_SAMPLES  32
+#define JOYSTICK_CENTER_TOLERANCE     600
+#define JOYSTICK_DEAD_ZONE            700    // Radius in ADC-Schritten
+#define JOYSTICK_RELEASE_ZONE         500
+#define JOYSTICK_DRIFT_SHIFT          10     // Mitte folgt mit 1/1024 pro Ruhewert
+#define JOYSTICK_HYSTERESIS_SHIFT     3      // 1/8 Vorsprung für die aktuelle Richtung
+
+enum InputDirection : uint8_t {
+  INPUT_CENTER,
+  INPUT_UP,
+  INPUT_RIGHT,
+  INPUT_DOWN,
+  INPUT_LEFT,
+  INPUT_UP_RIGHT,     // Diagonalen nur mit 8 Richtungen
+  INPUT_DOWN_RIGHT,
+  INPUT_DOWN_LEFT,
+  INPUT_UP_LEFT
+};
+
+class JoystickFilter {
+private:
+  uint8_t ways;               // 4 oder 8
+  int32_t centerX;            // Q8
+  int32_t centerY;
+  int32_t calibrationSumX;
+  int32_t calibrationSumY;
+  uint16_t calibrationCount;
+  bool calibrated;
+  int16_t right;              // Auslenkung zur Mitte, letzte Abtastung
+  int16_t up;
+  InputDirection direction;
+
+  InputDirection quantize() const;
+
+public:
+  explicit JoystickFilter(uint8_t ways = 4);
+
+  // Mitte vergessen und neu lernen
+  void reset();
+
+  /**
+   * @brief Eine Abtastung beider Achsen (0-4095).
+   * @return Richtung danach
+   */
+  InputDirection update(uint16_t x, uint16_t y);
+
+  void setWays(uint8_t ways) { this->ways = ways == 8 ? 8 : 4; }
+  uint8_t getWays() const { return ways; }
+
+  InputDirection getDirection() const { return direction; }
+  bool isCalibrated() const { return calibrated; }
+  uint16_t getCenterX() const { return (centerX + 128) >> 8; }
+  uint16_t getCenterY() const { return (centerY + 128) >> 8; }
+
+  // Auslenkung in ADC-Schritten zur gelernten Mitte
+  int16_t getRight() const { return right; }
+  int16_t getUp() const { return up; }
+};
+
+#endif // PIXEL_JOYSTICK_FILTER_H
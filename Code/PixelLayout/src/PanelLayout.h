@@ -0,0 +1,149 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+// Ausrichtung einer Kachel im Gesamtbild. Verdrahtet ist jede Kachel als
+// VERTICAL_ZIGZAG_MATRIX (gerade Spalten abwärts, ungerade aufwärts).
+enum class TileOrientation : uint8_t {
+  NORMAL,
+  MIRROR_X,     // an der y-Achse gespiegelt
+  MIRROR_Y,     // an der x-Achse gespiegelt
+  ROTATE_180    // kopfüber montiert
+};
+
+// Eine Kachel = ein eigener Datenpin / FastLED-Controller
+template<uint8_t DataPin, TileOrientation Orientation = TileOrientation::NORMAL>
+struct Tile {
+  static constexpr uint8_t pin = DataPin;
+  static constexpr TileOrientation orientation = Orientation;
+};
+
+/**
+ * Compile-Zeit-Beschreibung eines Boards aus Columns x Rows gleichen Kacheln.
+ *
+ * Tiles... werden zeilenweise von oben links angegeben. Kachel i hängt an
+ * Controller i und belegt die LEDs [i * LEDS_PER_TILE, (i + 1) * LEDS_PER_TILE).
+ *
+ * XY() und blit() sind reine Tabellenzugriffe; die Tabellen erzeugt der
+ * Compiler aus der Beschreibung (landen im Flash), zur Laufzeit gibt es
+ * keine Verzweigungen nach Kachel oder Ausrichtung.
+ *
+ * Beispiel (zwei 32x8 Panels übereinander, das obere kopfüber):
+ *   typedef PanelLayout<32, 8, 1, 2,
+ *                       Tile<25, TileOrientation::ROTATE_180>,
+ *                       Tile<26>> BoardLayout;
+ */
+template<uint8_t TileWidth, uint8_t TileHeight, uint8_t Columns, uint8_t Rows,
+         typename... Tiles>
+class PanelLayout {
+public:
+  static constexpr uint8_t  TILE_WIDTH    = TileWidth;
+  static constexpr uint8_t  TILE_HEIGHT   = TileHeight;
+  static constexpr uint8_t  COLUMNS       = Columns;
+  static constexpr uint8_t  ROWS          = Rows;
+  static constexpr uint8_t  TILE_COUNT    = Columns * Rows;
+  static constexpr uint16_t WIDTH         = TileWidth * Columns;
+  static constexpr uint16_t HEIGHT        = TileHeight * Rows;
+  static constexpr uint16_t LEDS_PER_TILE = TileWidth * TileHeight;
+  static constexpr uint16_t LED_COUNT     = LEDS_PER_TILE * TILE_COUNT;
+
+  static_assert(sizeof...(Tiles) == TILE_COUNT,
+                "Anzahl der Tile<>-Einträge passt nicht zum Raster");
+
+  // Datenpin je Kachel (für Ausgaben, die Pins zur Laufzeit konfigurieren)
+  static constexpr uint8_t pins[TILE_COUNT] = { Tiles::pin... };
+
+  // Linke obere Ecke einer Kachel in Board-Koordinaten
+  static constexpr uint16_t tileX(uint8_t tile) { return (tile % Columns) * TileWidth; }
+  static constexpr uint16_t tileY(uint8_t tile) { return (tile / Columns) * TileHeight; }
+
+  // LED-Index für Board-Koordinaten (x < WIDTH, y < HEIGHT, prüft der Aufrufer)
+  static uint16_t XY(uint16_t x, uint16_t y) {
+    return xyTable.index[y * WIDTH + x];
+  }
+
+  // Canvas (HORIZONTAL_MATRIX, CanvasWidth Pixel breit) → LEDs in Kabelreihenfolge
+  template<uint16_t CanvasWidth>
+  static void blit(const CRGB* canvas, CRGB* leds) {
+    const uint16_t* source = BlitTable<CanvasWidth>::table.index;
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+      leds[i] = canvas[source[i]];
+    }
+  }
+
+  // Canvas<> in beliebigem Pixelformat → LEDs; bei indizierten Formaten
+  // wird die Palette erst hier aufgelöst
+  template<typename CanvasType>
+  static void blit(const CanvasType& canvas, CRGB* leds) {
+    const uint16_t* source = BlitTable<CanvasType::WIDTH>::table.index;
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+      leds[i] = canvas.color(source[i]);
+    }
+  }
+
+  // Ruft visitor.template visit<Tile>(index) für jede Kachel auf,
+  // z. B. um pro Kachel FastLED.addLeds<..., Tile::pin, ...>() aufzurufen
+  template<typename Visitor>
+  static void forEachTile(Visitor& visitor) {
+    uint8_t index = 0;
+    (visitor.template visit<Tiles>(index++), ...);
+  }
+
+private:
+  struct IndexTable {
+    uint16_t index[LED_COUNT];
+  };
+
+  static constexpr TileOrientation orientations[TILE_COUNT] = { Tiles::orientation... };
+
+  static constexpr uint16_t ledIndex(uint16_t x, uint16_t y) {
+    const uint8_t tile = (y / TileHeight) * Columns + x / TileWidth;
+    const TileOrientation orientation = orientations[tile];
+    uint16_t localX = x % TileWidth;
+    uint16_t localY = y % TileHeight;
+
+    if (orientation == TileOrientation::MIRROR_X ||
+        orientation == TileOrientation::ROTATE_180) {
+      localX = TileWidth - 1 - localX;
+    }
+    if (orientation == TileOrientation::MIRROR_Y ||
+        orientation == TileOrientation::ROTATE_180) {
+      localY = TileHeight - 1 - localY;
+    }
+
+    const uint16_t indexInTile = (localX & 1)
+      ? (localX + 1) * TileHeight - 1 - localY
+      : localX * TileHeight + localY;
+    return tile * LEDS_PER_TILE + indexInTile;
+  }
+
+  static constexpr IndexTable buildXYTable() {
+    IndexTable table = {};
+    for (uint16_t y = 0; y < HEIGHT; y++) {
+      for (uint16_t x = 0; x < WIDTH; x++) {
+        table.index[y * WIDTH + x] = ledIndex(x, y);
+      }
+    }
+    return table;
+  }
+
+  template<uint16_t CanvasWidth>
+  static constexpr IndexTable buildBlitTable() {
+    static_assert(CanvasWidth >= WIDTH, "Canvas schmaler als das Board");
+    IndexTable table = {};
+    for (uint16_t y = 0; y < HEIGHT; y++) {
+      for (uint16_t x = 0; x < WIDTH; x++) {
+        table.index[ledIndex(x, y)] = y * CanvasWidth + x;
+      }
+    }
+    return table;
+  }
+
+  static constexpr IndexTable xyTable = buildXYTable();
+
+  template<uint16_t CanvasWidth>
+  struct BlitTable {
+    static constexpr IndexTable table = buildBlitTable<CanvasWidth>();
+  };
+};
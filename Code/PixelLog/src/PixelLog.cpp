@@ -0,0 +1,241 @@
+/**
+ * @file PixelLog.cpp
+ * @brief Ringpuffer und Drain-Task, siehe PixelLog.h.
+ *
+ * Der Ring ist eine beschränkte Queue nach Vyukov: jeder Slot trägt eine
+ * Sequenznummer. Ist sie gleich der Schreibposition, ist der Slot frei;
+ * ein Schreiber reserviert ihn per CAS auf writePos und setzt sie nach
+ * dem Befüllen auf Position + 1. Der Drain-Task liest, sobald die Nummer
+ * Position + 1 ist, und gibt den Slot mit Position + LOG_RING_SLOTS für
+ * die nächste Runde frei. Kein Schreiber wartet je auf einen anderen.
+ */
+
+#include "PixelLog.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define LOG_RING_MASK  (LOG_RING_SLOTS - 1)
+
+static_assert((LOG_RING_SLOTS & LOG_RING_MASK) == 0, "LOG_RING_SLOTS muss eine Zweierpotenz sein");
+
+static LogRecord ring[LOG_RING_SLOTS];
+static std::atomic<uint32_t> writePos(0);
+static std::atomic<uint32_t> droppedCount(0);
+static uint32_t readPos = 0;          // nur im Drain-Task
+static TaskHandle_t drainTask = nullptr;
+
+// Slots vor dem ersten logLine() freigeben, auch wenn das vor setup() passiert
+static struct LogRingInit {
+  LogRingInit() {
+    for (uint32_t i = 0; i < LOG_RING_SLOTS; i++) {
+      ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+} logRingInit;
+
+LogRecord* logClaim() {
+  uint32_t pos = writePos.load(std::memory_order_relaxed);
+  for (;;) {
+    LogRecord& record = ring[pos & LOG_RING_MASK];
+    uint32_t sequence = record.sequence.load(std::memory_order_acquire);
+    int32_t diff = (int32_t)(sequence - pos);
+
+    if (diff == 0) {
+      if (writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        return &record;
+      }
+    } else if (diff < 0) {
+      // Drain-Task ist eine ganze Runde zurück: Ring voll
+      droppedCount.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    } else {
+      pos = writePos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void logPublish(LogRecord* record) {
+  uint32_t sequence = record->sequence.load(std::memory_order_relaxed);
+  record->sequence.store(sequence + 1, std::memory_order_release);
+}
+
+uint32_t logDroppedCount() {
+  return droppedCount.load(std::memory_order_relaxed);
+}
+
+// ==================== FORMATIEREN ====================
+
+struct LogArg {
+  LogArgType type;
+  int64_t i;
+  uint64_t u;
+  double d;
+  const void* p;
+  char text[LOG_STRING_MAX + 1];
+};
+
+class LogReader {
+private:
+  const uint8_t* data;
+  uint8_t size;
+  uint8_t pos;
+
+  template<typename T>
+  T take() {
+    T value;
+    memcpy(&value, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+
+public:
+  LogReader(const uint8_t* data, uint8_t size) : data(data), size(size), pos(0) {}
+
+  bool next(LogArg& arg) {
+    if (pos >= size) return false;
+    arg.type = (LogArgType)data[pos++];
+    arg.i = 0;
+    arg.u = 0;
+    arg.d = 0;
+    arg.p = nullptr;
+    arg.text[0] = '\0';
+
+    switch (arg.type) {
+      case LOG_ARG_INT:     arg.i = take<int32_t>();  arg.u = arg.i; arg.d = arg.i; break;
+      case LOG_ARG_UINT:    arg.u = take<uint32_t>(); arg.i = arg.u; arg.d = arg.u; break;
+      case LOG_ARG_INT64:   arg.i = take<int64_t>();  arg.u = arg.i; arg.d = arg.i; break;
+      case LOG_ARG_UINT64:  arg.u = take<uint64_t>(); arg.i = arg.u; arg.d = arg.u; break;
+      case LOG_ARG_FLOAT:   arg.d = take<float>();    arg.i = arg.d; arg.u = arg.i; break;
+      case LOG_ARG_DOUBLE:  arg.d = take<double>();   arg.i = arg.d; arg.u = arg.i; break;
+      case LOG_ARG_POINTER: arg.p = take<const void*>(); break;
+      case LOG_ARG_STRING: {
+        uint8_t length = data[pos++];
+        memcpy(arg.text, data + pos, length);
+        arg.text[length] = '\0';
+        pos += length;
+        break;
+      }
+      default:
+        pos = size;
+        return false;
+    }
+    return true;
+  }
+};
+
+// Ein Platzhalter: Flags/Breite/Präzision aus dem Format, Typ aus dem Argument
+static int formatArg(char* out, size_t room, const char* spec, char conversion, const LogArg& arg) {
+  char full[20];
+
+  switch (conversion) {
+    case 'd': case 'i':
+      snprintf(full, sizeof(full), "%slld", spec);
+      return snprintf(out, room, full, (long long)arg.i);
+    case 'u': case 'x': case 'X': case 'o':
+      snprintf(full, sizeof(full), "%sll%c", spec, conversion);
+      return snprintf(out, room, full, (unsigned long long)arg.u);
+    case 'c':
+      snprintf(full, sizeof(full), "%sc", spec);
+      return snprintf(out, room, full, (int)arg.i);
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+      snprintf(full, sizeof(full), "%s%c", spec, conversion);
+      return snprintf(out, room, full, arg.d);
+    case 'p':
+      return snprintf(out, room, "%p", arg.p);
+    case 's':
+      if (arg.type != LOG_ARG_STRING) return snprintf(out, room, "?");
+      snprintf(full, sizeof(full), "%ss", spec);
+      return snprintf(out, room, full, arg.text);
+    default:
+      return snprintf(out, room, "?");
+  }
+}
+
+static size_t formatRecord(const LogRecord& record, char* out, size_t capacity) {
+  int written = snprintf(out, capacity, "[%5lu.%03lu] ",
+                         (unsigned long)(record.timeMs / 1000),
+                         (unsigned long)(record.timeMs % 1000));
+  size_t length = written > 0 ? written : 0;
+
+  LogReader reader(record.payload, record.size);
+  const char* f = record.format;
+
+  while (*f && length < capacity - 2) {
+    if (*f != '%') {
+      out[length++] = *f++;
+      continue;
+    }
+    if (f[1] == '%') {
+      out[length++] = '%';
+      f += 2;
+      continue;
+    }
+
+    char spec[12];
+    uint8_t specLength = 0;
+    spec[specLength++] = *f++;
+    while (*f && strchr("-+ #0123456789.", *f) && specLength < sizeof(spec) - 1) {
+      spec[specLength++] = *f++;
+    }
+    spec[specLength] = '\0';
+    while (*f && strchr("hlLqjzt", *f)) f++;
+    if (*f == '\0') break;
+    char conversion = *f++;
+
+    LogArg arg;
+    int n = reader.next(arg)
+              ? formatArg(out + length, capacity - 1 - length, spec, conversion, arg)
+              : snprintf(out + length, capacity - 1 - length, "?");
+    if (n > 0) length += min((size_t)n, capacity - 2 - length);
+  }
+
+  if (record.truncated && length + 4 < capacity) {
+    memcpy(out + length, " ...", 4);
+    length += 4;
+  }
+  out[length++] = '\n';
+  return length;
+}
+
+// ==================== DRAIN-TASK ====================
+
+static bool drainOne(char* line) {
+  LogRecord& record = ring[readPos & LOG_RING_MASK];
+  uint32_t sequence = record.sequence.load(std::memory_order_acquire);
+  if (sequence != readPos + 1) return false;
+
+  size_t length = formatRecord(record, line, LOG_LINE_MAX);
+  record.sequence.store(readPos + LOG_RING_SLOTS, std::memory_order_release);
+  readPos++;
+
+  Serial.write((const uint8_t*)line, length);
+  return true;
+}
+
+static void logDrainTask(void* pvParameters) {
+  static char line[LOG_LINE_MAX];
+  uint32_t reportedDrops = 0;
+
+  while (1) {
+    while (drainOne(line)) {
+    }
+
+    uint32_t drops = logDroppedCount();
+    if (drops != reportedDrops) {
+      int length = snprintf(line, sizeof(line), "[log] %lu Zeilen verworfen (Ring voll)\n",
+                            (unsigned long)(drops - reportedDrops));
+      Serial.write((const uint8_t*)line, length);
+      reportedDrops = drops;
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_IDLE_MS));
+  }
+}
+
+void logInit(int8_t core) {
+  if (drainTask != nullptr) return;
+  if (core < 0) core = xPortGetCoreID() == 0 ? 1 : 0;
+
+  xTaskCreatePinnedToCore(logDrainTask, "LogDrain", 3072, NULL,
+                          tskIDLE_PRIORITY + 1, &drainTask, core);
+}
@@ -0,0 +1,165 @@
+#ifndef PIXEL_LOG_H
+#define PIXEL_LOG_H
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * @file PixelLog.h
+ * @brief Logging, das den aufrufenden Task nie blockiert.
+ *
+ * logLine() legt nur den Format-String (als Zeiger) und die Argumente
+ * binär in einem Ringpuffer ab. Formatiert und auf die UART geschrieben
+ * wird erst im Drain-Task, der mit niedriger Priorität auf dem anderen
+ * Kern läuft. Ist der Ring voll, wird der Eintrag verworfen und gezählt.
+ *
+ * Der Ring ist lock-frei für beliebig viele Schreiber (Tasks auf beiden
+ * Kernen); gelesen wird nur vom Drain-Task.
+ *
+ * Einschränkungen:
+ *  - format muss dauerhaft gültig sein (String-Literal), Strings unter
+ *    den Argumenten werden dagegen kopiert (max. LOG_STRING_MAX Zeichen)
+ *  - Längenangaben (l, ll, h, z) werden ignoriert, der Typ kommt aus dem
+ *    Argument selbst; '*' als Breite wird nicht unterstützt
+ *  - jeder Eintrag ist eine Zeile, der Zeilenumbruch kommt automatisch
+ */
+
+#ifndef LOG_RING_SLOTS
+#define LOG_RING_SLOTS      64    // Zweierpotenz
+#endif
+#ifndef LOG_PAYLOAD_BYTES
+#define LOG_PAYLOAD_BYTES   80    // Argumente pro Eintrag, binär
+#endif
+#define LOG_STRING_MAX      64    // längster kopierter String-Parameter
+#define LOG_LINE_MAX        192   // formatierte Zeile inkl. Zeitstempel
+#define LOG_DRAIN_IDLE_MS   10
+
+enum LogArgType : uint8_t {
+  LOG_ARG_INT = 0,
+  LOG_ARG_UINT,
+  LOG_ARG_INT64,
+  LOG_ARG_UINT64,
+  LOG_ARG_FLOAT,
+  LOG_ARG_DOUBLE,
+  LOG_ARG_STRING,
+  LOG_ARG_POINTER
+};
+
+struct LogRecord {
+  std::atomic<uint32_t> sequence;   // Slot-Zustand, siehe PixelLog.cpp
+  const char* format;
+  uint32_t timeMs;
+  uint8_t size;                     // belegte Bytes in payload
+  bool truncated;                   // nicht alle Argumente passten hinein
+  uint8_t payload[LOG_PAYLOAD_BYTES];
+};
+
+/**
+ * @brief Schreibt Argumente als (Typ, Wert) hintereinander in payload.
+ */
+class LogPacker {
+private:
+  uint8_t* data;
+  uint8_t used;
+  bool full;
+
+  void addRaw(LogArgType type, const void* value, uint8_t size) {
+    if (full || used + 1 + size > LOG_PAYLOAD_BYTES) {
+      full = true;
+      return;
+    }
+    data[used++] = type;
+    memcpy(data + used, value, size);
+    used += size;
+  }
+
+  template<typename T>
+  void addSigned(T value) {
+    if (sizeof(T) <= 4) { int32_t v = value; addRaw(LOG_ARG_INT, &v, sizeof(v)); }
+    else                { int64_t v = value; addRaw(LOG_ARG_INT64, &v, sizeof(v)); }
+  }
+
+  template<typename T>
+  void addUnsigned(T value) {
+    if (sizeof(T) <= 4) { uint32_t v = value; addRaw(LOG_ARG_UINT, &v, sizeof(v)); }
+    else                { uint64_t v = value; addRaw(LOG_ARG_UINT64, &v, sizeof(v)); }
+  }
+
+public:
+  explicit LogPacker(uint8_t* data) : data(data), used(0), full(false) {}
+
+  uint8_t size() const { return used; }
+  bool truncated() const { return full; }
+
+  void add(int value)                { addSigned(value); }
+  void add(long value)               { addSigned(value); }
+  void add(long long value)          { addSigned(value); }
+  void add(unsigned int value)       { addUnsigned(value); }
+  void add(unsigned long value)      { addUnsigned(value); }
+  void add(unsigned long long value) { addUnsigned(value); }
+  void add(float value)              { addRaw(LOG_ARG_FLOAT, &value, sizeof(value)); }
+  void add(double value)             { addRaw(LOG_ARG_DOUBLE, &value, sizeof(value)); }
+  void add(const void* value)        { addRaw(LOG_ARG_POINTER, &value, sizeof(value)); }
+  void add(const String& value)      { add(value.c_str()); }
+
+  // String wird gekürzt, falls er nicht mehr ganz in den Eintrag passt
+  void add(const char* value) {
+    if (value == nullptr) value = "(null)";
+    if (full || used + 2 > LOG_PAYLOAD_BYTES) {
+      full = true;
+      return;
+    }
+    size_t length = strlen(value);
+    size_t room = LOG_PAYLOAD_BYTES - used - 2;
+    if (length > LOG_STRING_MAX) length = LOG_STRING_MAX;
+    if (length > room) length = room;
+
+    data[used++] = LOG_ARG_STRING;
+    data[used++] = (uint8_t)length;
+    memcpy(data + used, value, length);
+    used += length;
+  }
+};
+
+inline void logPack(LogPacker&) {}
+
+template<typename T, typename... Rest>
+inline void logPack(LogPacker& packer, const T& first, const Rest&... rest) {
+  packer.add(first);
+  logPack(packer, rest...);
+}
+
+/**
+ * @brief Startet den Drain-Task. Vorher geloggte Zeilen bleiben im Ring
+ *        und werden danach ausgegeben.
+ * @param core  Kern des Drain-Tasks; -1 = der andere als der Aufrufer
+ */
+void logInit(int8_t core = -1);
+
+// Freien Slot reservieren bzw. fertigen Slot freigeben (für logLine)
+LogRecord* logClaim();
+void logPublish(LogRecord* record);
+
+/**
+ * @brief Zeile im printf-Stil loggen, kehrt sofort zurück.
+ *
+ * Beispiel: logLine("HTTP Fehler: %d", httpCode);
+ */
+template<typename... Args>
+void logLine(const char* format, const Args&... args) {
+  LogRecord* record = logClaim();
+  if (record == nullptr) return;
+
+  LogPacker packer(record->payload);
+  logPack(packer, args...);
+  record->format = format;
+  record->timeMs = millis();
+  record->size = packer.size();
+  record->truncated = packer.truncated();
+  logPublish(record);
+}
+
+// Anzahl verworfener Zeilen seit dem Start (Ring war voll)
+uint32_t logDroppedCount();
+
+#endif // PIXEL_LOG_H
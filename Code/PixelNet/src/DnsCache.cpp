@@ -0,0 +1,188 @@
+/**
+ * @file DnsCache.cpp
+ * @brief Minimaler DNS-Client (RFC 1035, nur A-Records), siehe DnsCache.h.
+ */
+
+#include "DnsCache.h"
+#include <WiFiUdp.h>
+
+#define DNS_PORT         53
+#define DNS_PACKET_MAX   512
+#define DNS_TYPE_A       1
+#define DNS_TYPE_CNAME   5
+#define DNS_CLASS_IN     1
+
+struct DnsEntry {
+  char host[DNS_HOST_MAX];
+  IPAddress ip;
+  uint32_t expiresMs;
+  uint32_t lastUsedMs;
+  bool valid;
+};
+
+static DnsEntry entries[DNS_CACHE_SLOTS];
+
+static uint16_t read16(const uint8_t* p) {
+  return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t read32(const uint8_t* p) {
+  return ((uint32_t)read16(p) << 16) | read16(p + 2);
+}
+
+// ==================== ANFRAGE ====================
+
+static size_t buildQuery(uint8_t* packet, uint16_t id, const char* host) {
+  memset(packet, 0, 12);
+  packet[0] = id >> 8;
+  packet[1] = id & 0xFF;
+  packet[2] = 0x01;   // RD: rekursiv auflösen
+  packet[5] = 1;      // QDCOUNT
+
+  size_t pos = 12;
+  while (*host) {
+    const char* dot = strchr(host, '.');
+    size_t length = dot ? (size_t)(dot - host) : strlen(host);
+    if (length == 0 || length > 63 || pos + length + 6 > DNS_PACKET_MAX) return 0;
+    packet[pos++] = length;
+    memcpy(packet + pos, host, length);
+    pos += length;
+    host += length + (dot ? 1 : 0);
+  }
+  packet[pos++] = 0;
+  packet[pos++] = 0; packet[pos++] = DNS_TYPE_A;
+  packet[pos++] = 0; packet[pos++] = DNS_CLASS_IN;
+  return pos;
+}
+
+// Name überspringen: Labels bis zur Null oder ein Kompressionszeiger
+static bool skipName(const uint8_t* packet, size_t length, size_t& pos) {
+  while (pos < length) {
+    uint8_t label = packet[pos];
+    if ((label & 0xC0) == 0xC0) {
+      pos += 2;
+      return pos <= length;
+    }
+    pos += label + 1;
+    if (label == 0) return pos <= length;
+  }
+  return false;
+}
+
+// Erste A-Adresse der Antwort, TTL = kleinste TTL von A und CNAME
+static bool parseResponse(const uint8_t* packet, size_t length, uint16_t id,
+                          IPAddress& ip, uint32_t& ttl) {
+  if (length < 12 || read16(packet) != id) return false;
+  if ((packet[2] & 0x80) == 0 || (packet[3] & 0x0F) != 0) return false;
+
+  uint16_t questions = read16(packet + 4);
+  uint16_t answers = read16(packet + 6);
+  size_t pos = 12;
+
+  for (uint16_t i = 0; i < questions; i++) {
+    if (!skipName(packet, length, pos)) return false;
+    pos += 4;
+  }
+
+  bool found = false;
+  uint32_t minTtl = UINT32_MAX;
+  for (uint16_t i = 0; i < answers; i++) {
+    if (!skipName(packet, length, pos) || pos + 10 > length) return false;
+    uint16_t type = read16(packet + pos);
+    uint32_t recordTtl = read32(packet + pos + 4);
+    uint16_t dataLength = read16(packet + pos + 8);
+    pos += 10;
+    if (pos + dataLength > length) return false;
+
+    if (type == DNS_TYPE_A || type == DNS_TYPE_CNAME) {
+      if (recordTtl < minTtl) minTtl = recordTtl;
+    }
+    if (type == DNS_TYPE_A && dataLength == 4 && !found) {
+      ip = IPAddress(packet[pos], packet[pos + 1], packet[pos + 2], packet[pos + 3]);
+      found = true;
+    }
+    pos += dataLength;
+  }
+
+  if (found) ttl = minTtl;
+  return found;
+}
+
+static bool queryServer(const char* host, IPAddress& ip, uint32_t& ttl) {
+  static uint8_t packet[DNS_PACKET_MAX];
+  uint16_t id = random(0x10000);
+  size_t length = buildQuery(packet, id, host);
+  if (length == 0) return false;
+
+  WiFiUDP udp;
+  if (!udp.begin(0)) return false;
+  if (!udp.beginPacket(WiFi.dnsIP(), DNS_PORT)) return false;
+  udp.write(packet, length);
+  if (!udp.endPacket()) return false;
+
+  const uint32_t start = millis();
+  while (millis() - start < DNS_TIMEOUT_MS) {
+    int size = udp.parsePacket();
+    if (size > 0) {
+      size_t received = udp.read(packet, min((size_t)size, sizeof(packet)));
+      if (parseResponse(packet, received, id, ip, ttl)) return true;
+    }
+    delay(2);
+  }
+  return false;
+}
+
+// ==================== CACHE ====================
+
+static DnsEntry* findEntry(const char* host) {
+  for (uint8_t i = 0; i < DNS_CACHE_SLOTS; i++) {
+    if (entries[i].valid && strcmp(entries[i].host, host) == 0) return &entries[i];
+  }
+  return nullptr;
+}
+
+// Freier oder abgelaufener Slot, sonst der am längsten unbenutzte
+static DnsEntry* victimEntry(uint32_t now) {
+  DnsEntry* oldest = &entries[0];
+  for (uint8_t i = 0; i < DNS_CACHE_SLOTS; i++) {
+    DnsEntry& entry = entries[i];
+    if (!entry.valid || (int32_t)(entry.expiresMs - now) <= 0) return &entry;
+    if (now - entry.lastUsedMs > now - oldest->lastUsedMs) oldest = &entry;
+  }
+  return oldest;
+}
+
+bool dnsResolve(const char* host, IPAddress& ip, bool* fromCache) {
+  const uint32_t now = millis();
+  if (fromCache) *fromCache = false;
+
+  DnsEntry* entry = findEntry(host);
+  if (entry != nullptr && (int32_t)(entry->expiresMs - now) > 0) {
+    entry->lastUsedMs = now;
+    ip = entry->ip;
+    if (fromCache) *fromCache = true;
+    return true;
+  }
+
+  uint32_t ttl;
+  if (!queryServer(host, ip, ttl)) {
+    if (!WiFi.hostByName(host, ip)) return false;
+    ttl = DNS_FALLBACK_TTL_S;
+  }
+  // Kurze TTLs gelten wie geliefert (0 = nicht cachen), lange werden gekappt
+  if (ttl > DNS_TTL_MAX_S) ttl = DNS_TTL_MAX_S;
+
+  if (strlen(host) >= DNS_HOST_MAX) return true;
+  if (entry == nullptr) entry = victimEntry(now);
+  strcpy(entry->host, host);
+  entry->ip = ip;
+  entry->expiresMs = millis() + ttl * 1000;
+  entry->lastUsedMs = now;
+  entry->valid = true;
+  return true;
+}
+
+void dnsInvalidate(const char* host) {
+  DnsEntry* entry = findEntry(host);
+  if (entry != nullptr) entry->valid = false;
+}
@@ -0,0 +1,37 @@
+#ifndef DNS_CACHE_H
+#define DNS_CACHE_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+/**
+ * @file DnsCache.h
+ * @brief Namensauflösung mit Cache, der die TTL des Servers einhält.
+ *
+ * WiFi.hostByName() verrät die TTL nicht, deshalb stellt dnsResolve()
+ * die A-Anfrage selbst per UDP an den DNS-Server aus dem DHCP und merkt
+ * sich die Antwort so lange, wie der Server es erlaubt (kleinste TTL der
+ * CNAME-Kette, höchstens DNS_TTL_MAX_S; kürzere TTLs bis 0 gelten
+ * unverändert, dann wird eben öfter gefragt). Antwortet
+ * der Server nicht, springt hostByName() mit DNS_FALLBACK_TTL_S ein.
+ *
+ * Nicht thread-sicher: nur aus einem Task benutzen.
+ */
+
+#define DNS_CACHE_SLOTS     4
+#define DNS_HOST_MAX        64    // längerer Name wird aufgelöst, aber nicht gecacht
+#define DNS_TIMEOUT_MS      1500
+#define DNS_TTL_MAX_S       3600
+#define DNS_FALLBACK_TTL_S  60
+
+/**
+ * @brief Löst host zu einer IPv4-Adresse auf, aus dem Cache wenn möglich.
+ * @param fromCache  optional, true wenn keine Anfrage nötig war
+ * @return false, wenn weder Server noch hostByName() eine Adresse liefern
+ */
+bool dnsResolve(const char* host, IPAddress& ip, bool* fromCache = nullptr);
+
+// Eintrag verwerfen, z. B. wenn die Adresse keine Verbindung annimmt
+void dnsInvalidate(const char* host);
+
+#endif // DNS_CACHE_H
@@ -0,0 +1,348 @@
+/**
+ * @file PollClient.cpp
+ * @brief Keep-Alive-HTTP über WiFiClient, siehe PollClient.h.
+ *
+ * HTTPClient kann keine fertige IP-Adresse benutzen und trotzdem den
+ * Hostnamen im Host-Header schicken, deshalb sprechen wir HTTP/1.1 hier
+ * selbst: Statuszeile, Kopfzeilen, Body nach Content-Length, chunked
+ * oder bis zum Verbindungsende.
+ */
+
+#include "PollClient.h"
+#include <PixelLog.h>
+
+// Ein Byte, höchstens timeoutMs warten; -1 bei Timeout oder Verbindungsende
+static int timedRead(WiFiClient& client, uint16_t timeoutMs) {
+  const uint32_t start = millis();
+  while (true) {
+    if (client.available() > 0) return client.read();
+    if (!client.connected() || millis() - start >= timeoutMs) return -1;
+    delay(1);
+  }
+}
+
+static bool waitForData(WiFiClient& client, uint16_t timeoutMs) {
+  const uint32_t start = millis();
+  while (client.available() <= 0) {
+    if (!client.connected() || millis() - start >= timeoutMs) return false;
+    delay(1);
+  }
+  return true;
+}
+
+// ==================== BODY ====================
+
+void PollBodyStream::start(WiFiClient* source, uint16_t timeoutMs, Framing mode, uint32_t length) {
+  client = source;
+  timeout = timeoutMs;
+  framing = mode;
+  remaining = mode == BODY_LENGTH ? length : 0;
+  finished = mode == BODY_NONE || (mode == BODY_LENGTH && length == 0);
+  failed = false;
+  peeked = -1;
+  bytes = 0;
+  lastByteUs = micros();
+}
+
+// Kopf des nächsten Chunks: Größe hex, evtl. ";Erweiterung", dann CRLF.
+// Größe 0 beendet den Body, danach kommen (leere) Trailer-Zeilen.
+bool PollBodyStream::nextChunk() {
+  uint32_t size = 0;
+  bool digits = false;
+  bool extension = false;
+  while (true) {
+    int c = timedRead(*client, timeout);
+    if (c < 0) return false;
+    if (c == '\n') {
+      if (digits) break;
+      continue;   // CRLF hinter den Daten des vorigen Chunks
+    }
+    if (c == '\r' || extension) continue;
+    if (c == ';') { extension = true; continue; }
+
+    int value = isdigit(c) ? c - '0' : (isxdigit(c) ? (tolower(c) - 'a' + 10) : -1);
+    if (value < 0) return false;
+    size = (size << 4) | value;
+    digits = true;
+  }
+
+  if (size > 0) {
+    remaining = size;
+    return true;
+  }
+
+  // Trailer bis zur Leerzeile
+  uint16_t lineLength = 0;
+  while (true) {
+    int c = timedRead(*client, timeout);
+    if (c < 0) return false;
+    if (c == '\n') {
+      if (lineLength == 0) break;
+      lineLength = 0;
+    } else if (c != '\r') {
+      lineLength++;
+    }
+  }
+  finished = true;
+  return true;
+}
+
+int PollBodyStream::readBody() {
+  if (finished || failed || client == nullptr) return -1;
+
+  if (framing == BODY_CHUNKED && remaining == 0) {
+    if (!nextChunk()) {
+      failed = true;
+      return -1;
+    }
+    if (finished) return -1;
+  }
+
+  int c = timedRead(*client, timeout);
+  if (c < 0) {
+    // Ohne Längenangabe endet der Body mit der Verbindung
+    if (framing == BODY_UNTIL_CLOSE && !client->connected()) finished = true;
+    else failed = true;
+    return -1;
+  }
+
+  bytes++;
+  lastByteUs = micros();
+  if (framing != BODY_UNTIL_CLOSE) {
+    remaining--;
+    if (framing == BODY_LENGTH && remaining == 0) finished = true;
+  }
+  return c;
+}
+
+int PollBodyStream::available() {
+  if (peeked >= 0) return 1;
+  if (finished || failed || client == nullptr) return 0;
+  int n = client->available();
+  if (framing == BODY_LENGTH) return min((uint32_t)n, remaining);
+  if (framing == BODY_CHUNKED) return remaining > 0 ? min((uint32_t)n, remaining) : (n > 0 ? 1 : 0);
+  return n;
+}
+
+int PollBodyStream::read() {
+  if (peeked >= 0) {
+    int c = peeked;
+    peeked = -1;
+    return c;
+  }
+  return readBody();
+}
+
+int PollBodyStream::peek() {
+  if (peeked < 0) peeked = readBody();
+  return peeked;
+}
+
+// ==================== CLIENT ====================
+
+bool PollClient::begin(const char* url) {
+  if (strncmp(url, "http://", 7) != 0) return false;
+
+  const char* start = url + 7;
+  const char* slash = strchr(start, '/');
+  const char* end = slash ? slash : start + strlen(start);
+  const char* colon = (const char*)memchr(start, ':', end - start);
+  const char* hostEnd = colon ? colon : end;
+
+  char newHost[DNS_HOST_MAX];
+  size_t hostLength = min((size_t)(hostEnd - start), sizeof(newHost) - 1);
+  memcpy(newHost, start, hostLength);
+  newHost[hostLength] = '\0';
+  uint16_t newPort = colon ? atoi(colon + 1) : 80;
+
+  // Anderer Server: die offene Verbindung taugt nicht mehr
+  if (strcmp(newHost, host) != 0 || newPort != port) {
+    client.stop();
+    strcpy(host, newHost);
+    port = newPort;
+  }
+
+  path = slash ? slash : "/";
+  requestHeaders = String();
+  etag = String();
+  lastModified = String();
+  status = 0;
+  return true;
+}
+
+void PollClient::addHeader(const String& name, const String& value) {
+  requestHeaders += name;
+  requestHeaders += ": ";
+  requestHeaders += value;
+  requestHeaders += "\r\n";
+}
+
+String PollClient::header(const char* name) const {
+  if (strcasecmp(name, "ETag") == 0) return etag;
+  if (strcasecmp(name, "Last-Modified") == 0) return lastModified;
+  return String();
+}
+
+int PollClient::GET() {
+  memset(&timing, 0, sizeof(timing));
+  bool reuse = client.connected();
+  status = request(reuse);
+
+  // Ruhende Verbindung hat der Server inzwischen geschlossen: einmal neu
+  if (reuse && (status == POLL_ERROR_SEND_FAILED || status == POLL_ERROR_CONNECTION_LOST)) {
+    client.stop();
+    memset(&timing, 0, sizeof(timing));
+    status = request(false);
+  }
+
+  if (status < 0) client.stop();
+  return status;
+}
+
+int PollClient::request(bool reuse) {
+  timing.reused = reuse;
+
+  if (!reuse) {
+    const uint32_t dnsStart = micros();
+    IPAddress ip;
+    if (!dnsResolve(host, ip, &timing.dnsCached)) return POLL_ERROR_CONNECTION_REFUSED;
+    const uint32_t connectStart = micros();
+    timing.dnsUs = connectStart - dnsStart;
+
+    int connected = client.connect(ip, port, timeout);
+    timing.connectUs = micros() - connectStart;
+    if (!connected) {
+      dnsInvalidate(host);
+      return POLL_ERROR_CONNECTION_REFUSED;
+    }
+    client.setNoDelay(true);
+  }
+
+  String head;
+  head.reserve(160 + path.length() + requestHeaders.length());
+  head += "GET ";
+  head += path;
+  head += " HTTP/1.1\r\nHost: ";
+  head += host;
+  if (port != 80) {
+    head += ":";
+    head += String(port);
+  }
+  head += "\r\nUser-Agent: PixelBoard\r\nConnection: keep-alive\r\n";
+  head += requestHeaders;
+  head += "\r\n";
+
+  const uint32_t sentUs = micros();
+  if (client.write((const uint8_t*)head.c_str(), head.length()) != head.length()) {
+    return POLL_ERROR_SEND_FAILED;
+  }
+  return readHead(sentUs);
+}
+
+bool PollClient::readLine(char* line, size_t capacity) {
+  size_t length = 0;
+  while (true) {
+    int c = timedRead(client, timeout);
+    if (c < 0) return false;
+    if (c == '\n') break;
+    if (c != '\r' && length < capacity - 1) line[length++] = c;
+  }
+  line[length] = '\0';
+  return true;
+}
+
+int PollClient::readHead(uint32_t sentUs) {
+  if (!waitForData(client, timeout)) {
+    return client.connected() ? POLL_ERROR_READ_TIMEOUT : POLL_ERROR_CONNECTION_LOST;
+  }
+  timing.ttfbUs = micros() - sentUs;
+
+  // Auf dem Stack: mehrere PollClients in verschiedenen Tasks teilen nichts
+  char line[POLL_LINE_MAX];
+  if (!readLine(line, sizeof(line))) return POLL_ERROR_CONNECTION_LOST;
+  // "HTTP/1.1 200 OK"
+  if (strncmp(line, "HTTP/1.", 7) != 0 || strlen(line) < 12) return POLL_ERROR_NO_HTTP_SERVER;
+  int code = atoi(line + 9);
+  keepAlive = line[7] == '1';
+
+  contentLength = -1;
+  bool chunked = false;
+  etag = String();
+  lastModified = String();
+
+  while (true) {
+    if (!readLine(line, sizeof(line))) return POLL_ERROR_CONNECTION_LOST;
+    if (line[0] == '\0') break;
+
+    char* colon = strchr(line, ':');
+    if (colon == nullptr) continue;
+    *colon = '\0';
+    const char* value = colon + 1;
+    while (*value == ' ') value++;
+
+    if (strcasecmp(line, "Content-Length") == 0) contentLength = atol(value);
+    else if (strcasecmp(line, "Transfer-Encoding") == 0) chunked = strcasecmp(value, "chunked") == 0;
+    else if (strcasecmp(line, "Connection") == 0) keepAlive = strcasecmp(value, "close") != 0;
+    else if (strcasecmp(line, "ETag") == 0) etag = value;
+    else if (strcasecmp(line, "Last-Modified") == 0) lastModified = value;
+  }
+
+  PollBodyStream::Framing framing;
+  if (code == 204 || code == 304 || code < 200) {
+    framing = PollBodyStream::BODY_NONE;
+  } else if (chunked) {
+    framing = PollBodyStream::BODY_CHUNKED;
+    contentLength = -1;
+  } else if (contentLength >= 0) {
+    framing = PollBodyStream::BODY_LENGTH;
+  } else {
+    framing = PollBodyStream::BODY_UNTIL_CLOSE;
+    keepAlive = false;
+  }
+
+  body.start(&client, timeout, framing, contentLength > 0 ? contentLength : 0);
+  bodyStartUs = micros();
+  return code;
+}
+
+void PollClient::end() {
+  if (status > 0) {
+    uint32_t drained = 0;
+    while (!body.finished && !body.failed && drained < POLL_DRAIN_MAX) {
+      if (body.read() < 0) break;
+      drained++;
+    }
+
+    timing.bodyBytes = body.bytes;
+    timing.bodyUs = body.bytes > 0 ? body.lastByteUs - bodyStartUs : 0;
+    if (!keepAlive || !body.finished) client.stop();
+    logTiming();
+  }
+
+  body.start(nullptr, timeout, PollBodyStream::BODY_NONE, 0);
+  requestHeaders = String();
+  status = 0;
+}
+
+void PollClient::logTiming() {
+  if (timing.reused) {
+    logLine("HTTP %d: Verbindung wiederverwendet | TTFB %.1f ms | Body %.1f ms, %u B",
+            status, timing.ttfbUs / 1000.0f, timing.bodyUs / 1000.0f, timing.bodyBytes);
+  } else {
+    logLine("HTTP %d: DNS %.1f ms%s | Connect %.1f ms | TTFB %.1f ms | Body %.1f ms, %u B",
+            status, timing.dnsUs / 1000.0f, timing.dnsCached ? " (Cache)" : "",
+            timing.connectUs / 1000.0f, timing.ttfbUs / 1000.0f,
+            timing.bodyUs / 1000.0f, timing.bodyBytes);
+  }
+}
+
+String PollClient::errorToString(int error) {
+  switch (error) {
+    case POLL_ERROR_CONNECTION_REFUSED: return String("connection refused");
+    case POLL_ERROR_SEND_FAILED:        return String("send header failed");
+    case POLL_ERROR_CONNECTION_LOST:    return String("connection lost");
+    case POLL_ERROR_NO_HTTP_SERVER:     return String("no HTTP server");
+    case POLL_ERROR_READ_TIMEOUT:       return String("read Timeout");
+    default:                            return String();
+  }
+}
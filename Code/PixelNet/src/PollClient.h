@@ -0,0 +1,144 @@
+#ifndef POLL_CLIENT_H
+#define POLL_CLIENT_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiClient.h>
+#include "DnsCache.h"
+
+/**
+ * @file PollClient.h
+ * @brief HTTP/1.1-Client für periodische Abrufe desselben Servers.
+ *
+ * Die Verbindung bleibt zwischen zwei Abrufen offen (Keep-Alive), die
+ * Adresse kommt aus dem DNS-Cache. Hat der Server eine ruhende Verbindung
+ * inzwischen geschlossen, baut GET() sie einmal neu auf, ohne dass der
+ * Aufrufer etwas merkt. Nach jedem Abruf loggt end() die Zeiten für DNS,
+ * Verbindungsaufbau, erstes Antwortbyte und Body.
+ *
+ * Die Schnittstelle folgt HTTPClient, soweit die Apps sie benutzen. Nur
+ * http://, die Antwort wird weder dekomprimiert noch umgeleitet.
+ * Chunked-Encoding löst getStream() selbst auf.
+ *
+ * Ablauf wie bisher: begin(url) → addHeader() → GET() → getStream() lesen
+ * → end(). Ein PollClient gehört genau einem Task.
+ */
+
+#define POLL_HTTP_OK                     200
+#define POLL_HTTP_NOT_MODIFIED           304
+
+// Fehlercodes wie bei HTTPClient
+#define POLL_ERROR_CONNECTION_REFUSED    (-1)
+#define POLL_ERROR_SEND_FAILED           (-2)
+#define POLL_ERROR_CONNECTION_LOST       (-5)
+#define POLL_ERROR_NO_HTTP_SERVER        (-7)
+#define POLL_ERROR_READ_TIMEOUT          (-11)
+
+#define POLL_LINE_MAX      256    // längste Kopfzeile, der Rest wird verworfen
+#define POLL_DRAIN_MAX     4096   // so viel ungelesenen Body liest end() noch weg
+
+// Zeiten des letzten Abrufs in µs
+struct PollTiming {
+  uint32_t dnsUs;
+  uint32_t connectUs;
+  uint32_t ttfbUs;          // Request gesendet bis erstes Antwortbyte
+  uint32_t bodyUs;          // Kopf gelesen bis letztes Body-Byte
+  uint32_t bodyBytes;
+  bool dnsCached;
+  bool reused;              // Verbindung vom vorigen Abruf, kein DNS/Connect
+};
+
+/**
+ * @brief Body einer Antwort; liefert -1 am Ende des Bodys statt am Ende
+ *        der Verbindung, damit sie für den nächsten Abruf offen bleibt.
+ */
+class PollBodyStream : public Stream {
+  friend class PollClient;
+
+private:
+  enum Framing : uint8_t { BODY_NONE, BODY_LENGTH, BODY_CHUNKED, BODY_UNTIL_CLOSE };
+
+  WiFiClient* client = nullptr;
+  uint16_t timeout = 5000;
+  Framing framing = BODY_NONE;
+  uint32_t remaining = 0;   // BODY_LENGTH: Rest des Bodys, BODY_CHUNKED: Rest des Chunks
+  bool finished = true;     // Body vollständig gelesen
+  bool failed = false;      // Timeout oder Verbindung weg
+  int peeked = -1;
+  uint32_t bytes = 0;
+  uint32_t lastByteUs = 0;
+
+  void start(WiFiClient* source, uint16_t timeoutMs, Framing mode, uint32_t length);
+  bool nextChunk();
+  int readBody();
+
+public:
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t write(uint8_t) { return 0; }
+};
+
+class PollClient {
+private:
+  WiFiClient client;
+  PollBodyStream body;
+
+  char host[DNS_HOST_MAX] = "";
+  uint16_t port = 80;
+  String path;
+  String requestHeaders;
+  String etag;
+  String lastModified;
+  uint16_t timeout = 5000;
+
+  int status = 0;
+  bool keepAlive = false;
+  int32_t contentLength = -1;
+  PollTiming timing;
+  uint32_t bodyStartUs = 0;
+
+  int request(bool reuse);
+  int readHead(uint32_t sentUs);
+  bool readLine(char* line, size_t capacity);
+  void logTiming();
+
+public:
+  /**
+   * @brief Ziel für den nächsten GET(). Bleiben Host und Port gleich,
+   *        wird die offene Verbindung weiterbenutzt.
+   * @return false bei URL, die nicht mit http:// beginnt
+   */
+  bool begin(const char* url);
+  bool begin(const String& url) { return begin(url.c_str()); }
+
+  void setTimeout(uint16_t timeoutMs) { timeout = timeoutMs; }
+  void addHeader(const String& name, const String& value);
+
+  /**
+   * @return HTTP-Status oder POLL_ERROR_*
+   */
+  int GET();
+
+  // Content-Length, -1 bei Chunked oder unbekannt
+  int getSize() const { return contentLength; }
+  Stream& getStream() { return body; }
+
+  // Nur "ETag" und "Last-Modified" werden gesammelt
+  String header(const char* name) const;
+
+  /**
+   * @brief Liest den Rest des Bodys, hält die Verbindung für den nächsten
+   *        Abruf offen (wenn der Server es zulässt) und loggt die Zeiten.
+   */
+  void end();
+
+  // Verbindung sofort schließen, z. B. vor dem Abschalten des WLANs
+  void stop() { client.stop(); }
+
+  const PollTiming& lastTiming() const { return timing; }
+
+  static String errorToString(int error);
+};
+
+#endif // POLL_CLIENT_H
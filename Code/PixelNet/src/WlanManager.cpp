@@ -0,0 +1,144 @@
+/**
+ * @file WlanManager.cpp
+ * @brief Zustandsautomat für die WLAN-Verbindung, siehe WlanManager.h.
+ *
+ * Die Event-Callbacks laufen im Event-Task des WiFi-Treibers und merken
+ * sich nur das letzte Event, bevor sie den WLAN-Task wecken. Alle
+ * Übergänge und alle Aufrufe von WiFi.begin()/disconnect() macht der
+ * WLAN-Task; so gibt es nur einen Schreiber für den Zustand.
+ */
+
+#include "WlanManager.h"
+#include <PixelLog.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define WLAN_EVENT_NONE  0xFF
+
+static const char* wlanSsid = nullptr;
+static const char* wlanPassword = nullptr;
+static TaskHandle_t wlanTask = nullptr;
+
+static std::atomic<uint8_t> state(WLAN_OFF);
+static std::atomic<uint8_t> pendingEvent(WLAN_EVENT_NONE);
+static std::atomic<uint8_t> pendingReason(0);
+
+// Nur im WLAN-Task
+static uint32_t backoffMs = WLAN_BACKOFF_MIN_MS;
+static uint32_t attemptStartMs = 0;
+static uint32_t retryAtMs = 0;
+
+static void onWifiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+  if (event != ARDUINO_EVENT_WIFI_STA_GOT_IP &&
+      event != ARDUINO_EVENT_WIFI_STA_DISCONNECTED &&
+      event != ARDUINO_EVENT_WIFI_STA_LOST_IP) return;
+
+  if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+    pendingReason.store(info.wifi_sta_disconnected.reason);
+  }
+  pendingEvent.store((uint8_t)event);
+  if (wlanTask != nullptr) xTaskNotifyGive(wlanTask);
+}
+
+static void startAttempt() {
+  attemptStartMs = millis();
+  state.store(WLAN_CONNECTING);
+  WiFi.begin(wlanSsid, wlanPassword);
+}
+
+// Nächster Versuch nach backoffMs ±25 %, danach doppelt so lange
+static void scheduleRetry(const char* cause, uint8_t reason) {
+  uint32_t jitter = backoffMs / 4;
+  uint32_t waitMs = backoffMs - jitter + random(2 * jitter + 1);
+  retryAtMs = millis() + waitMs;
+  backoffMs = min((uint32_t)WLAN_BACKOFF_MAX_MS, backoffMs * 2);
+  state.store(WLAN_BACKOFF);
+  logLine("WLAN %s (Grund %u), neuer Versuch in %u ms", cause, reason, waitMs);
+}
+
+static void handleEvent(uint8_t event) {
+  const uint8_t current = state.load();
+
+  if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+    if (current == WLAN_CONNECTED) return;
+    state.store(WLAN_CONNECTED);
+    backoffMs = WLAN_BACKOFF_MIN_MS;
+    logLine("WLAN verbunden nach %u ms, IP: %s", millis() - attemptStartMs, WiFi.localIP().toString());
+    return;
+  }
+
+  // DISCONNECTED oder LOST_IP
+  if (current == WLAN_BACKOFF) return;
+  WiFi.disconnect();
+  scheduleRetry(current == WLAN_CONNECTED ? "getrennt" : "Verbindung fehlgeschlagen",
+                pendingReason.load());
+}
+
+// Wie lange der Task schlafen darf, bis er wieder etwas tun muss
+static uint32_t nextWakeMs(uint32_t now) {
+  switch (state.load()) {
+    case WLAN_CONNECTING: {
+      uint32_t elapsed = now - attemptStartMs;
+      return elapsed < WLAN_CONNECT_TIMEOUT_MS ? WLAN_CONNECT_TIMEOUT_MS - elapsed : 0;
+    }
+    case WLAN_BACKOFF:
+      return (int32_t)(retryAtMs - now) > 0 ? retryAtMs - now : 0;
+    default:
+      return UINT32_MAX;
+  }
+}
+
+static void wlanTaskLoop(void* pvParameters) {
+  logLine("Verbinde mit WLAN: %s", wlanSsid);
+  startAttempt();
+
+  while (1) {
+    uint32_t waitMs = nextWakeMs(millis());
+    if (waitMs > 0) {
+      ulTaskNotifyTake(pdTRUE, waitMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(waitMs));
+    }
+
+    uint8_t event = pendingEvent.exchange(WLAN_EVENT_NONE);
+    if (event != WLAN_EVENT_NONE) handleEvent(event);
+
+    const uint32_t now = millis();
+    const uint8_t current = state.load();
+    if (current == WLAN_CONNECTING && now - attemptStartMs >= WLAN_CONNECT_TIMEOUT_MS) {
+      WiFi.disconnect();
+      scheduleRetry("Zeitüberschreitung", 0);
+    } else if (current == WLAN_BACKOFF && (int32_t)(retryAtMs - now) <= 0) {
+      startAttempt();
+    }
+  }
+}
+
+void wlanBegin(const char* ssid, const char* password) {
+  if (wlanTask != nullptr) return;
+  wlanSsid = ssid;
+  wlanPassword = password;
+
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(false);   // Backoff macht der WLAN-Task
+  WiFi.onEvent(onWifiEvent);
+
+  xTaskCreatePinnedToCore(wlanTaskLoop, "Wlan", 3072, NULL,
+                          tskIDLE_PRIORITY + 1, &wlanTask, 0);
+}
+
+WlanState wlanState() {
+  return (WlanState)state.load();
+}
+
+bool wlanConnected() {
+  return state.load() == WLAN_CONNECTED;
+}
+
+bool wlanWaitConnected(uint32_t timeoutMs) {
+  const uint32_t start = millis();
+  while (!wlanConnected()) {
+    if (millis() - start >= timeoutMs) return false;
+    vTaskDelay(pdMS_TO_TICKS(50));
+  }
+  return true;
+}
@@ -0,0 +1,48 @@
+#ifndef WLAN_MANAGER_H
+#define WLAN_MANAGER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+/**
+ * @file WlanManager.h
+ * @brief WLAN-Verbindung im Hintergrund, ohne dass ein Aufrufer wartet.
+ *
+ * wlanBegin() kehrt sofort zurück. Die Events des WiFi-Treibers
+ * (WiFi.onEvent) wecken einen kleinen Task, der als einziger WiFi.begin()
+ * aufruft. Schlägt ein Versuch fehl oder reißt die Verbindung ab, wartet
+ * er mit exponentiellem Backoff (WLAN_BACKOFF_MIN_MS, verdoppelt bis
+ * WLAN_BACKOFF_MAX_MS, ±25 % Streuung) und versucht es erneut. Die
+ * Apps fragen nur wlanConnected() ab und verschieben Netzwerkarbeit, bis
+ * die Verbindung steht.
+ */
+
+#define WLAN_BACKOFF_MIN_MS      1000
+#define WLAN_BACKOFF_MAX_MS      60000
+#define WLAN_CONNECT_TIMEOUT_MS  15000   // ohne Event gilt der Versuch als gescheitert
+
+enum WlanState : uint8_t {
+  WLAN_OFF = 0,       // wlanBegin() noch nicht aufgerufen
+  WLAN_CONNECTING,    // WiFi.begin() läuft
+  WLAN_CONNECTED,     // IP erhalten
+  WLAN_BACKOFF        // wartet auf den nächsten Versuch
+};
+
+/**
+ * @brief Startet den Verbindungsaufbau im Hintergrund. Weitere Aufrufe
+ *        ändern nichts, der Task kümmert sich dann selbst um Abbrüche.
+ * @param ssid, password  müssen dauerhaft gültig sein
+ */
+void wlanBegin(const char* ssid, const char* password);
+
+WlanState wlanState();
+bool wlanConnected();
+
+/**
+ * @brief Wartet, bis die Verbindung steht. Nur für Hintergrund-Tasks,
+ *        die ohnehin nichts anderes zu tun haben.
+ * @return false nach timeoutMs ohne Verbindung
+ */
+bool wlanWaitConnected(uint32_t timeoutMs);
+
+#endif // WLAN_MANAGER_H
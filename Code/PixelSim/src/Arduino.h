@@ -0,0 +1,157 @@
+#pragma once
+
+// Host-Ersatz für den Arduino-Kern (env:native).
+// millis()/delay() laufen auf virtueller Zeit, siehe SimRuntime.h.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+
+#include "WString.h"
+#include "Stream.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// ArduinoJson soll wie auf dem ESP32 String und Stream des Kerns benutzen
+#define ARDUINOJSON_ENABLE_ARDUINO_STRING  1
+#define ARDUINOJSON_ENABLE_ARDUINO_STREAM  1
+#define ARDUINOJSON_ENABLE_ARDUINO_PRINT   0
+#define ARDUINOJSON_ENABLE_PROGMEM         0
+
+using std::min;
+using std::max;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH          1
+#define LOW           0
+#define INPUT         0x01
+#define OUTPUT        0x03
+#define INPUT_PULLUP  0x05
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define PROGMEM
+#define PGM_P               const char*
+#define F(text)             (text)
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define memcpy_P            memcpy
+#define strlen_P            strlen
+#define IRAM_ATTR
+
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+uint16_t analogRead(uint8_t pin);
+
+// Pin-Interrupts: die Routine läuft im Thread, der den Pin umschaltet
+// (simSetDigital bzw. digitalWrite)
+#define RISING   0x01
+#define FALLING  0x02
+#define CHANGE   0x03
+#define digitalPinToInterrupt(pin)  (pin)
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);
+void attachInterruptArg(uint8_t pin, void (*isr)(void*), void* arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+// Hardware-Timer wie im ESP32-Arduino-Kern 2.x (80 MHz APB-Takt, geteilt
+// durch divider). Jeder Timer ist ein Thread, der die Routine auf
+// virtueller Zeit aufruft.
+typedef struct hw_timer_s hw_timer_t;
+
+hw_timer_t* timerBegin(uint8_t num, uint16_t divider, bool countUp);
+void timerEnd(hw_timer_t* timer);
+void timerAttachInterrupt(hw_timer_t* timer, void (*isr)(), bool edge);
+void timerAlarmWrite(hw_timer_t* timer, uint64_t alarmValue, bool autoreload);
+void timerAlarmEnable(hw_timer_t* timer);
+void timerAlarmDisable(hw_timer_t* timer);
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2 = nullptr, const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+class IPAddress {
+private:
+  uint8_t octets[4];
+
+public:
+  IPAddress() : octets{0, 0, 0, 0} {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{a, b, c, d} {}
+  uint8_t operator[](int index) const { return octets[index]; }
+  bool operator==(const IPAddress& other) const { return memcmp(octets, other.octets, 4) == 0; }
+  bool operator!=(const IPAddress& other) const { return !(*this == other); }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+    return String(buf);
+  }
+};
+
+// Serial schreibt nach stderr, damit stdout frei für die Terminal-Vorschau bleibt
+class HardwareSerial {
+public:
+  void begin(unsigned long baud) {}
+  void end() {}
+  int available() { return 0; }
+  int read() { return -1; }
+  void flush() { fflush(stderr); }
+  operator bool() const { return true; }
+
+  size_t write(const uint8_t* data, size_t size) { return fwrite(data, 1, size, stderr); }
+  size_t print(const char* text) { return fputs(text, stderr) >= 0 ? strlen(text) : 0; }
+  size_t print(const String& text) { return print(text.c_str()); }
+  size_t print(const IPAddress& ip) { return print(ip.toString()); }
+  size_t print(char c) { return fputc(c, stderr) != EOF ? 1 : 0; }
+  size_t print(unsigned char value, int base = DEC) { return print((unsigned long)value, base); }
+  size_t print(int value, int base = DEC) { return print((long)value, base); }
+  size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+  size_t print(long value, int base = DEC) {
+    return base == HEX ? fprintf(stderr, "%lX", value) : fprintf(stderr, "%ld", value);
+  }
+  size_t print(unsigned long value, int base = DEC) {
+    return base == HEX ? fprintf(stderr, "%lX", value) : fprintf(stderr, "%lu", value);
+  }
+  size_t print(long long value, int base = DEC) { return print((long)value, base); }
+  size_t print(unsigned long long value, int base = DEC) { return print((unsigned long)value, base); }
+  size_t print(double value, int digits = 2) { return fprintf(stderr, "%.*f", digits, value); }
+
+  size_t println() { return print('\n'); }
+  template<typename T>
+  size_t println(const T& value) { size_t n = print(value); return n + println(); }
+  template<typename T>
+  size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+extern HardwareSerial Serial;
+
+// Sketch-Einstiegspunkte, main() liegt in SimRuntime.cpp
+void setup();
+void loop();
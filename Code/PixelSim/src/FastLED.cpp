@@ -0,0 +1,85 @@
+#include "FastLED.h"
+#include "SimBoard.h"
+
+CFastLED FastLED;
+
+// FastLEDs hsv2rgb_rainbow vereinfacht: sechs lineare Abschnitte
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb) {
+  uint8_t section = hsv.h / 43;
+  uint8_t step = (hsv.h - section * 43) * 6;
+  uint8_t up = step;
+  uint8_t down = 255 - step;
+
+  uint8_t r, g, b;
+  switch (section) {
+    case 0:  r = 255;  g = up;   b = 0;    break;
+    case 1:  r = down; g = 255;  b = 0;    break;
+    case 2:  r = 0;    g = 255;  b = up;   break;
+    case 3:  r = 0;    g = down; b = 255;  break;
+    case 4:  r = up;   g = 0;    b = 255;  break;
+    default: r = 255;  g = 0;    b = down; break;
+  }
+
+  // Sättigung mischt Richtung Weiß, Helligkeit skaliert
+  uint8_t white = 255 - hsv.s;
+  r = scale8(r, hsv.s) + white;
+  g = scale8(g, hsv.s) + white;
+  b = scale8(b, hsv.s) + white;
+  rgb.setRGB(scale8_video(r, hsv.v), scale8_video(g, hsv.v), scale8_video(b, hsv.v));
+}
+
+void fill_solid(CRGB* leds, int count, const CRGB& color) {
+  for (int i = 0; i < count; i++) {
+    leds[i] = color;
+  }
+}
+
+void fill_rainbow(CRGB* leds, int count, uint8_t initialHue, uint8_t deltaHue) {
+  for (int i = 0; i < count; i++) {
+    leds[i] = CHSV(initialHue, 255, 255);
+    initialHue += deltaHue;
+  }
+}
+
+void fadeToBlackBy(CRGB* leds, uint16_t count, uint8_t fade) {
+  for (uint16_t i = 0; i < count; i++) {
+    leds[i].fadeToBlackBy(fade);
+  }
+}
+
+void CLEDController::showLeds(uint8_t brightness) {
+  simBoardLatch(*this, brightness);
+  simBoardPresent();
+}
+
+void CLEDController::clearLeds(int ledCount) {
+  fill_solid(data, ledCount < 0 ? count : ledCount, CRGB::Black);
+}
+
+CLEDController& CFastLED::add(uint8_t pin, CRGB* leds, int count) {
+  if (controllerCount >= SIM_MAX_CONTROLLERS) {
+    Serial.println(F("[sim] zu viele Controller"));
+    return controllers[SIM_MAX_CONTROLLERS - 1];
+  }
+  CLEDController& controller = controllers[controllerCount++];
+  controller.init(pin, leds, count);
+  return controller;
+}
+
+void CFastLED::show(uint8_t scale) {
+  for (int i = 0; i < controllerCount; i++) {
+    simBoardLatch(controllers[i], scale);
+  }
+  simBoardPresent();
+}
+
+void CFastLED::clear(bool writeData) {
+  clearData();
+  if (writeData) show(0);
+}
+
+void CFastLED::clearData() {
+  for (int i = 0; i < controllerCount; i++) {
+    controllers[i].clearLeds();
+  }
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+// FastLED-Ersatz für env:native: gleiche Typen und Aufrufe wie FastLED 3.6,
+// show() schiebt die Daten aber nicht auf einen Pin, sondern an SimBoard,
+// das daraus das Bild der echten Panels zusammensetzt.
+
+#include <Arduino.h>
+
+#define FASTLED_VERSION 3006000
+
+typedef uint8_t fract8;
+
+enum EOrder { RGB = 0012, RBG = 0021, GRB = 0102, GBR = 0120, BRG = 0201, BGR = 0210 };
+
+inline uint8_t scale8(uint8_t value, fract8 scale) {
+  return ((uint16_t)value * (1 + (uint16_t)scale)) >> 8;
+}
+inline uint8_t scale8_video(uint8_t value, fract8 scale) {
+  return (((uint16_t)value * (uint16_t)scale) >> 8) + ((value && scale) ? 1 : 0);
+}
+inline uint8_t qadd8(uint8_t a, uint8_t b) { unsigned t = a + b; return t > 255 ? 255 : t; }
+inline uint8_t qsub8(uint8_t a, uint8_t b) { return a > b ? a - b : 0; }
+inline uint8_t blend8(uint8_t a, uint8_t b, fract8 amountOfB) {
+  return ((uint16_t)a * (255 - amountOfB) + (uint16_t)b * amountOfB + 128) >> 8;
+}
+
+// Wie sin16_C in FastLED: Viertelwelle in 8 Geradenstücken, theta
+// 0-65535 = eine Periode, Ergebnis -32767..32767
+inline int16_t sin16(uint16_t theta) {
+  static const uint16_t base[] = { 0, 6393, 12539, 18204, 23170, 27245, 30273, 32137 };
+  static const uint8_t slope[] = { 49, 48, 44, 38, 31, 23, 14, 4 };
+  uint16_t offset = (theta & 0x3FFF) >> 3;
+  if (theta & 0x4000) offset = 2047 - offset;
+  const uint8_t section = offset / 256;
+  const uint8_t secoffset8 = (uint8_t)offset / 2;
+  int16_t y = slope[section] * secoffset8 + base[section];
+  if (theta & 0x8000) y = -y;
+  return y;
+}
+
+struct CHSV {
+  uint8_t h, s, v;
+  CHSV() : h(0), s(0), v(0) {}
+  CHSV(uint8_t hue, uint8_t sat, uint8_t val) : h(hue), s(sat), v(val) {}
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB {
+  union {
+    struct { uint8_t r, g, b; };
+    struct { uint8_t red, green, blue; };
+    uint8_t raw[3];
+  };
+
+  typedef enum {
+    Black = 0x000000, White = 0xFFFFFF, Red = 0xFF0000, Green = 0x008000,
+    Blue = 0x0000FF, Yellow = 0xFFFF00, Cyan = 0x00FFFF, Aqua = 0x00FFFF,
+    Magenta = 0xFF00FF, Fuchsia = 0xFF00FF, Orange = 0xFFA500, Purple = 0x800080,
+    Pink = 0xFFC0CB, Gray = 0x808080, Grey = 0x808080, DarkGray = 0xA9A9A9,
+    LightGrey = 0xD3D3D3, Silver = 0xC0C0C0, Brown = 0xA52A2A, Gold = 0xFFD700,
+    Lime = 0x00FF00, Navy = 0x000080, Teal = 0x008080, Maroon = 0x800000,
+    Olive = 0x808000, Violet = 0xEE82EE, Indigo = 0x4B0082, DarkBlue = 0x00008B,
+    DarkGreen = 0x006400, DarkRed = 0x8B0000, SkyBlue = 0x87CEEB,
+    Turquoise = 0x40E0D0, OrangeRed = 0xFF4500, DeepPink = 0xFF1493
+  } HTMLColorCode;
+
+  CRGB() : r(0), g(0), b(0) {}
+  CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  CRGB(uint32_t code) : r((code >> 16) & 0xFF), g((code >> 8) & 0xFF), b(code & 0xFF) {}
+  CRGB(HTMLColorCode code) : CRGB((uint32_t)code) {}
+  CRGB(const CHSV& hsv) { hsv2rgb_rainbow(hsv, *this); }
+
+  CRGB& operator=(uint32_t code) { *this = CRGB(code); return *this; }
+  CRGB& operator=(const CHSV& hsv) { hsv2rgb_rainbow(hsv, *this); return *this; }
+
+  uint8_t& operator[](uint8_t index) { return raw[index]; }
+  const uint8_t& operator[](uint8_t index) const { return raw[index]; }
+
+  CRGB& setRGB(uint8_t nr, uint8_t ng, uint8_t nb) { r = nr; g = ng; b = nb; return *this; }
+  CRGB& setHSV(uint8_t hue, uint8_t sat, uint8_t val) { return *this = CHSV(hue, sat, val); }
+  CRGB& setHue(uint8_t hue) { return *this = CHSV(hue, 255, 255); }
+
+  CRGB& nscale8(uint8_t scale) {
+    r = scale8(r, scale); g = scale8(g, scale); b = scale8(b, scale);
+    return *this;
+  }
+  CRGB& nscale8_video(uint8_t scale) {
+    r = scale8_video(r, scale); g = scale8_video(g, scale); b = scale8_video(b, scale);
+    return *this;
+  }
+  CRGB& fadeToBlackBy(uint8_t fade) { return nscale8(255 - fade); }
+  CRGB& operator%=(uint8_t scale) { return nscale8_video(scale); }
+
+  CRGB& operator+=(const CRGB& o) { r = qadd8(r, o.r); g = qadd8(g, o.g); b = qadd8(b, o.b); return *this; }
+  CRGB& operator-=(const CRGB& o) { r = qsub8(r, o.r); g = qsub8(g, o.g); b = qsub8(b, o.b); return *this; }
+  CRGB& operator|=(const CRGB& o) { r = max(r, o.r); g = max(g, o.g); b = max(b, o.b); return *this; }
+
+  explicit operator bool() const { return r || g || b; }
+  uint8_t getLuma() const { return (54 * r + 183 * g + 18 * b) >> 8; }
+  uint8_t getAverageLight() const { return (r + g + b) / 3; }
+};
+
+inline bool operator==(const CRGB& a, const CRGB& b) { return a.r == b.r && a.g == b.g && a.b == b.b; }
+inline bool operator!=(const CRGB& a, const CRGB& b) { return !(a == b); }
+inline CRGB operator+(const CRGB& a, const CRGB& b) { CRGB r(a); r += b; return r; }
+inline CRGB operator-(const CRGB& a, const CRGB& b) { CRGB r(a); r -= b; return r; }
+
+inline CRGB blend(const CRGB& a, const CRGB& b, fract8 amountOfB) {
+  return CRGB(blend8(a.r, b.r, amountOfB), blend8(a.g, b.g, amountOfB), blend8(a.b, b.b, amountOfB));
+}
+inline CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amountOfOverlay) {
+  existing = blend(existing, overlay, amountOfOverlay);
+  return existing;
+}
+
+void fill_solid(CRGB* leds, int count, const CRGB& color);
+void fill_rainbow(CRGB* leds, int count, uint8_t initialHue, uint8_t deltaHue = 5);
+void fadeToBlackBy(CRGB* leds, uint16_t count, uint8_t fade);
+
+// Chipsätze sind nur Typnamen, das Timing simuliert LedOutput/TimingModelOutput
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = RGB> class WS2811 {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = RGB> class WS2812 {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = RGB> class WS2812B {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = RGB> class WS2813 {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = RGB> class SK6812 {};
+
+#define SIM_MAX_CONTROLLERS 8
+
+class CLEDController {
+private:
+  CRGB* data;
+  int count;
+  uint8_t pin;
+
+public:
+  CLEDController() : data(nullptr), count(0), pin(0) {}
+  void init(uint8_t dataPin, CRGB* leds, int ledCount) { pin = dataPin; data = leds; count = ledCount; }
+
+  CLEDController& setLeds(CRGB* leds, int ledCount) { data = leds; count = ledCount; return *this; }
+  CLEDController& setCorrection(uint32_t correction) { return *this; }
+  CLEDController& setTemperature(uint32_t temperature) { return *this; }
+  void showLeds(uint8_t brightness = 255);
+  void clearLeds(int ledCount = -1);
+
+  CRGB* leds() { return data; }
+  const CRGB* leds() const { return data; }
+  int size() const { return count; }
+  uint8_t getPin() const { return pin; }
+};
+
+class CFastLED {
+private:
+  CLEDController controllers[SIM_MAX_CONTROLLERS];
+  int controllerCount;
+  uint8_t brightness;
+
+  CLEDController& add(uint8_t pin, CRGB* leds, int count);
+
+public:
+  CFastLED() : controllerCount(0), brightness(255) {}
+
+  template<template<uint8_t DATA_PIN, EOrder RGB_ORDER> class Chipset, uint8_t DATA_PIN, EOrder RGB_ORDER>
+  CLEDController& addLeds(CRGB* leds, int count, int offset = 0) {
+    return add(DATA_PIN, leds + offset, count);
+  }
+  template<template<uint8_t DATA_PIN, EOrder RGB_ORDER> class Chipset, uint8_t DATA_PIN>
+  CLEDController& addLeds(CRGB* leds, int count, int offset = 0) {
+    return add(DATA_PIN, leds + offset, count);
+  }
+
+  void setBrightness(uint8_t scale) { brightness = scale; }
+  uint8_t getBrightness() const { return brightness; }
+  void setMaxPowerInVoltsAndMilliamps(uint8_t volts, uint32_t milliamps) {}
+  void setMaxRefreshRate(uint16_t refresh, bool constrain = false) {}
+
+  void show() { show(brightness); }
+  void show(uint8_t scale);
+  void clear(bool writeData = false);
+  void clearData();
+
+  int count() const { return controllerCount; }
+  CLEDController& operator[](int index) { return controllers[index]; }
+};
+
+extern CFastLED FastLED;
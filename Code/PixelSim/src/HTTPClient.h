@@ -0,0 +1,98 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SimNet.h>
+#include <string>
+
+// HTTP-Ersatz für env:native. Ohne SIM_HTTP_FILE scheitert jeder Request
+// wie ohne Netz, die Apps laufen dann in ihre Fehlerpfade ("---" bzw.
+// Fehlertext). Mit SIM_HTTP_FILE beantwortet der Ersatz jeden GET mit
+// 200 und dem Dateiinhalt als Body, z. B. einer aufgezeichneten
+// API-Antwort aus PixelSim/payloads/. ETag ist ein Hash des Inhalts,
+// Last-Modified die Änderungszeit der Datei; passt If-None-Match bzw.
+// If-Modified-Since dazu, kommt 304 ohne Body.
+
+#define HTTP_CODE_OK                    200
+#define HTTP_CODE_NOT_MODIFIED          304
+#define HTTPC_ERROR_CONNECTION_REFUSED  (-1)
+#define HTTPC_ERROR_READ_TIMEOUT        (-11)
+
+// Body einer Antwort, gelesen wird Byte für Byte wie vom Socket
+class SimHttpStream : public Stream {
+private:
+  std::string body;
+  size_t pos = 0;
+
+public:
+  void load(const std::string& text) { body = text; pos = 0; }
+  size_t size() const { return body.size(); }
+
+  int available() override { return (int)(body.size() - pos); }
+  int read() override { return pos < body.size() ? (uint8_t)body[pos++] : -1; }
+  int peek() override { return pos < body.size() ? (uint8_t)body[pos] : -1; }
+};
+
+class HTTPClient {
+private:
+  SimHttpStream stream;
+  bool responded = false;
+  String ifNoneMatch;
+  String ifModifiedSince;
+  String etag;
+  String lastModified;
+
+public:
+  bool begin(const String& url) { return true; }
+  bool begin(const char* url) { return true; }
+  void end() {
+    stream.load(std::string());
+    responded = false;
+    ifNoneMatch = String();
+    ifModifiedSince = String();
+  }
+  void setTimeout(uint16_t timeout) { stream.setTimeout(timeout); }
+  void setReuse(bool reuse) {}
+  void useHTTP10(bool useHTTP10 = true) {}
+  void addHeader(const String& name, const String& value) {
+    if (name == "If-None-Match") ifNoneMatch = value;
+    if (name == "If-Modified-Since") ifModifiedSince = value;
+  }
+  void collectHeaders(const char* headerKeys[], size_t headerKeysCount) {}
+
+  String header(const char* name) {
+    if (strcmp(name, "ETag") == 0) return etag;
+    if (strcmp(name, "Last-Modified") == 0) return lastModified;
+    return String();
+  }
+  bool hasHeader(const char* name) { return header(name).length() > 0; }
+
+  int GET() {
+    std::string body, etagText, lastModifiedText;
+    if (!simHttpLoad(body, etagText, lastModifiedText)) return HTTPC_ERROR_CONNECTION_REFUSED;
+    etag = String(etagText);
+    lastModified = String(lastModifiedText);
+
+    responded = true;
+    if ((ifNoneMatch.length() > 0 && ifNoneMatch == etag) ||
+        (ifNoneMatch.length() == 0 && ifModifiedSince.length() > 0 && ifModifiedSince == lastModified)) {
+      stream.load(std::string());
+      return HTTP_CODE_NOT_MODIFIED;
+    }
+    stream.load(body);
+    return HTTP_CODE_OK;
+  }
+  int getSize() { return responded ? (int)stream.size() : -1; }
+  Stream& getStream() { return stream; }
+
+  String getString() {
+    std::string text;
+    int c;
+    while ((c = stream.read()) >= 0) text += (char)c;
+    return String(text);
+  }
+
+  static String errorToString(int error) {
+    return error == HTTPC_ERROR_CONNECTION_REFUSED ? String("connection refused")
+                                                   : String("error");
+  }
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SimRuntime.h>
+#include <map>
+#include <mutex>
+#include <string>
+
+// NVS-Ersatz für env:native. Die Werte liegen im Speicher, mit SIM_NVS_DIR
+// zusätzlich als Datei pro Schlüssel, damit sie einen Neustart des
+// Programms überleben (wie NVS einen Reset des ESP32).
+
+class Preferences {
+private:
+  std::string space;
+  bool readOnly = true;
+  bool opened = false;
+
+  static std::map<std::string, std::string>& store() {
+    static std::map<std::string, std::string> values;
+    return values;
+  }
+  static std::mutex& storeLock() {
+    static std::mutex lock;
+    return lock;
+  }
+
+  std::string path(const char* key) const {
+    return std::string(simEnv("SIM_NVS_DIR", "")) + "/" + space + "." + key;
+  }
+
+  bool load(const char* key, std::string& value) const {
+    std::lock_guard<std::mutex> guard(storeLock());
+    auto it = store().find(space + "/" + key);
+    if (it != store().end()) {
+      value = it->second;
+      return true;
+    }
+    if (simEnv("SIM_NVS_DIR", nullptr) == nullptr) return false;
+
+    FILE* file = fopen(path(key).c_str(), "rb");
+    if (file == nullptr) return false;
+    char buf[256];
+    size_t n;
+    value.clear();
+    while ((n = fread(buf, 1, sizeof(buf), file)) > 0) value.append(buf, n);
+    fclose(file);
+    store()[space + "/" + key] = value;
+    return true;
+  }
+
+  size_t save(const char* key, const void* data, size_t length) {
+    if (!opened || readOnly) return 0;
+    std::lock_guard<std::mutex> guard(storeLock());
+    store()[space + "/" + key] = std::string((const char*)data, length);
+    if (simEnv("SIM_NVS_DIR", nullptr) != nullptr) {
+      FILE* file = fopen(path(key).c_str(), "wb");
+      if (file != nullptr) {
+        fwrite(data, 1, length, file);
+        fclose(file);
+      }
+    }
+    return length;
+  }
+
+public:
+  bool begin(const char* name, bool readOnly = false) {
+    space = name;
+    this->readOnly = readOnly;
+    opened = true;
+    return true;
+  }
+  void end() { opened = false; }
+
+  bool isKey(const char* key) const {
+    std::string value;
+    return load(key, value);
+  }
+
+  size_t getBytesLength(const char* key) const {
+    std::string value;
+    return load(key, value) ? value.size() : 0;
+  }
+  size_t getBytes(const char* key, void* buf, size_t maxLen) const {
+    std::string value;
+    if (!load(key, value) || value.size() > maxLen) return 0;
+    memcpy(buf, value.data(), value.size());
+    return value.size();
+  }
+  size_t putBytes(const char* key, const void* value, size_t len) { return save(key, value, len); }
+
+  String getString(const char* key, const String& defaultValue = String()) const {
+    std::string value;
+    return load(key, value) ? String(value) : defaultValue;
+  }
+  size_t putString(const char* key, const String& value) {
+    return save(key, value.c_str(), value.length());
+  }
+
+  bool remove(const char* key) {
+    if (!opened || readOnly) return false;
+    std::lock_guard<std::mutex> guard(storeLock());
+    store().erase(space + "/" + key);
+    if (simEnv("SIM_NVS_DIR", nullptr) != nullptr) ::remove(path(key).c_str());
+    return true;
+  }
+};
@@ -0,0 +1,110 @@
+#include "SimBoard.h"
+#include "SimRuntime.h"
+
+#include <chrono>
+#include <mutex>
+
+static CRGB board[SIM_BOARD_WIDTH * SIM_BOARD_HEIGHT];
+static CRGB lastPresented[SIM_BOARD_WIDTH * SIM_BOARD_HEIGHT];
+static uint32_t frameCount = 0;
+static std::mutex boardLock;
+
+// Panel-Index einer LED bei VERTICAL_ZIGZAG: gerade Spalten laufen nach unten
+static uint16_t zigzagIndex(uint8_t x, uint8_t y) {
+  return (x & 1) ? (x + 1) * SIM_PANEL_HEIGHT - 1 - y : x * SIM_PANEL_HEIGHT + y;
+}
+
+// Kopiert ein Panel so ins Bild, wie man es auf der montierten Hardware sieht
+static void latchPanel(const CLEDController& controller, uint8_t orientation,
+                       uint8_t rowOffset, uint8_t brightness) {
+  for (uint8_t vy = 0; vy < SIM_PANEL_HEIGHT; vy++) {
+    for (uint8_t vx = 0; vx < SIM_PANEL_WIDTH; vx++) {
+      uint8_t x = vx;
+      uint8_t y = vy;
+      if (orientation == SIM_MIRROR_X || orientation == SIM_ROTATE_180) x = SIM_PANEL_WIDTH - 1 - vx;
+      if (orientation == SIM_MIRROR_Y || orientation == SIM_ROTATE_180) y = SIM_PANEL_HEIGHT - 1 - vy;
+
+      uint16_t index = zigzagIndex(x, y);
+      CRGB color = index < controller.size() ? controller.leds()[index] : CRGB::Black;
+      board[(rowOffset + vy) * SIM_BOARD_WIDTH + vx] = color.nscale8_video(brightness);
+    }
+  }
+}
+
+void simBoardLatch(const CLEDController& controller, uint8_t brightness) {
+  if (controller.leds() == nullptr) return;
+
+  std::lock_guard<std::mutex> guard(boardLock);
+  if (controller.getPin() == SIM_PANEL_TOP_PIN) {
+    latchPanel(controller, SIM_PANEL_TOP_ORIENTATION, 0, brightness);
+  } else if (controller.getPin() == SIM_PANEL_BOTTOM_PIN) {
+    latchPanel(controller, SIM_PANEL_BOTTOM_ORIENTATION, SIM_PANEL_HEIGHT, brightness);
+  }
+}
+
+const CRGB* simBoardPixels() {
+  return board;
+}
+
+uint32_t simBoardFrameCount() {
+  return frameCount;
+}
+
+// ==================== AUSGABE ====================
+
+static void writePpm(const char* dir, uint32_t number) {
+  static const int scale = constrain(simEnvLong("SIM_PPM_SCALE", 8), 1, 64);
+
+  char path[512];
+  snprintf(path, sizeof(path), "%s/frame_%06u.ppm", dir, number);
+  FILE* file = fopen(path, "wb");
+  if (file == nullptr) return;
+
+  fprintf(file, "P6\n%d %d\n255\n", SIM_BOARD_WIDTH * scale, SIM_BOARD_HEIGHT * scale);
+  for (int y = 0; y < SIM_BOARD_HEIGHT * scale; y++) {
+    for (int x = 0; x < SIM_BOARD_WIDTH * scale; x++) {
+      const CRGB& c = board[(y / scale) * SIM_BOARD_WIDTH + x / scale];
+      fputc(c.r, file);
+      fputc(c.g, file);
+      fputc(c.b, file);
+    }
+  }
+  fclose(file);
+}
+
+// Zwei LED-Zeilen pro Terminalzeile: Oberhalbblock mit Vorder- und Hintergrundfarbe
+static void printPreview() {
+  printf("\x1b[H");
+  for (int y = 0; y < SIM_BOARD_HEIGHT; y += 2) {
+    for (int x = 0; x < SIM_BOARD_WIDTH; x++) {
+      const CRGB& top = board[y * SIM_BOARD_WIDTH + x];
+      const CRGB& bottom = board[(y + 1) * SIM_BOARD_WIDTH + x];
+      printf("\x1b[38;2;%u;%u;%um\x1b[48;2;%u;%u;%um▀",
+             top.r, top.g, top.b, bottom.r, bottom.g, bottom.b);
+    }
+    printf("\x1b[0m\n");
+  }
+  printf("%8.1f s  Frame %u\x1b[K\n", millis() / 1000.0, frameCount);
+  fflush(stdout);
+}
+
+void simBoardPresent() {
+  static const bool preview = simEnvLong("SIM_PREVIEW", 0) != 0;
+  static const long previewFps = max(1L, simEnvLong("SIM_PREVIEW_FPS", 30));
+  static const char* outDir = simEnv("SIM_OUT_DIR", nullptr);
+  static std::chrono::steady_clock::time_point nextPreview;
+
+  std::lock_guard<std::mutex> guard(boardLock);
+  if (memcmp(board, lastPresented, sizeof(board)) == 0) return;
+  memcpy(lastPresented, board, sizeof(board));
+  frameCount++;
+
+  if (outDir) writePpm(outDir, frameCount);
+
+  auto now = std::chrono::steady_clock::now();
+  if (preview && now >= nextPreview) {
+    if (frameCount == 1) printf("\x1b[2J");
+    printPreview();
+    nextPreview = now + std::chrono::microseconds(1000000 / previewFps);
+  }
+}
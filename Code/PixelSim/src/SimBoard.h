@@ -0,0 +1,47 @@
+#pragma once
+
+#include <FastLED.h>
+
+// Physikalisches Modell des PixelBoards für env:native.
+//
+// Zwei 32×8-Panels (VERTICAL_ZIGZAG, gerade Spalten laufen nach unten)
+// übereinander. Pro Panel wird per Build-Flag festgelegt, an welchem
+// Pin es hängt und wie es montiert ist – so, wie die Hardware des
+// jeweiligen Projekts verdrahtet ist. Die Apps wissen davon nichts:
+// Sie schreiben wie auf dem ESP32 in ihre ledsTop/ledsBottom-Arrays,
+// SimBoard setzt daraus das Bild zusammen, das man auf den echten
+// Panels sehen würde.
+
+#define SIM_NORMAL      0
+#define SIM_MIRROR_X    1
+#define SIM_MIRROR_Y    2
+#define SIM_ROTATE_180  3
+
+#ifndef SIM_PANEL_TOP_PIN
+#define SIM_PANEL_TOP_PIN           25
+#endif
+#ifndef SIM_PANEL_TOP_ORIENTATION
+#define SIM_PANEL_TOP_ORIENTATION   SIM_NORMAL
+#endif
+#ifndef SIM_PANEL_BOTTOM_PIN
+#define SIM_PANEL_BOTTOM_PIN        26
+#endif
+#ifndef SIM_PANEL_BOTTOM_ORIENTATION
+#define SIM_PANEL_BOTTOM_ORIENTATION  SIM_ROTATE_180
+#endif
+
+#define SIM_PANEL_WIDTH   32
+#define SIM_PANEL_HEIGHT  8
+#define SIM_BOARD_WIDTH   SIM_PANEL_WIDTH
+#define SIM_BOARD_HEIGHT  (2 * SIM_PANEL_HEIGHT)
+
+// Wird von FastLED.show()/showLeds() aufgerufen. Ist der Controller an
+// keinem der beiden Panel-Pins, wird er ignoriert.
+void simBoardLatch(const CLEDController& controller, uint8_t brightness);
+
+// Aktuelles Bild, Zeile 0 oben, so wie man auf das Board schaut
+const CRGB* simBoardPixels();
+uint32_t simBoardFrameCount();
+
+// Ausgabe gemäß Umgebungsvariablen (siehe SimRuntime.h), aus simBoardLatch
+void simBoardPresent();
@@ -0,0 +1,484 @@
+#include "SimNet.h"
+#include "SimRuntime.h"
+#include "WiFi.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <unistd.h>
+#include <mutex>
+#include <thread>
+
+static std::once_flag startOnce;
+static bool enabled = false;
+static uint16_t httpPort = 0;
+static uint16_t dnsPort = 0;
+
+// ==================== DATEI ====================
+
+bool simHttpLoad(std::string& body, std::string& etag, std::string& lastModified) {
+  const char* path = simEnv("SIM_HTTP_FILE", nullptr);
+  if (path == nullptr) return false;
+  FILE* file = fopen(path, "rb");
+  if (file == nullptr) return false;
+
+  char buf[512];
+  size_t n;
+  body.clear();
+  while ((n = fread(buf, 1, sizeof(buf), file)) > 0) body.append(buf, n);
+  fclose(file);
+
+  uint32_t hash = 2166136261u;
+  for (char c : body) hash = (hash ^ (uint8_t)c) * 16777619u;
+  char text[40];
+  snprintf(text, sizeof(text), "\"%08x\"", hash);
+  etag = text;
+
+  struct stat info;
+  lastModified.clear();
+  if (stat(path, &info) == 0) {
+    struct tm modified;
+    gmtime_r(&info.st_mtime, &modified);
+    strftime(text, sizeof(text), "%a, %d %b %Y %H:%M:%S GMT", &modified);
+    lastModified = text;
+  }
+  return true;
+}
+
+void simNetRoundTrip() {
+  long rttMs = simEnvLong("SIM_NET_RTT_MS", 0);
+  if (rttMs > 0) delay(rttMs);
+}
+
+// Virtuelle ms in echte ms für poll()
+static int realTimeoutMs(long virtualMs) {
+  return (int)(virtualMs / simSpeed()) + 1;
+}
+
+static bool sendAll(int fd, const char* data, size_t length) {
+  while (length > 0) {
+    ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+    if (n <= 0) return false;
+    data += n;
+    length -= n;
+  }
+  return true;
+}
+
+// ==================== HTTP ====================
+
+static std::string headerValue(const std::string& request, const char* name) {
+  std::string key = std::string("\r\n") + name + ":";
+  size_t start = std::string::npos;
+  for (size_t i = 0; i + key.size() <= request.size(); i++) {
+    if (strncasecmp(request.c_str() + i, key.c_str(), key.size()) == 0) {
+      start = i + key.size();
+      break;
+    }
+  }
+  if (start == std::string::npos) return std::string();
+  while (start < request.size() && request[start] == ' ') start++;
+  size_t end = request.find("\r\n", start);
+  return request.substr(start, end - start);
+}
+
+static bool sendResponse(int fd, const std::string& request, bool closeAfter) {
+  std::string body, etag, lastModified;
+  simHttpLoad(body, etag, lastModified);
+
+  std::string ifNoneMatch = headerValue(request, "If-None-Match");
+  std::string ifModifiedSince = headerValue(request, "If-Modified-Since");
+  bool notModified = ifNoneMatch.empty() ? (!ifModifiedSince.empty() && ifModifiedSince == lastModified)
+                                         : ifNoneMatch == etag;
+  bool chunked = simEnvLong("SIM_HTTP_CHUNKED", 0) != 0 && !notModified;
+
+  std::string head = notModified ? "HTTP/1.1 304 Not Modified\r\n" : "HTTP/1.1 200 OK\r\n";
+  head += "Content-Type: application/json\r\n";
+  head += "ETag: " + etag + "\r\n";
+  if (!lastModified.empty()) head += "Last-Modified: " + lastModified + "\r\n";
+  if (chunked) {
+    head += "Transfer-Encoding: chunked\r\n";
+  } else if (!notModified) {
+    head += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+  }
+  head += closeAfter ? "Connection: close\r\n\r\n" : "Connection: keep-alive\r\n\r\n";
+
+  simNetRoundTrip();
+  if (!sendAll(fd, head.data(), head.size())) return false;
+  if (notModified) return true;
+  if (!chunked) return sendAll(fd, body.data(), body.size());
+
+  for (size_t pos = 0; pos < body.size(); pos += 256) {
+    size_t length = std::min<size_t>(256, body.size() - pos);
+    char size[16];
+    snprintf(size, sizeof(size), "%zx\r\n", length);
+    if (!sendAll(fd, size, strlen(size)) ||
+        !sendAll(fd, body.data() + pos, length) ||
+        !sendAll(fd, "\r\n", 2)) return false;
+  }
+  return sendAll(fd, "0\r\n\r\n", 5);
+}
+
+static void serveConnection(int fd) {
+  long idleMs = simEnvLong("SIM_HTTP_KEEPALIVE_MS", 75000);
+  long maxRequests = simEnvLong("SIM_HTTP_MAX_REQUESTS", 100);
+  std::string buffer;
+  long served = 0;
+
+  while (true) {
+    size_t end;
+    while ((end = buffer.find("\r\n\r\n")) == std::string::npos) {
+      struct pollfd p = { fd, POLLIN, 0 };
+      if (poll(&p, 1, realTimeoutMs(idleMs)) <= 0) goto done;
+      char chunk[512];
+      ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+      if (n <= 0) goto done;
+      buffer.append(chunk, n);
+    }
+
+    {
+      std::string request = buffer.substr(0, end + 2);
+      buffer.erase(0, end + 4);
+      served++;
+      bool closeAfter = served >= maxRequests ||
+                        strcasecmp(headerValue(request, "Connection").c_str(), "close") == 0;
+      if (!sendResponse(fd, request, closeAfter) || closeAfter) goto done;
+    }
+  }
+
+done:
+  close(fd);
+}
+
+static void httpAcceptLoop(int listener) {
+  while (true) {
+    int fd = accept(listener, nullptr, nullptr);
+    if (fd < 0) continue;
+    std::thread(serveConnection, fd).detach();
+  }
+}
+
+// ==================== DNS ====================
+
+// Antwort: Kopf und Frage der Anfrage, dazu ein A-Record 127.0.0.1
+static void dnsLoop(int fd) {
+  uint32_t ttl = simEnvLong("SIM_DNS_TTL_S", 30);
+
+  while (true) {
+    uint8_t packet[512];
+    struct sockaddr_in from;
+    socklen_t fromLength = sizeof(from);
+    ssize_t n = recvfrom(fd, packet, sizeof(packet) - 16, 0, (struct sockaddr*)&from, &fromLength);
+    if (n < 12) continue;
+
+    size_t pos = 12;
+    while (pos < (size_t)n && packet[pos] != 0) pos += packet[pos] + 1;
+    pos += 5;   // Null-Label, QTYPE, QCLASS
+    if (pos > (size_t)n) continue;
+
+    packet[2] = 0x81;   // QR, RD
+    packet[3] = 0x80;   // RA, RCODE 0
+    packet[6] = 0; packet[7] = 1;   // ANCOUNT
+    packet[8] = 0; packet[9] = 0;
+    packet[10] = 0; packet[11] = 0;
+
+    const uint8_t answer[16] = {
+      0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01,
+      (uint8_t)(ttl >> 24), (uint8_t)(ttl >> 16), (uint8_t)(ttl >> 8), (uint8_t)ttl,
+      0x00, 0x04, 127, 0, 0, 1
+    };
+    memcpy(packet + pos, answer, sizeof(answer));
+
+    simNetRoundTrip();
+    sendto(fd, packet, pos + sizeof(answer), 0, (struct sockaddr*)&from, fromLength);
+  }
+}
+
+// ==================== START ====================
+
+static uint16_t bindLoopback(int fd) {
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) return 0;
+  socklen_t length = sizeof(addr);
+  getsockname(fd, (struct sockaddr*)&addr, &length);
+  return ntohs(addr.sin_port);
+}
+
+static void startServers() {
+  std::string body, etag, lastModified;
+  if (!simHttpLoad(body, etag, lastModified)) return;
+
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  int udp = socket(AF_INET, SOCK_DGRAM, 0);
+  httpPort = bindLoopback(listener);
+  dnsPort = bindLoopback(udp);
+  if (httpPort == 0 || dnsPort == 0 || listen(listener, 8) != 0) {
+    fprintf(stderr, "[sim] Stand-in-Server konnte nicht starten\n");
+    return;
+  }
+
+  std::thread(httpAcceptLoop, listener).detach();
+  std::thread(dnsLoop, udp).detach();
+  enabled = true;
+}
+
+bool simNetEnabled() {
+  std::call_once(startOnce, startServers);
+  return enabled;
+}
+
+uint16_t simNetHttpPort() {
+  return simNetEnabled() ? httpPort : 0;
+}
+
+uint16_t simNetDnsPort() {
+  return simNetEnabled() ? dnsPort : 0;
+}
+
+// ==================== WiFiClient / WiFiUDP ====================
+
+int WiFiClient::connect(IPAddress ip, uint16_t port, int32_t timeoutMs) {
+  stop();
+  if (!WiFi.isConnected() || !simNetEnabled()) return 0;
+
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port == 80 ? simNetHttpPort() : port);
+  if (::connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+    stop();
+    return 0;
+  }
+  simNetRoundTrip();
+  return 1;
+}
+
+int WiFiClient::connect(const char* host, uint16_t port, int32_t timeoutMs) {
+  return connect(IPAddress(127, 0, 0, 1), port, timeoutMs);
+}
+
+void WiFiClient::stop() {
+  if (fd >= 0) close(fd);
+  fd = -1;
+}
+
+uint8_t WiFiClient::connected() {
+  if (fd < 0) return 0;
+  char c;
+  ssize_t n = recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))) return 1;
+  stop();
+  return 0;
+}
+
+int WiFiClient::setNoDelay(bool nodelay) {
+  int flag = nodelay ? 1 : 0;
+  return fd >= 0 ? setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) : -1;
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+  if (fd < 0) return 0;
+  return sendAll(fd, (const char*)buffer, size) ? size : 0;
+}
+
+int WiFiClient::available() {
+  if (fd < 0) return 0;
+  uint8_t buffer[1024];
+  ssize_t n = recv(fd, buffer, sizeof(buffer), MSG_PEEK | MSG_DONTWAIT);
+  return n > 0 ? (int)n : 0;
+}
+
+int WiFiClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+  if (fd < 0) return -1;
+  ssize_t n = recv(fd, buffer, size, MSG_DONTWAIT);
+  return n > 0 ? (int)n : -1;
+}
+
+int WiFiClient::peek() {
+  uint8_t c;
+  if (fd < 0) return -1;
+  return recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+uint8_t WiFiUDP::begin(uint16_t port) {
+  stop();
+  fd = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+    stop();
+    return 0;
+  }
+  return 1;
+}
+
+void WiFiUDP::stop() {
+  if (fd >= 0) close(fd);
+  fd = -1;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+  if (port == 53) {
+    if (!WiFi.isConnected() || !simNetEnabled()) return 0;
+    port = simNetDnsPort();
+  }
+  remotePort = port;
+  txLength = 0;
+  return 1;
+}
+
+size_t WiFiUDP::write(const uint8_t* buffer, size_t size) {
+  size = std::min(size, sizeof(txBuffer) - txLength);
+  memcpy(txBuffer + txLength, buffer, size);
+  txLength += size;
+  return size;
+}
+
+int WiFiUDP::endPacket() {
+  if (fd < 0 || remotePort == 0) return 0;
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(remotePort);
+  return sendto(fd, txBuffer, txLength, 0, (struct sockaddr*)&addr, sizeof(addr)) == (ssize_t)txLength;
+}
+
+int WiFiUDP::parsePacket() {
+  if (fd < 0) return 0;
+  ssize_t n = recv(fd, rxBuffer, sizeof(rxBuffer), MSG_DONTWAIT);
+  rxLength = n > 0 ? n : 0;
+  rxPos = 0;
+  return (int)rxLength;
+}
+
+int WiFiUDP::read() {
+  return rxPos < rxLength ? rxBuffer[rxPos++] : -1;
+}
+
+int WiFiUDP::read(uint8_t* buffer, size_t size) {
+  size = std::min(size, rxLength - rxPos);
+  memcpy(buffer, rxBuffer + rxPos, size);
+  rxPos += size;
+  return (int)size;
+}
+
+// ==================== WLAN ====================
+
+#include <vector>
+
+struct SimWifiHandler {
+  WiFiEventFuncCb callback;
+  arduino_event_id_t event;
+};
+
+static std::mutex wifiLock;
+static std::vector<SimWifiHandler> wifiHandlers;
+static std::once_flag outageOnce;
+
+// Ruft die Handler wie der Event-Task des ESP32 nacheinander auf
+static void fireWifiEvent(arduino_event_id_t event, uint8_t reason = 0) {
+  arduino_event_info_t info;
+  memset(&info, 0, sizeof(info));
+  info.wifi_sta_disconnected.reason = reason;
+
+  std::vector<SimWifiHandler> handlers;
+  {
+    std::lock_guard<std::mutex> guard(wifiLock);
+    handlers = wifiHandlers;
+  }
+  for (const SimWifiHandler& handler : handlers) {
+    if (handler.event == ARDUINO_EVENT_MAX || handler.event == event) handler.callback(event, info);
+  }
+}
+
+static bool inOutage(uint32_t nowMs) {
+  long start = 0, duration = 0;
+  const char* outage = simEnv("SIM_WIFI_OUTAGE", nullptr);
+  if (outage == nullptr || sscanf(outage, "%ld,%ld", &start, &duration) != 2) return false;
+  return nowMs >= (uint32_t)start && nowMs < (uint32_t)(start + duration);
+}
+
+static void watchOutage() {
+  long start = 0, duration = 0;
+  const char* outage = simEnv("SIM_WIFI_OUTAGE", nullptr);
+  if (outage == nullptr || sscanf(outage, "%ld,%ld", &start, &duration) != 2) return;
+
+  std::thread([start]() {
+    if (millis() < (uint32_t)start) delay(start - millis());
+    fprintf(stderr, "[sim] Hotspot weg\n");
+    if (!WiFi.isConnected()) return;
+    WiFi.disconnect();
+    if (WiFi.getAutoReconnect()) WiFi.reconnect();
+  }).detach();
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventFuncCb callback, arduino_event_id_t event) {
+  std::lock_guard<std::mutex> guard(wifiLock);
+  wifiHandlers.push_back(SimWifiHandler{ callback, event });
+  return wifiHandlers.size();
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventCb callback, arduino_event_id_t event) {
+  return onEvent([callback](arduino_event_id_t id, arduino_event_info_t) { callback(id); }, event);
+}
+
+void WiFiClass::connectAsync() {
+  uint32_t current = ++attempt;
+  state = WL_DISCONNECTED;
+  std::call_once(outageOnce, watchOutage);
+
+  std::thread([this, current]() {
+    delay(simEnvLong("SIM_WIFI_CONNECT_MS", 300));
+    if (attempt != current) return;   // inzwischen disconnect() oder neues begin()
+
+    if (inOutage(millis())) {
+      state = WL_NO_SSID_AVAIL;
+      fireWifiEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, WIFI_REASON_NO_AP_FOUND);
+      if (autoReconnect && attempt == current) connectAsync();
+      return;
+    }
+    state = WL_CONNECTED;
+    fireWifiEvent(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+    fireWifiEvent(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+  }).detach();
+}
+
+wl_status_t WiFiClass::begin(const char* network, const char* password) {
+  ssid = network;
+  connectAsync();
+  return status();
+}
+
+bool WiFiClass::reconnect() {
+  connectAsync();
+  return true;
+}
+
+// Im Ausfallfenster meldet der ESP32 den Abbruch mit BEACON_TIMEOUT
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAp) {
+  attempt++;
+  bool wasConnected = state.exchange(WL_DISCONNECTED) == WL_CONNECTED;
+  if (wasConnected) {
+    fireWifiEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+                  inOutage(millis()) ? WIFI_REASON_BEACON_TIMEOUT : WIFI_REASON_ASSOC_LEAVE);
+  }
+  return true;
+}
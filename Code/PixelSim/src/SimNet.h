@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+// Stand-in-Server für env:native: ein HTTP/1.1-Server mit Keep-Alive und
+// ein DNS-Server auf 127.0.0.1, beide als Threads im Simulator. Sie
+// starten beim ersten Zugriff, wenn SIM_HTTP_FILE gesetzt ist. WiFiClient
+// landet mit Port 80 beim HTTP-Server, WiFiUDP mit Port 53 beim
+// DNS-Server, egal welche Adresse angefragt wurde.
+//
+// Der HTTP-Server beantwortet jeden GET wie der HTTPClient-Ersatz mit der
+// Datei aus SIM_HTTP_FILE (ETag, Last-Modified, 304 bei passendem
+// Validator). Der DNS-Server beantwortet jede A-Anfrage mit 127.0.0.1.
+//
+// Umgebungsvariablen (Zeiten virtuell):
+//   SIM_NET_RTT_MS         Round-Trip-Zeit für TCP-Handshake, jede
+//                          HTTP-Antwort und jede DNS-Antwort (Standard 0)
+//   SIM_DNS_TTL_S          TTL in den DNS-Antworten (Standard 30)
+//   SIM_HTTP_KEEPALIVE_MS  Server schließt ruhende Verbindungen nach so
+//                          vielen ms (Standard 75000, wie nginx)
+//   SIM_HTTP_MAX_REQUESTS  Server schließt nach so vielen Requests pro
+//                          Verbindung (Standard 100)
+//   SIM_HTTP_CHUNKED       1 = Body mit Transfer-Encoding: chunked
+
+// Datei aus SIM_HTTP_FILE mit ETag (Hash) und Last-Modified (mtime)
+bool simHttpLoad(std::string& body, std::string& etag, std::string& lastModified);
+
+// Startet die Server bei Bedarf; false ohne SIM_HTTP_FILE
+bool simNetEnabled();
+uint16_t simNetHttpPort();
+uint16_t simNetDnsPort();
+
+// Wartet eine simulierte Round-Trip-Zeit (virtuell)
+void simNetRoundTrip();
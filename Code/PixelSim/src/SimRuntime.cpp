@@ -0,0 +1,515 @@
+#include "SimRuntime.h"
+#include "SimBoard.h"
+#include "WiFi.h"
+#include "freertos/queue.h"
+
+#include <stdarg.h>
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <vector>
+#include <mutex>
+#include <thread>
+
+HardwareSerial Serial;
+WiFiClass WiFi;
+
+// ==================== VIRTUELLE ZEIT ====================
+//
+// Virtuelle Zeit = echte Zeit × SIM_SPEED. delay() schläft entsprechend
+// kürzer, dadurch bleiben die Verhältnisse zwischen den Tasks erhalten,
+// während eine Minute Anzeige in Sekunden durchläuft.
+
+typedef std::chrono::steady_clock SimClock;
+
+static SimClock::time_point simStart = SimClock::now();
+static double speedFactor = 1.0;
+
+double simSpeed() {
+  return speedFactor;
+}
+
+uint64_t simMicros() {
+  auto real = std::chrono::duration_cast<std::chrono::microseconds>(SimClock::now() - simStart);
+  return (uint64_t)(real.count() * speedFactor);
+}
+
+static SimClock::time_point realTimeAt(uint64_t virtualUs) {
+  return simStart + std::chrono::microseconds((int64_t)(virtualUs / speedFactor));
+}
+
+uint32_t millis() {
+  return (uint32_t)(simMicros() / 1000);
+}
+
+uint32_t micros() {
+  return (uint32_t)simMicros();
+}
+
+static void sleepUntilVirtual(uint64_t virtualUs) {
+  std::this_thread::sleep_until(realTimeAt(virtualUs));
+}
+
+void delay(uint32_t ms) {
+  sleepUntilVirtual(simMicros() + (uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+  sleepUntilVirtual(simMicros() + us);
+}
+
+void yield() {
+  std::this_thread::yield();
+}
+
+// ==================== PINS ====================
+
+static uint16_t analogValues[64];
+static uint8_t digitalValues[64];
+
+static void initPins() {
+  for (uint8_t i = 0; i < 64; i++) {
+    analogValues[i] = SIM_ANALOG_IDLE;
+    digitalValues[i] = HIGH;
+  }
+}
+
+void simSetAnalog(uint8_t pin, uint16_t value) {
+  if (pin < 64) analogValues[pin] = value;
+}
+
+static void setDigital(uint8_t pin, uint8_t value);
+
+void simSetDigital(uint8_t pin, uint8_t value) {
+  setDigital(pin, value);
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+
+int digitalRead(uint8_t pin) {
+  return pin < 64 ? digitalValues[pin] : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  setDigital(pin, value);
+}
+
+uint16_t analogRead(uint8_t pin) {
+  return pin < 64 ? analogValues[pin] : 0;
+}
+
+// ==================== INTERRUPTS ====================
+
+struct SimPinInterrupt {
+  void (*isr)();
+  void (*isrArg)(void*);
+  void* arg;
+  int mode;
+};
+
+static SimPinInterrupt pinInterrupts[64];
+static std::mutex interruptLock;    // wie auf dem ESP32 läuft immer nur eine Routine
+
+static void setDigital(uint8_t pin, uint8_t value) {
+  if (pin >= 64) return;
+  const uint8_t previous = digitalValues[pin];
+  digitalValues[pin] = value;
+  if (previous == value) return;
+
+  const SimPinInterrupt handler = pinInterrupts[pin];
+  const int edge = value ? RISING : FALLING;
+  if (!(handler.mode & edge)) return;
+
+  std::lock_guard<std::mutex> guard(interruptLock);
+  if (handler.isrArg) handler.isrArg(handler.arg);
+  else if (handler.isr) handler.isr();
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+  if (pin < 64) pinInterrupts[pin] = { isr, nullptr, nullptr, mode };
+}
+
+void attachInterruptArg(uint8_t pin, void (*isr)(void*), void* arg, int mode) {
+  if (pin < 64) pinInterrupts[pin] = { nullptr, isr, arg, mode };
+}
+
+void detachInterrupt(uint8_t pin) {
+  if (pin < 64) pinInterrupts[pin] = { nullptr, nullptr, nullptr, 0 };
+}
+
+// Ein Thread pro Timer; er lebt bis zum Programmende, timerEnd() hält ihn
+// nur an
+struct hw_timer_s {
+  uint16_t divider;
+  void (*isr)() = nullptr;
+  uint64_t alarmValue = 0;
+  bool autoreload = false;
+  bool enabled = false;
+  std::mutex lock;
+  std::condition_variable changed;
+};
+
+static void runTimer(hw_timer_t* timer) {
+  std::unique_lock<std::mutex> guard(timer->lock);
+  while (true) {
+    timer->changed.wait(guard, [timer]() { return timer->enabled && timer->alarmValue > 0; });
+
+    // Periode in µs virtueller Zeit, Raster ab dem Einschalten
+    const uint64_t periodUs = std::max<uint64_t>(1, timer->alarmValue * timer->divider / 80);
+    uint64_t nextUs = simMicros() + periodUs;
+    while (timer->enabled) {
+      if (timer->changed.wait_until(guard, realTimeAt(nextUs), [timer]() { return !timer->enabled; })) break;
+
+      void (*isr)() = timer->isr;
+      guard.unlock();
+      if (isr) {
+        std::lock_guard<std::mutex> isrGuard(interruptLock);
+        isr();
+      }
+      guard.lock();
+
+      if (!timer->autoreload) {
+        timer->enabled = false;
+        break;
+      }
+      nextUs += periodUs;
+    }
+  }
+}
+
+hw_timer_t* timerBegin(uint8_t num, uint16_t divider, bool countUp) {
+  hw_timer_t* timer = new hw_timer_t();
+  timer->divider = divider ? divider : 1;
+  std::thread(runTimer, timer).detach();
+  return timer;
+}
+
+void timerEnd(hw_timer_t* timer) {
+  timerAlarmDisable(timer);
+}
+
+void timerAttachInterrupt(hw_timer_t* timer, void (*isr)(), bool edge) {
+  std::lock_guard<std::mutex> guard(timer->lock);
+  timer->isr = isr;
+}
+
+void timerAlarmWrite(hw_timer_t* timer, uint64_t alarmValue, bool autoreload) {
+  std::lock_guard<std::mutex> guard(timer->lock);
+  timer->alarmValue = alarmValue;
+  timer->autoreload = autoreload;
+}
+
+void timerAlarmEnable(hw_timer_t* timer) {
+  {
+    std::lock_guard<std::mutex> guard(timer->lock);
+    timer->enabled = true;
+  }
+  timer->changed.notify_all();
+}
+
+void timerAlarmDisable(hw_timer_t* timer) {
+  {
+    std::lock_guard<std::mutex> guard(timer->lock);
+    timer->enabled = false;
+  }
+  timer->changed.notify_all();
+}
+
+// ==================== ARDUINO-HILFEN ====================
+
+long random(long howBig) {
+  return howBig > 0 ? rand() % howBig : 0;
+}
+
+long random(long howSmall, long howBig) {
+  return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(unsigned long seed) {
+  srand(seed);
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// Host-Uhr ist schon gestellt, die Zeitzone kommt aus TZ
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2, const char* server3) {}
+
+bool getLocalTime(struct tm* info, uint32_t ms) {
+  time_t now = time(nullptr);
+  localtime_r(&now, info);
+  return true;
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int n = vfprintf(stderr, format, args);
+  va_end(args);
+  return n > 0 ? n : 0;
+}
+
+// ==================== TASKS ====================
+
+struct tskTaskControlBlock {
+  const char* name;
+  uint32_t stackDepth;
+  BaseType_t core;
+  std::mutex lock;
+  std::condition_variable notified;
+  uint32_t notifyCount = 0;
+};
+
+// Die Task, die nicht mehr zurückkehren soll (vTaskDelete(nullptr))
+struct SimTaskExit {};
+
+static tskTaskControlBlock loopTask;
+static thread_local tskTaskControlBlock* currentTask = &loopTask;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name,
+                                   uint32_t stackDepth, void* parameters,
+                                   UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core) {
+  tskTaskControlBlock* task = new tskTaskControlBlock();
+  task->name = name;
+  task->stackDepth = stackDepth;
+  task->core = core;
+  if (handle) *handle = task;
+
+  std::thread([function, parameters, task]() {
+    currentTask = task;
+    try {
+      function(parameters);
+    } catch (const SimTaskExit&) {
+    }
+  }).detach();
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name,
+                       uint32_t stackDepth, void* parameters,
+                       UBaseType_t priority, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(function, name, stackDepth, parameters,
+                                 priority, handle, tskNO_AFFINITY);
+}
+
+// Fremde Threads lassen sich nicht abbrechen; nur die eigene Task endet
+void vTaskDelete(TaskHandle_t task) {
+  if (task == nullptr || task == currentTask) {
+    throw SimTaskExit();
+  }
+}
+
+void vTaskDelay(TickType_t ticks) {
+  delay(ticks * portTICK_PERIOD_MS);
+}
+
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t increment) {
+  *previousWakeTime += increment;
+  sleepUntilVirtual((uint64_t)*previousWakeTime * portTICK_PERIOD_MS * 1000);
+}
+
+TickType_t xTaskGetTickCount() {
+  return millis() / portTICK_PERIOD_MS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return currentTask;
+}
+
+BaseType_t xPortGetCoreID() {
+  return currentTask->core == tskNO_AFFINITY ? 1 : currentTask->core;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+  return task ? task->stackDepth : currentTask->stackDepth;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait) {
+  tskTaskControlBlock* task = currentTask;
+  std::unique_lock<std::mutex> guard(task->lock);
+
+  auto pending = [task]() { return task->notifyCount > 0; };
+  if (ticksToWait == portMAX_DELAY) {
+    task->notified.wait(guard, pending);
+  } else {
+    uint64_t until = simMicros() + (uint64_t)ticksToWait * portTICK_PERIOD_MS * 1000;
+    task->notified.wait_until(guard, realTimeAt(until), pending);
+  }
+
+  uint32_t count = task->notifyCount;
+  if (count > 0) {
+    task->notifyCount = clearCountOnExit ? 0 : count - 1;
+  }
+  return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  {
+    std::lock_guard<std::mutex> guard(task->lock);
+    task->notifyCount++;
+  }
+  task->notified.notify_one();
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken) {
+  if (higherPriorityTaskWoken) *higherPriorityTaskWoken = pdFALSE;
+  xTaskNotifyGive(task);
+}
+
+// ==================== WARTESCHLANGEN ====================
+
+// Ringpuffer mit length Plätzen à itemSize Byte, angelegt in xQueueCreate()
+struct QueueDefinition {
+  UBaseType_t length;
+  UBaseType_t itemSize;
+  std::vector<uint8_t> storage;
+  UBaseType_t first = 0;             // ältestes Element
+  UBaseType_t count = 0;
+  std::mutex lock;
+  std::condition_variable changed;   // Element dazu oder weg
+
+  uint8_t* slot(UBaseType_t i) { return storage.data() + ((first + i) % length) * itemSize; }
+};
+
+// Wartet, bis ready() gilt oder ticksToWait um ist
+template<typename Ready>
+static bool waitQueue(QueueDefinition* queue, std::unique_lock<std::mutex>& guard,
+                      TickType_t ticksToWait, Ready ready) {
+  if (ticksToWait == portMAX_DELAY) {
+    queue->changed.wait(guard, ready);
+    return true;
+  }
+  uint64_t until = simMicros() + (uint64_t)ticksToWait * portTICK_PERIOD_MS * 1000;
+  return queue->changed.wait_until(guard, realTimeAt(until), ready);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  if (length == 0) return nullptr;
+  QueueDefinition* queue = new QueueDefinition();
+  queue->length = length;
+  queue->itemSize = itemSize;
+  queue->storage.resize((size_t)length * itemSize);
+  return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+  delete queue;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+  {
+    std::lock_guard<std::mutex> guard(queue->lock);
+    queue->first = 0;
+    queue->count = 0;
+  }
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+  {
+    std::unique_lock<std::mutex> guard(queue->lock);
+    auto space = [queue]() { return queue->count < queue->length; };
+    if (!waitQueue(queue, guard, ticksToWait, space)) return errQUEUE_FULL;
+
+    memcpy(queue->slot(queue->count), item, queue->itemSize);
+    queue->count++;
+  }
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+  return xQueueSend(queue, item, ticksToWait);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item) {
+  {
+    std::lock_guard<std::mutex> guard(queue->lock);
+    queue->first = 0;
+    queue->count = 1;
+    memcpy(queue->slot(0), item, queue->itemSize);
+  }
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait) {
+  {
+    std::unique_lock<std::mutex> guard(queue->lock);
+    auto pending = [queue]() { return queue->count > 0; };
+    if (!waitQueue(queue, guard, ticksToWait, pending)) return errQUEUE_EMPTY;
+
+    memcpy(item, queue->slot(0), queue->itemSize);
+    queue->first = (queue->first + 1) % queue->length;
+    queue->count--;
+  }
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  std::lock_guard<std::mutex> guard(queue->lock);
+  return queue->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+  std::lock_guard<std::mutex> guard(queue->lock);
+  return queue->length - queue->count;
+}
+
+// ==================== UMGEBUNG ====================
+
+const char* simEnv(const char* name, const char* fallback) {
+  const char* value = getenv(name);
+  return value && *value ? value : fallback;
+}
+
+long simEnvLong(const char* name, long fallback) {
+  const char* value = simEnv(name, nullptr);
+  return value ? atol(value) : fallback;
+}
+
+// ==================== MAIN ====================
+
+static void simFinish() {
+  auto real = std::chrono::duration_cast<std::chrono::milliseconds>(SimClock::now() - simStart);
+  fprintf(stderr, "\n[sim] %u ms virtuell in %lld ms, %u Frames\n",
+          millis(), (long long)real.count(), simBoardFrameCount());
+  fflush(stdout);
+  fflush(stderr);
+
+  // Task-Threads laufen noch, deshalb ohne statische Destruktoren beenden
+  _exit(0);
+}
+
+int main() {
+  speedFactor = atof(simEnv("SIM_SPEED", "1"));
+  if (speedFactor <= 0) speedFactor = 1.0;
+  uint32_t durationMs = simEnvLong("SIM_DURATION_MS", 0);
+
+  loopTask.name = "loopTask";
+  loopTask.stackDepth = 8192;
+  loopTask.core = 1;
+
+  initPins();
+  simStart = SimClock::now();
+
+  // Läuft auch dann ab, wenn loop() selbst blockiert
+  if (durationMs > 0) {
+    std::thread([durationMs]() {
+      sleepUntilVirtual((uint64_t)durationMs * 1000);
+      simFinish();
+    }).detach();
+  }
+
+  setup();
+  while (true) {
+    loop();
+    yield();
+  }
+}
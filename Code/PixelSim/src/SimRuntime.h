@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Laufzeit für env:native.
+//
+// Umgebungsvariablen:
+//   SIM_SPEED        Faktor für die virtuelle Zeit (Standard 1, z. B. 20:
+//                    eine Minute Uhr/Wetter in drei Sekunden)
+//   SIM_DURATION_MS  nach so vielen virtuellen ms beenden (0 = nie)
+//   SIM_PREVIEW      1 = Vorschau im Terminal (ANSI-Farben auf stdout)
+//   SIM_PREVIEW_FPS  maximale Vorschau-Rate in echter Zeit (Standard 30)
+//   SIM_OUT_DIR      Verzeichnis für PPM-Bilder, eines pro geändertem Frame
+//   SIM_PPM_SCALE    Kantenlänge eines LED-Pixels im PPM (Standard 8)
+//   SIM_HTTP_FILE    Body für jeden HTTP-GET (sonst scheitern alle Requests)
+//   SIM_NVS_DIR      Verzeichnis für Preferences (sonst nur im Speicher)
+//
+// Netz-Knöpfe des Stand-in-Servers (SIM_NET_RTT_MS, SIM_DNS_TTL_S, ...)
+// stehen in SimNet.h, die des WLANs (SIM_WIFI_*) in WiFi.h.
+//
+// Eingänge sind im Ruhezustand: analogRead() liefert die Joystick-Mitte,
+// digitalRead() HIGH (Taster mit Pull-up, nicht gedrückt).
+
+#define SIM_ANALOG_IDLE  2048
+
+double simSpeed();
+uint64_t simMicros();
+
+void simSetAnalog(uint8_t pin, uint16_t value);
+void simSetDigital(uint8_t pin, uint8_t value);
+
+const char* simEnv(const char* name, const char* fallback);
+long simEnvLong(const char* name, long fallback);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Arduino-Stream, soweit ArduinoJson und HTTPClient ihn brauchen
+class Stream {
+protected:
+  unsigned long timeoutMs = 1000;
+
+public:
+  virtual ~Stream() {}
+
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long timeout) { timeoutMs = timeout; }
+
+  virtual size_t readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+      int c = read();
+      if (c < 0) break;
+      buffer[count++] = (char)c;
+    }
+    return count;
+  }
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+};
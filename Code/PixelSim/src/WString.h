@@ -0,0 +1,126 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+// Arduino-String auf std::string, nur der Teil, den die Apps benutzen
+class String {
+private:
+  std::string s;
+
+public:
+  String() {}
+  String(const char* text) : s(text ? text : "") {}
+  String(const std::string& text) : s(text) {}
+  explicit String(char c) : s(1, c) {}
+  explicit String(int value, unsigned char base = 10) { fromLong(value, base); }
+  explicit String(unsigned int value, unsigned char base = 10) { fromLong(value, base); }
+  explicit String(long value, unsigned char base = 10) { fromLong(value, base); }
+  explicit String(unsigned long value, unsigned char base = 10) { fromLong(value, base); }
+  explicit String(float value, unsigned char decimals = 2) { fromDouble(value, decimals); }
+  explicit String(double value, unsigned char decimals = 2) { fromDouble(value, decimals); }
+
+  unsigned int length() const { return s.length(); }
+  const char* c_str() const { return s.c_str(); }
+  bool reserve(unsigned int size) { s.reserve(size); return true; }
+  bool isEmpty() const { return s.empty(); }
+
+  char charAt(unsigned int index) const { return index < s.length() ? s[index] : 0; }
+  char operator[](unsigned int index) const { return charAt(index); }
+
+  String substring(unsigned int from) const {
+    return from < s.length() ? String(s.substr(from)) : String();
+  }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) { unsigned int t = from; from = to; to = t; }
+    if (from >= s.length()) return String();
+    return String(s.substr(from, to - from));
+  }
+
+  int indexOf(char c, unsigned int from = 0) const {
+    size_t pos = s.find(c, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+  }
+  int indexOf(const String& text, unsigned int from = 0) const {
+    size_t pos = s.find(text.s, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+  }
+
+  void toCharArray(char* buf, unsigned int bufsize, unsigned int index = 0) const {
+    if (bufsize == 0 || buf == nullptr) return;
+    unsigned int n = 0;
+    while (n + 1 < bufsize && index + n < s.length()) {
+      buf[n] = s[index + n];
+      n++;
+    }
+    buf[n] = '\0';
+  }
+
+  long toInt() const { return atol(s.c_str()); }
+  float toFloat() const { return (float)atof(s.c_str()); }
+
+  void trim() {
+    size_t first = s.find_first_not_of(" \t\r\n");
+    size_t last = s.find_last_not_of(" \t\r\n");
+    s = first == std::string::npos ? std::string() : s.substr(first, last - first + 1);
+  }
+
+  bool equals(const String& other) const { return s == other.s; }
+  bool operator==(const String& other) const { return s == other.s; }
+  bool operator==(const char* other) const { return s == (other ? other : ""); }
+  bool operator!=(const String& other) const { return s != other.s; }
+
+  String& operator+=(const String& other) { s += other.s; return *this; }
+  String& operator+=(const char* other) { if (other) s += other; return *this; }
+  String& operator+=(char c) { s += c; return *this; }
+  String& operator+=(int value) { return *this += String(value); }
+  String& operator+=(unsigned int value) { return *this += String(value); }
+  String& operator+=(long value) { return *this += String(value); }
+  String& operator+=(unsigned long value) { return *this += String(value); }
+  String& operator+=(float value) { return *this += String(value); }
+  String& operator+=(double value) { return *this += String(value); }
+
+  template<typename T>
+  String& concat(const T& value) { return *this += value; }
+
+  friend String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+  friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, char b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, int b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, unsigned int b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, long b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, unsigned long b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, float b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, double b) { String r(a); r += b; return r; }
+
+private:
+  void fromLong(long value, unsigned char base) {
+    char buf[40];
+    if (base == 16) snprintf(buf, sizeof(buf), "%lx", value);
+    else snprintf(buf, sizeof(buf), "%ld", value);
+    s = buf;
+  }
+  void fromLong(unsigned long value, unsigned char base) {
+    char buf[40];
+    if (base == 16) snprintf(buf, sizeof(buf), "%lx", value);
+    else snprintf(buf, sizeof(buf), "%lu", value);
+    s = buf;
+  }
+  void fromLong(int value, unsigned char base) { fromLong((long)value, base); }
+  void fromLong(unsigned int value, unsigned char base) { fromLong((unsigned long)value, base); }
+  void fromDouble(double value, unsigned char decimals) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+    s = buf;
+  }
+};
+
+// Ergebnistyp von String + ... im Arduino-Kern; ArduinoJson erwartet ihn
+class StringSumHelper : public String {
+public:
+  StringSumHelper(const String& text) : String(text) {}
+};
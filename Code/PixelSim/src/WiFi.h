@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Arduino.h>
+#include "SimNet.h"
+#include "WiFiClient.h"
+#include "WiFiUdp.h"
+#include <atomic>
+#include <functional>
+
+// WLAN-Ersatz für env:native: begin() "verbindet" nach kurzer Zeit, der
+// Host hat ja schon Netz. Ohne begin() bleibt der Status WL_DISCONNECTED.
+// DNS-Server ist der Stand-in aus SimNet.h, jeder Name löst zu 127.0.0.1 auf.
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3
+} wifi_mode_t;
+
+// Events wie beim arduino-esp32-Kern 2.x, soweit die Apps sie benutzen
+typedef enum {
+  ARDUINO_EVENT_WIFI_STA_START = 2,
+  ARDUINO_EVENT_WIFI_STA_STOP,
+  ARDUINO_EVENT_WIFI_STA_CONNECTED,
+  ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+  ARDUINO_EVENT_WIFI_STA_AUTHMODE_CHANGE,
+  ARDUINO_EVENT_WIFI_STA_GOT_IP,
+  ARDUINO_EVENT_WIFI_STA_GOT_IP6,
+  ARDUINO_EVENT_WIFI_STA_LOST_IP,
+  ARDUINO_EVENT_MAX = 50
+} arduino_event_id_t;
+
+#define WIFI_REASON_ASSOC_LEAVE     8
+#define WIFI_REASON_BEACON_TIMEOUT  200
+#define WIFI_REASON_NO_AP_FOUND     201
+
+typedef struct {
+  uint8_t ssid[32];
+  uint8_t ssid_len;
+  uint8_t bssid[6];
+  uint8_t reason;
+} wifi_event_sta_disconnected_t;
+
+typedef union {
+  wifi_event_sta_disconnected_t wifi_sta_disconnected;
+} arduino_event_info_t;
+
+typedef std::function<void(arduino_event_id_t event, arduino_event_info_t info)> WiFiEventFuncCb;
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+typedef size_t wifi_event_id_t;
+
+// Verbindungsaufbau und Abbrüche laufen wie auf dem ESP32 asynchron, die
+// Events kommen aus einem eigenen Thread. Umgebungsvariablen (virtuell):
+//   SIM_WIFI_CONNECT_MS  Dauer von begin() bis GOT_IP (Standard 300)
+//   SIM_WIFI_OUTAGE      "ab_ms,dauer_ms": Hotspot in diesem Fenster weg,
+//                        eine bestehende Verbindung bricht ab
+class WiFiClass {
+private:
+  std::atomic<int> state{WL_DISCONNECTED};
+  std::atomic<uint32_t> attempt{0};
+  bool autoReconnect = true;
+  String ssid;
+
+  void connectAsync();
+
+public:
+  bool mode(wifi_mode_t mode) { return true; }
+  wl_status_t begin(const char* network, const char* password = nullptr);
+  bool disconnect(bool wifiOff = false, bool eraseAp = false);
+  bool reconnect();
+  wl_status_t status() const { return (wl_status_t)state.load(); }
+  bool isConnected() const { return status() == WL_CONNECTED; }
+  IPAddress localIP() const { return IPAddress(127, 0, 0, 1); }
+  IPAddress dnsIP(uint8_t index = 0) const { return IPAddress(127, 0, 0, 1); }
+  int hostByName(const char* host, IPAddress& result) {
+    if (!isConnected() || !simNetEnabled()) return 0;
+    simNetRoundTrip();
+    result = IPAddress(127, 0, 0, 1);
+    return 1;
+  }
+  String SSID() const { return ssid; }
+  int8_t RSSI() const { return -50; }
+  bool setAutoReconnect(bool enabled) { autoReconnect = enabled; return true; }
+  bool getAutoReconnect() const { return autoReconnect; }
+
+  wifi_event_id_t onEvent(WiFiEventFuncCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+  wifi_event_id_t onEvent(WiFiEventCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Arduino.h>
+
+// TCP-Client für env:native. Verbindet immer zum Stand-in-Server des
+// Simulators (SimNet.h), egal welche Adresse angefragt wird; ohne
+// SIM_HTTP_FILE scheitert connect() wie ohne Netz.
+class WiFiClient : public Stream {
+private:
+  int fd = -1;
+  int peeked = -1;
+
+public:
+  WiFiClient() {}
+  ~WiFiClient() { stop(); }
+  WiFiClient(const WiFiClient&) = delete;
+  WiFiClient& operator=(const WiFiClient&) = delete;
+
+  int connect(IPAddress ip, uint16_t port, int32_t timeoutMs = 3000);
+  int connect(const char* host, uint16_t port, int32_t timeoutMs = 3000);
+  void stop();
+  uint8_t connected();
+  operator bool() { return connected(); }
+  int setNoDelay(bool nodelay);
+
+  size_t write(uint8_t data) { return write(&data, 1); }
+  size_t write(const uint8_t* buffer, size_t size);
+
+  int available() override;
+  int read() override;
+  int read(uint8_t* buffer, size_t size);
+  int peek() override;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Arduino.h>
+
+// UDP für env:native. Pakete an Port 53 gehen an den DNS-Teil des
+// Stand-in-Servers (SimNet.h), alle anderen an 127.0.0.1.
+class WiFiUDP {
+private:
+  int fd = -1;
+  uint16_t remotePort = 0;
+  uint8_t txBuffer[512];
+  size_t txLength = 0;
+  uint8_t rxBuffer[512];
+  size_t rxLength = 0;
+  size_t rxPos = 0;
+
+public:
+  ~WiFiUDP() { stop(); }
+
+  uint8_t begin(uint16_t port);
+  void stop();
+
+  int beginPacket(IPAddress ip, uint16_t port);
+  size_t write(uint8_t data) { return write(&data, 1); }
+  size_t write(const uint8_t* buffer, size_t size);
+  int endPacket();
+
+  int parsePacket();
+  int available() { return (int)(rxLength - rxPos); }
+  int read();
+  int read(uint8_t* buffer, size_t size);
+};
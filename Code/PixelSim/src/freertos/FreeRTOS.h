@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+// FreeRTOS-Grundtypen für env:native. 1 Tick = 1 ms virtuelle Zeit.
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdFALSE   0
+#define pdTRUE    1
+#define pdPASS    pdTRUE
+#define pdFAIL    pdFALSE
+
+#define portMAX_DELAY         0xFFFFFFFFu
+#define portTICK_PERIOD_MS    1
+#define configTICK_RATE_HZ    1000
+#define pdMS_TO_TICKS(ms)     ((TickType_t)(ms))
+#define tskNO_AFFINITY        0x7FFFFFFF
+#define tskIDLE_PRIORITY      0
+#define configMAX_PRIORITIES  25
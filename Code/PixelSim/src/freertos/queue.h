@@ -0,0 +1,23 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// Warteschlangen für env:native. Elemente haben eine feste Größe und
+// werden wie bei FreeRTOS hinein- und herauskopiert. Wartezeiten zählen
+// in Ticks virtueller Zeit (portMAX_DELAY = ohne Grenze).
+typedef struct QueueDefinition* QueueHandle_t;
+
+#define errQUEUE_EMPTY  0
+#define errQUEUE_FULL   0
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueReset(QueueHandle_t queue);
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait);
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticksToWait);
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item);   // nur für Länge 1
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait);
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue);
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// Tasks laufen auf dem Host als std::thread. Core und Priorität werden
+// nur gemerkt, der Host-Scheduler entscheidet selbst.
+typedef struct tskTaskControlBlock* TaskHandle_t;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name,
+                                   uint32_t stackDepth, void* parameters,
+                                   UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core);
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name,
+                       uint32_t stackDepth, void* parameters,
+                       UBaseType_t priority, TaskHandle_t* handle);
+void vTaskDelete(TaskHandle_t task);
+
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t increment);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xPortGetCoreID();
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+
+// Aus Interrupt-Routinen; *higherPriorityTaskWoken bleibt pdFALSE, der
+// Host-Scheduler weckt die Task ohnehin sofort
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken);
+#define portYIELD_FROM_ISR(...)
@@ -0,0 +1,135 @@
+#ifndef PIXEL_SNAPSHOT_H
+#define PIXEL_SNAPSHOT_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <type_traits>
+
+/**
+ * @file Snapshot.h
+ * @brief Ein Datensatz, den ein Task veröffentlicht und andere lesen,
+ *        ohne Lock und ohne halb geschriebene Werte (Seqlock).
+ *
+ * Der Schreiber macht die Sequenznummer vor dem Kopieren ungerade und
+ * danach wieder gerade. Ein Leser kopiert den Datensatz und prüft, ob
+ * die Nummer gerade war und sich dabei nicht geändert hat; sonst liest
+ * er noch einmal. Der Schreiber wartet also nie, ein Leser höchstens so
+ * lange, wie das Kopieren eines Datensatzes dauert.
+ *
+ * Die Daten liegen als atomare 32-Bit-Wörter vor, damit der gleichzeitige
+ * Zugriff auch nach dem C++-Speichermodell erlaubt ist. Auf dem ESP32
+ * sind das gewöhnliche Lade- und Speicherbefehle.
+ *
+ * Einschränkungen:
+ *  - pro Snapshot nur ein Schreiber zur selben Zeit
+ *  - T muss trivial kopierbar sein (keine String-Felder)
+ *
+ * Beispiel:
+ *   Snapshot<WeatherReading> weatherReading;
+ *   weatherReading.publish(reading);            // Abruf-Task
+ *
+ *   SnapshotReader<WeatherReading> reader(weatherReading);
+ *   if (reader.poll(reading)) neuZeichnen();    // Anzeige-Task
+ */
+
+template<typename T>
+class Snapshot {
+  static_assert(std::is_trivially_copyable<T>::value, "Snapshot<T> braucht einen trivial kopierbaren Typ");
+
+private:
+  static const uint16_t WORDS = (sizeof(T) + 3) / 4;
+
+  std::atomic<uint32_t> sequence;   // ungerade = Schreiber kopiert gerade
+  std::atomic<uint32_t> words[WORDS];
+
+public:
+  Snapshot() : sequence(0) {
+    for (uint16_t i = 0; i < WORDS; i++) {
+      words[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  Snapshot(const Snapshot&) = delete;
+  Snapshot& operator=(const Snapshot&) = delete;
+
+  /**
+   * @brief Neuen Datensatz veröffentlichen, blockiert nie.
+   */
+  void publish(const T& value) {
+    uint32_t buffer[WORDS] = {};
+    memcpy(buffer, &value, sizeof(T));
+
+    uint32_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (uint16_t i = 0; i < WORDS; i++) {
+      words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    sequence.store(start + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief Letzten vollständigen Datensatz kopieren.
+   * @return Version des Datensatzes, 0 = noch nie veröffentlicht
+   *         (out ist dann mit Nullbytes gefüllt)
+   */
+  uint32_t read(T& out) const {
+    uint32_t buffer[WORDS];
+    uint32_t before, after;
+
+    do {
+      before = sequence.load(std::memory_order_acquire);
+      for (uint16_t i = 0; i < WORDS; i++) {
+        buffer[i] = words[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    memcpy(&out, buffer, sizeof(T));
+    return before / 2;
+  }
+
+  T read() const {
+    T value;
+    read(value);
+    return value;
+  }
+
+  // Anzahl der Veröffentlichungen, ohne die Daten zu kopieren
+  uint32_t version() const {
+    return sequence.load(std::memory_order_acquire) / 2;
+  }
+};
+
+/**
+ * @brief Merkt sich die zuletzt gelesene Version eines Snapshots, damit
+ *        ein Renderer unveränderte Daten überspringen kann.
+ */
+template<typename T>
+class SnapshotReader {
+private:
+  const Snapshot<T>& source;
+  uint32_t seen;
+
+public:
+  explicit SnapshotReader(const Snapshot<T>& source) : source(source), seen(0) {}
+
+  // Nur ein Vergleich der Versionsnummer, kopiert nichts
+  bool changed() const { return source.version() != seen; }
+
+  /**
+   * @brief Kopiert den Datensatz, wenn es seit dem letzten Aufruf eine
+   *        neue Version gibt.
+   * @return true, wenn out neu beschrieben wurde
+   */
+  bool poll(T& out) {
+    if (!changed()) return false;
+    seen = source.read(out);
+    return true;
+  }
+
+  uint32_t lastVersion() const { return seen; }
+};
+
+#endif // PIXEL_SNAPSHOT_H
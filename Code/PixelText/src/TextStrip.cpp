@@ -0,0 +1,199 @@
+/**
+ * @file TextStrip.cpp
+ * @brief Vorgerasterte Laufschrift, siehe TextStrip.h.
+ */
+
+#include "TextStrip.h"
+
+TextStrip::TextStrip()
+    : glyphs(nullptr), fontWidth(0), fontHeight(0), scale(TEXT_STRIP_SCALE_1X), stripHeight(0),
+      firstChar(0), lastChar(0),
+      viewWidth(0), viewMask{0, 0}, totalColumns(0), position(0), speed(0), speedCarry(0),
+      lastUpdateMs(0), started(false), runCount(0) {
+  memset(rows, 0, sizeof(rows));
+}
+
+void TextStrip::init(const uint8_t* fontData, uint16_t width, uint8_t fontScale) {
+  const uint8_t maxFontRows = fontScale == TEXT_STRIP_SCALE_1X ? TEXT_STRIP_MAX_ROWS : TEXT_STRIP_MAX_ROWS / 2;
+  fontWidth   = fontData[0] < 32 ? fontData[0] : 32;   // eine Glyphzeile = ein Wort
+  fontHeight  = fontData[1] < maxFontRows ? fontData[1] : maxFontRows;
+  scale       = fontScale;
+  stripHeight = scale == TEXT_STRIP_SCALE_1X ? fontHeight : 2 * fontHeight;
+  firstChar   = fontData[2];
+  lastChar    = fontData[3];
+  glyphs      = fontData + 4;
+  viewWidth   = width < TEXT_STRIP_MAX_VIEW ? width : TEXT_STRIP_MAX_VIEW;
+
+  // Spalten rechts vom Canvas ausblenden
+  viewMask[0] = viewWidth >= 32 ? 0xFFFFFFFFu : ~(0xFFFFFFFFu >> viewWidth);
+  viewMask[1] = viewWidth >= 64 ? 0xFFFFFFFFu
+              : viewWidth <= 32 ? 0 : ~(0xFFFFFFFFu >> (viewWidth - 32));
+  setText("", 0, CRGB::Black);
+}
+
+void TextStrip::setSpeed(uint32_t pixelsPerSecond) {
+  speed = pixelsPerSecond;
+  speedCarry = 0;
+}
+
+// bits (Bit 31 = erste Spalte) ab column in die Zeile odern
+void TextStrip::orBits(uint8_t row, uint16_t column, uint32_t bits) {
+  uint32_t* words = rows[row] + (column >> 5);
+  const uint8_t shift = column & 31;
+  words[0] |= bits >> shift;
+  if (shift != 0) words[1] |= bits << (32 - shift);
+}
+
+void TextStrip::rasterGlyph(const uint8_t* glyph, uint16_t column) {
+  const uint8_t bytesPerRow = (fontWidth + 7) / 8;
+
+  // Glyphzeilen als Wörter, Bit 31 = linke Spalte
+  uint32_t line[TEXT_STRIP_MAX_ROWS];
+  for (uint8_t row = 0; row < fontHeight; row++) {
+    uint32_t bits = 0;
+    for (uint8_t b = 0; b < bytesPerRow; b++) {
+      bits |= (uint32_t)glyph[row * bytesPerRow + b] << (24 - 8 * b);
+    }
+    line[row] = fontWidth < 32 ? bits & ~(0xFFFFFFFFu >> fontWidth) : bits;
+  }
+
+  if (scale == TEXT_STRIP_SCALE_1X) {
+    for (uint8_t row = 0; row < fontHeight; row++) orBits(row, column, line[row]);
+    return;
+  }
+
+  for (uint8_t row = 0; row < fontHeight; row++) {
+    const uint32_t pixel = line[row];
+    uint32_t upper = pixel;
+    uint32_t lower = pixel;
+
+    if (scale == TEXT_STRIP_SMOOTH_2X) {
+      // Leeres Pixel mit gesetztem Nachbarn darüber und genau einem
+      // seitlichen, dessen Ecke oben frei ist: dort läuft eine Diagonale,
+      // die obere Hälfte füllt die Stufe (unten gespiegelt). Innenecken
+      // von Strichen bleiben eckig, gesetzte Pixel immer gesetzt.
+      const uint32_t up    = row > 0 ? line[row - 1] : 0;
+      const uint32_t down  = row + 1 < fontHeight ? line[row + 1] : 0;
+      const uint32_t left  = pixel >> 1;
+      const uint32_t right = pixel << 1;
+      upper |= up & ~down & ((left & ~(up >> 1) & ~right) | (right & ~(up << 1) & ~left));
+      lower |= down & ~up & ((left & ~(down >> 1) & ~right) | (right & ~(down << 1) & ~left));
+    }
+
+    orBits(2 * row, column, upper);
+    orBits(2 * row + 1, column, lower);
+  }
+}
+
+bool TextStrip::setText(const char* text, size_t length, CRGB color) {
+  memset(rows, 0, sizeof(rows));
+  position = 0;
+
+  const uint16_t pitch = fontWidth + TEXT_STRIP_CHAR_GAP;
+  const uint16_t glyphBytes = (uint16_t)fontHeight * ((fontWidth + 7) / 8);
+  const size_t maxChars = TEXT_STRIP_MAX_COLUMNS / pitch;
+  const bool fits = length <= maxChars;
+  if (!fits) length = maxChars;
+
+  // Leere Bildbreite davor, der Text läuft von rechts herein
+  uint16_t column = viewWidth;
+  for (size_t i = 0; i < length; i++, column += pitch) {
+    uint8_t c = (uint8_t)text[i];
+    if (c < firstChar || c > lastChar) continue;   // wie ein Leerzeichen
+
+    rasterGlyph(glyphs + (uint16_t)(c - firstChar) * glyphBytes, column);
+  }
+  totalColumns = column;
+
+  runs[0].startColumn = 0;
+  runs[0].color = color;
+  runCount = 1;
+  return fits;
+}
+
+bool TextStrip::setColorFrom(size_t charIndex, CRGB color) {
+  if (runCount >= TEXT_STRIP_MAX_RUNS) return false;
+  uint32_t column = viewWidth + charIndex * (fontWidth + TEXT_STRIP_CHAR_GAP);
+  if (column >= totalColumns || column < runs[runCount - 1].startColumn) return false;
+
+  if (column == runs[runCount - 1].startColumn) {
+    runs[runCount - 1].color = color;
+  } else {
+    runs[runCount].startColumn = column;
+    runs[runCount].color = color;
+    runCount++;
+  }
+  return true;
+}
+
+int TextStrip::update(uint32_t nowMs) {
+  if (!started) {
+    started = true;
+    lastUpdateMs = nowMs;
+    return 0;
+  }
+
+  uint32_t elapsed = nowMs - lastUpdateMs;
+  lastUpdateMs = nowMs;
+  if (elapsed > TEXT_STRIP_MAX_STEP_MS) elapsed = TEXT_STRIP_MAX_STEP_MS;
+
+  const uint32_t distance = speed * elapsed + speedCarry;
+  position += distance / 1000;
+  speedCarry = distance % 1000;
+
+  // Fertig, wenn das Fenster hinter dem Text nur noch leer ist
+  if (position >= ((uint32_t)totalColumns << 8)) {
+    position = 0;
+    return -1;
+  }
+  return 0;
+}
+
+// 64 Spalten ab column als zwei Wörter, links bündig
+void TextStrip::window(uint8_t row, uint16_t column, uint32_t& left, uint32_t& right) const {
+  const uint32_t* words = rows[row] + (column >> 5);
+  const uint8_t shift = column & 31;
+  if (shift == 0) {
+    left = words[0];
+    right = words[1];
+  } else {
+    left  = (words[0] << shift) | (words[1] >> (32 - shift));
+    right = (words[1] << shift) | (words[2] >> (32 - shift));
+  }
+}
+
+// Ziele für drawTo()
+struct CanvasTarget {
+  CRGB* canvas;
+  uint16_t stride;
+  CRGB* out;
+  void row(uint8_t y) { out = canvas + y * stride; }
+  void put(uint8_t x, const CRGB& color) { out[x] = color; }
+};
+
+struct MapTarget {
+  CRGB* leds;
+  const uint16_t* map;
+  uint16_t width;
+  const uint16_t* rowMap;
+  void row(uint8_t y) { rowMap = map + y * width; }
+  void put(uint8_t x, const CRGB& color) {
+    if (rowMap[x] != TEXT_STRIP_NO_PIXEL) leds[rowMap[x]] = color;
+  }
+};
+
+void TextStrip::render(CRGB* canvas) const {
+  // Erst alles schwarz, dann nur die gesetzten Bits (Text ist dünn besetzt)
+  fill_solid(canvas, viewWidth * stripHeight, CRGB::Black);
+  draw(canvas, viewWidth);
+}
+
+void TextStrip::draw(CRGB* canvas, uint16_t stride) const {
+  CanvasTarget target = { canvas, stride, canvas };
+  drawTo(target);
+}
+
+void TextStrip::draw(CRGB* leds, const uint16_t* map) const {
+  MapTarget target = { leds, map, viewWidth, map };
+  drawTo(target);
+}
@@ -0,0 +1,223 @@
+#ifndef TEXT_STRIP_H
+#define TEXT_STRIP_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+/**
+ * @file TextStrip.h
+ * @brief Laufschrift aus einem vorgerasterten 1-Bit-Streifen.
+ *
+ * setText() rastert die ganze Nachricht einmal mit dem Font (LEDText-
+ * Format, z. B. MatriseFontData) in einen Bitstreifen: pro Fontzeile eine
+ * Reihe 32-Bit-Wörter, Bit 31 von Wort 0 ist die linke Spalte. Vor dem
+ * Text liegt eine leere Bildbreite, damit er wie bei LEDText von rechts
+ * hereinläuft. Die Farben stehen getrennt als Läufe (ab Spalte x Farbe c).
+ *
+ * Pro Frame holt render() für jede Zeile das sichtbare Fenster mit zwei
+ * verschobenen Wortkopien heraus und schreibt es in den Canvas; Glyphen
+ * werden dabei nicht mehr angefasst. draw() schreibt nur die gesetzten
+ * Pixel, wahlweise über eine Tabelle direkt in den LED-Puffer der Panels.
+ *
+ * Für 16 Zeilen hohe Anzeigen rastert setText() jede Fontzeile doppelt
+ * (TEXT_STRIP_SCALE_2X). TEXT_STRIP_SMOOTH_2X füllt dabei an Diagonalen
+ * die halbe Stufe auf, aus dem 8-px-Font wird ein geglätteter 16-px-Font,
+ * ohne dass ein zweiter Font im Flash liegen muss.
+ *
+ * Die Geschwindigkeit ist in Pixel pro Sekunde (Festkomma, 1/256 px) und
+ * hängt nicht von der Frame-Rate ab: update() rückt um die seit dem
+ * letzten Aufruf vergangene Zeit vor. Steht die Position zwischen zwei
+ * Spalten, mischt render() beide anteilig, die Schrift gleitet also auch
+ * bei wenigen Frames pro Sekunde ruhig.
+ *
+ * Beispiel:
+ *   scrollingText.init(MatriseFontData, canvasWidth8);
+ *   scrollingText.setSpeed(TEXT_STRIP_SPEED(12));   // 12 px/s
+ *   scrollingText.setText(laufTextBuffer, laufTextLen, CRGB(255, 0, 255));
+ *   ...
+ *   scrollingText.update(millis());     // pro Frame
+ *   scrollingText.render(canvas8Leds);  // 64x8, HORIZONTAL_MATRIX
+ *
+ *   scrollingText.init(MatriseFontData, panelWidth, TEXT_STRIP_SMOOTH_2X);
+ *   scrollingText.draw(panelLeds, textZiel);   // 16 Zeilen, über Tabelle
+ */
+
+#define TEXT_STRIP_MAX_ROWS     16     // nach dem Skalieren
+#define TEXT_STRIP_MAX_VIEW     64     // sichtbare Breite, zwei Wörter pro Zeile
+#define TEXT_STRIP_MAX_COLUMNS  1152   // Textspalten: 160 Zeichen bei 7 Spalten
+#define TEXT_STRIP_MAX_RUNS     8
+#define TEXT_STRIP_CHAR_GAP     1      // leere Spalten nach jedem Zeichen
+
+#define TEXT_STRIP_MAX_STEP_MS 250    // längere Pausen zählen nur so viel
+
+// Fontzeilen im Streifen, siehe init()
+#define TEXT_STRIP_SCALE_1X    0
+#define TEXT_STRIP_SCALE_2X    1      // jede Zeile doppelt
+#define TEXT_STRIP_SMOOTH_2X   2      // doppelt, Diagonalen geglättet
+
+// Tabelleneintrag für draw(): dieses Pixel nicht zeichnen
+#define TEXT_STRIP_NO_PIXEL    0xFFFF
+
+// Pixel pro Sekunde → Festkomma für setSpeed(), z. B. TEXT_STRIP_SPEED(7.5)
+#define TEXT_STRIP_SPEED(pxPerSec)  ((uint32_t)((pxPerSec) * 256 + 0.5))
+
+// Leere Bildbreite davor, Text, zwei Wörter Reserve für das Fenster dahinter
+#define TEXT_STRIP_WORDS  ((TEXT_STRIP_MAX_VIEW + TEXT_STRIP_MAX_COLUMNS) / 32 + 3)
+
+class TextStrip {
+private:
+  struct ColorRun {
+    uint16_t startColumn;   // Spalte im Streifen, nicht im Text
+    CRGB color;
+  };
+
+  const uint8_t* glyphs;
+  uint8_t fontWidth;
+  uint8_t fontHeight;        // Zeilen im Font
+  uint8_t scale;
+  uint8_t stripHeight;       // Zeilen im Streifen
+  uint8_t firstChar;
+  uint8_t lastChar;
+
+  uint16_t viewWidth;
+  uint32_t viewMask[2];      // sichtbare Bits im Fenster
+  uint16_t totalColumns;     // leere Bildbreite + Text
+  uint32_t position;         // linke sichtbare Spalte im Streifen, in 1/256 px
+  uint32_t speed;            // px/s in 1/256 px
+  uint16_t speedCarry;       // Rest aus speed * ms / 1000, damit nichts verloren geht
+  uint32_t lastUpdateMs;
+  bool started;
+
+  uint32_t rows[TEXT_STRIP_MAX_ROWS][TEXT_STRIP_WORDS];
+  ColorRun runs[TEXT_STRIP_MAX_RUNS];
+  uint8_t runCount;
+
+  void orBits(uint8_t row, uint16_t column, uint32_t bits);
+  void rasterGlyph(const uint8_t* glyph, uint16_t column);
+  void window(uint8_t row, uint16_t column, uint32_t& left, uint32_t& right) const;
+
+public:
+  TextStrip();
+
+  /**
+   * @param fontData   Font im LEDText-Format: Breite, Höhe, erstes und
+   *                   letztes Zeichen, dann pro Zeichen eine Bytezeile je
+   *                   Fontzeile (MSB = linke Spalte)
+   * @param viewWidth  Breite des Canvas, höchstens TEXT_STRIP_MAX_VIEW
+   * @param scale      TEXT_STRIP_SCALE_1X, TEXT_STRIP_SCALE_2X oder
+   *                   TEXT_STRIP_SMOOTH_2X (Fonthöhe dann höchstens 8)
+   */
+  void init(const uint8_t* fontData, uint16_t viewWidth, uint8_t scale = TEXT_STRIP_SCALE_1X);
+
+  /**
+   * @param speed  px/s in 1/256 px, am einfachsten über TEXT_STRIP_SPEED()
+   */
+  void setSpeed(uint32_t speed);
+
+  /**
+   * @brief Rastert den Text neu und beginnt den Durchlauf von vorne.
+   * @return false, wenn der Text gekürzt werden musste
+   */
+  bool setText(const char* text, size_t length, CRGB color);
+
+  /**
+   * @brief Ab Zeichen charIndex (bis zum nächsten Lauf) in color zeichnen.
+   *        Nach setText() aufrufen, Läufe aufsteigend.
+   */
+  bool setColorFrom(size_t charIndex, CRGB color);
+
+  /**
+   * @brief Um die seit dem letzten Aufruf vergangene Zeit weiterrücken
+   *        (höchstens TEXT_STRIP_MAX_STEP_MS). Wie cLEDText::UpdateText()
+   *        gibt es -1 zurück, wenn der Text ganz hinausgelaufen ist; der
+   *        Streifen beginnt dann selbst wieder von vorne.
+   */
+  int update(uint32_t nowMs);
+
+  /**
+   * @brief Sichtbares Fenster in den Canvas schreiben (viewWidth x
+   *        Fonthöhe, zeilenweise). Nicht gesetzte Pixel werden schwarz,
+   *        zwischen zwei Spalten wird anteilig gemischt.
+   */
+  void render(CRGB* canvas) const;
+
+  /**
+   * @brief Wie render(), schreibt aber nur gesetzte Pixel; der Rest des
+   *        Ziels bleibt, wie er ist.
+   * @param stride  Pixel pro Zeile im Ziel, z. B. Breite des Displays
+   */
+  void draw(CRGB* canvas, uint16_t stride) const;
+
+  /**
+   * @brief Gesetzte Pixel über eine Tabelle schreiben: Pixel (x, Zeile)
+   *        landet in leds[map[Zeile * viewWidth + x]], Einträge mit
+   *        TEXT_STRIP_NO_PIXEL werden übersprungen. So gehen Spiegelung,
+   *        Drehung und Zickzack der Panels ohne Zwischen-Canvas.
+   */
+  void draw(CRGB* leds, const uint16_t* map) const;
+
+  /**
+   * @brief Gesetzte Pixel an ein eigenes Ziel geben, z. B. einen Canvas
+   *        mit Palette. Target braucht row(y), vor jeder Zeile aufgerufen,
+   *        und put(x, color) für jedes gesetzte Pixel dieser Zeile.
+   */
+  template<typename Target>
+  void drawTo(Target& target) const;
+
+  uint16_t columns() const { return totalColumns; }
+  uint8_t height() const { return stripHeight; }
+  uint32_t scrollPosition() const { return position; }   // in 1/256 px
+};
+
+// Template, deshalb hier und nicht in TextStrip.cpp
+template<typename Target>
+void TextStrip::drawTo(Target& target) const {
+  const uint16_t column = position >> 8;
+  const uint8_t fraction = position & 0xFF;   // Anteil der rechten Nachbarspalte
+
+  // Drei Helligkeiten je Farblauf: voll, nur linke Spalte gesetzt
+  // (verblasst), nur rechte gesetzt (taucht auf)
+  CRGB full[TEXT_STRIP_MAX_RUNS];
+  CRGB fading[TEXT_STRIP_MAX_RUNS];
+  CRGB rising[TEXT_STRIP_MAX_RUNS];
+  for (uint8_t run = 0; run < runCount; run++) {
+    full[run] = runs[run].color;
+    fading[run] = CRGB(runs[run].color).nscale8(fraction ? 255 - fraction : 255);
+    rising[run] = CRGB(runs[run].color).nscale8(fraction);
+  }
+
+  // Farblauf pro sichtbarer Spalte, gilt für alle Zeilen
+  uint8_t runOf[TEXT_STRIP_MAX_VIEW];
+  uint8_t run = 0;
+  for (uint16_t x = 0; x < viewWidth; x++) {
+    while (run + 1 < runCount && runs[run + 1].startColumn <= column + x) run++;
+    runOf[x] = run;
+  }
+
+  for (uint8_t row = 0; row < stripHeight; row++) {
+    uint32_t left[2];
+    uint32_t right[2] = { 0, 0 };
+    window(row, column, left[0], left[1]);
+    if (fraction != 0) window(row, column + 1, right[0], right[1]);
+
+    target.row(row);
+    for (uint8_t half = 0; half < 2; half++) {
+      const uint32_t a = left[half] & viewMask[half];
+      const uint32_t b = right[half] & viewMask[half];
+      const uint8_t base = half * 32;
+
+      uint32_t word = a | b;
+      while (word != 0) {
+        const uint8_t bit = __builtin_clz(word);
+        const uint32_t mask = 0x80000000u >> bit;
+        const uint8_t x = base + bit;
+        if (!(b & mask))      target.put(x, fading[runOf[x]]);
+        else if (!(a & mask)) target.put(x, rising[runOf[x]]);
+        else                  target.put(x, full[runOf[x]]);
+        word &= ~mask;
+      }
+    }
+  }
+}
+
+#endif // TEXT_STRIP_H
@@ -0,0 +1,100 @@
+/**
+ * @file TextWriter.cpp
+ * @brief Zahlen- und Textformatierung ohne Heap, siehe TextWriter.h.
+ */
+
+#include "TextWriter.h"
+
+static const uint32_t powersOfTen[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+#define MAX_DECIMALS  6
+
+TextWriter::TextWriter(char* storage, uint16_t capacity)
+    : data(storage), capacity(capacity), length(0), truncated(false) {
+  if (capacity > 0) data[0] = '\0';
+}
+
+void TextWriter::clear() {
+  length = 0;
+  truncated = false;
+  if (capacity > 0) data[0] = '\0';
+}
+
+TextWriter& TextWriter::append(char c) {
+  if (length + 1 >= capacity) {
+    truncated = true;
+    return *this;
+  }
+  data[length++] = c;
+  data[length] = '\0';
+  return *this;
+}
+
+TextWriter& TextWriter::append(const char* text) {
+  if (text == nullptr) return *this;
+  while (*text) {
+    if (length + 1 >= capacity) {
+      truncated = true;
+      break;
+    }
+    data[length++] = *text++;
+  }
+  if (capacity > 0) data[length] = '\0';
+  return *this;
+}
+
+TextWriter& TextWriter::appendUint(uint32_t value, uint8_t minWidth, char pad) {
+  char digits[10];   // 4294967295
+  uint8_t count = 0;
+  do {
+    digits[count++] = '0' + value % 10;
+    value /= 10;
+  } while (value > 0);
+
+  for (uint8_t i = count; i < minWidth; i++) append(pad);
+  while (count > 0) append(digits[--count]);
+  return *this;
+}
+
+TextWriter& TextWriter::appendInt(int32_t value, uint8_t minWidth, char pad) {
+  if (value >= 0) return appendUint(value, minWidth, pad);
+
+  // Betrag ohne Überlauf bei INT32_MIN
+  uint32_t magnitude = 0u - (uint32_t)value;
+  if (pad == '0') {
+    append('-');
+    return appendUint(magnitude, minWidth > 0 ? minWidth - 1 : 0, pad);
+  }
+
+  uint8_t digits = 1;
+  for (uint32_t rest = magnitude / 10; rest > 0; rest /= 10) digits++;
+  for (uint8_t i = digits + 1; i < minWidth; i++) append(pad);
+  append('-');
+  return appendUint(magnitude);
+}
+
+TextWriter& TextWriter::appendFixed(int32_t scaled, uint8_t decimals) {
+  if (decimals > MAX_DECIMALS) decimals = MAX_DECIMALS;
+  uint32_t magnitude = scaled < 0 ? 0u - (uint32_t)scaled : (uint32_t)scaled;
+  uint32_t divisor = powersOfTen[decimals];
+
+  if (scaled < 0) append('-');
+  appendUint(magnitude / divisor);
+  if (decimals > 0) {
+    append('.');
+    appendUint(magnitude % divisor, decimals, '0');
+  }
+  return *this;
+}
+
+TextWriter& TextWriter::appendFloat(float value, uint8_t decimals) {
+  if (value != value) return append("nan");
+  if (decimals > MAX_DECIMALS) decimals = MAX_DECIMALS;
+
+  float scaled = value * powersOfTen[decimals];
+  if (scaled >= 2147483520.0f) return append("inf");
+  if (scaled <= -2147483520.0f) return append("-inf");
+
+  // Kaufmännisch runden, weg von der Null
+  int32_t rounded = (int32_t)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+  return appendFixed(rounded, decimals);
+}
@@ -0,0 +1,71 @@
+#ifndef TEXT_WRITER_H
+#define TEXT_WRITER_H
+
+#include <Arduino.h>
+
+/**
+ * @file TextWriter.h
+ * @brief Texte in einen festen Puffer schreiben, ohne Heap.
+ *
+ * TextWriter schreibt in fremden Speicher, z. B. direkt in den Puffer der
+ * Laufschrift; TextBuffer<N> bringt seinen Speicher selbst mit (Stack).
+ * Zahlen werden ganzzahlig bzw. als Festkomma formatiert, printf mit %f
+ * (und damit die Float-Routinen der newlib) wird nicht gebraucht.
+ *
+ * Was nicht mehr passt, wird abgeschnitten; der Text bleibt immer
+ * nullterminiert und overflowed() meldet das Kürzen.
+ *
+ * Beispiel:
+ *   TextWriter text(laufTextBuffer, sizeof(laufTextBuffer));
+ *   text.append("   INNSBRUCK ").appendFloat(temp, 1).append("C   ");
+ */
+
+class TextWriter {
+private:
+  char* data;
+  uint16_t capacity;       // inkl. Nullbyte
+  uint16_t length;
+  bool truncated;
+
+public:
+  TextWriter(char* storage, uint16_t capacity);
+
+  void clear();
+
+  TextWriter& append(char c);
+  TextWriter& append(const char* text);
+
+  /**
+   * @param minWidth  mit pad links auffüllen, z. B. (7, 2, '0') → "07"
+   */
+  TextWriter& appendUint(uint32_t value, uint8_t minWidth = 0, char pad = ' ');
+  TextWriter& appendInt(int32_t value, uint8_t minWidth = 0, char pad = ' ');
+
+  /**
+   * @brief Festkommazahl: scaled in 1/10^decimals, (-125, 1) → "-12.5"
+   */
+  TextWriter& appendFixed(int32_t scaled, uint8_t decimals);
+
+  /**
+   * @brief Auf decimals Stellen gerundet (höchstens 6), über appendFixed().
+   *        -0.04 mit einer Stelle wird "0.0", nicht "-0.0".
+   */
+  TextWriter& appendFloat(float value, uint8_t decimals);
+
+  const char* c_str() const { return data; }
+  uint16_t size() const { return length; }
+  bool overflowed() const { return truncated; }
+};
+
+template<uint16_t N>
+class TextBuffer : public TextWriter {
+private:
+  char storage[N];
+
+public:
+  TextBuffer() : TextWriter(storage, N) {}
+  TextBuffer(const TextBuffer&) = delete;
+  TextBuffer& operator=(const TextBuffer&) = delete;
+};
+
+#endif // TEXT_WRITER_H
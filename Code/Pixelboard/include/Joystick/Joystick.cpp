@@ -21,6 +21,7 @@ void Joystick::update() {
   Button::update();  // Call parent class update for button handling
   xValue = analogRead(xPin);
   yValue = analogRead(yPin);
+  filter.update(xValue, yValue);
 }
 
 // Get raw X axis value (0-4095)
@@ -33,13 +34,32 @@ int Joystick::getYValue() {
   return yValue;
 }
 
-// Get normalized X axis value (0.0-1.0)
+// Get normalized X axis value (0.0-1.0); multiply, the reciprocal is a constant
 float Joystick::getXNormalized() {
-  return (float)xValue / (RESOLUTION - 1);
+  return xValue * (1.0f / (RESOLUTION - 1));
 }
 
 // Get normalized Y axis value (0.0-1.0)
 float Joystick::getYNormalized() {
-  return (float)yValue / (RESOLUTION - 1);
+  return yValue * (1.0f / (RESOLUTION - 1));
+}
+
+// X relative to the centre learned at boot (tracks drift while at rest)
+int Joystick::getXOffset() const {
+  return filter.getUp();
+}
+
+// Y relative to the learned centre
+int Joystick::getYOffset() const {
+  return filter.getRight();
+}
+
+// Direction with radial dead zone and hysteresis, see JoystickFilter.h
+InputDirection Joystick::getDirection() const {
+  return filter.getDirection();
+}
+
+void Joystick::setWays(uint8_t ways) {
+  filter.setWays(ways);
 }
 
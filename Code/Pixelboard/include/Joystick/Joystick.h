@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include <JoystickFilter.h>
 #include "Button.h"
 
 class Joystick : public Button {
@@ -9,6 +10,7 @@ private:
   const int yPin;
   int xValue;
   int yValue;
+  JoystickFilter filter;              // learned centre, dead zone, directions
   static const int RESOLUTION = 4096; // 12-bit resolution (2^12)
 
 public:
@@ -21,4 +23,12 @@ public:
   int getYValue();
   float getXNormalized();
   float getYNormalized();
+
+  // Relative to the learned centre, in ADC steps
+  int getXOffset() const;
+  int getYOffset() const;
+
+  // Direction after dead zone and hysteresis (X+ = up, Y+ = right)
+  InputDirection getDirection() const;
+  void setWays(uint8_t ways);   // 4 (default) or 8 directions
 };
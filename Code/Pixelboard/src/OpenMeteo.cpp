@@ -0,0 +1,26 @@
+#include "OpenMeteo.h"
+#include <PixelLog.h>
+
+// Nur diese Felder landen im Dokument. Einmal aufgebaut, damit kein Abruf
+// den Filter neu allokiert.
+static const JsonDocument& weatherFilter() {
+  static JsonDocument filter;
+  if (filter.isNull()) {
+    filter["current_weather"]["temperature"] = true;
+    filter["current_weather"]["weathercode"] = true;
+  }
+  return filter;
+}
+
+bool parseCurrentWeather(Stream& body, JsonDocument& doc, float& temperature, int& weatherCode) {
+  DeserializationError err = deserializeJson(doc, body, DeserializationOption::Filter(weatherFilter()));
+  if (err) {
+    logLine("JSON Fehler: %s", err.c_str());
+    return false;
+  }
+
+  JsonObject current = doc["current_weather"];
+  temperature = current["temperature"] | 0.0f;
+  weatherCode = current["weathercode"] | -1;
+  return true;
+}
@@ -0,0 +1,19 @@
+#ifndef OPEN_METEO_H
+#define OPEN_METEO_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/**
+ * @brief Liest "current_weather" aus einer Open-Meteo-Antwort, direkt vom
+ *        Stream. Der Filter lässt nur Temperatur und Wettercode ins
+ *        Dokument, der Rest des Bodys wird beim Lesen verworfen.
+ *
+ * doc kommt vom Aufrufer, damit der Bench mit eigenem Allocator messen
+ * kann, wie viel Speicher das Dokument hält.
+ *
+ * @return false bei ungültigem JSON (geloggt)
+ */
+bool parseCurrentWeather(Stream& body, JsonDocument& doc, float& temperature, int& weatherCode);
+
+#endif // OPEN_METEO_H
@@ -0,0 +1,66 @@
+/**
+ * @file PanelBlit.cpp
+ * @brief Laufschrift (32x16) per Tabelle direkt auf zwei 8x32 Panels.
+ *
+ * Ersetzt die bisherige Kette aus fünf Durchläufen:
+ *   scaleVertTo16() → Canvas16 eine Zeile nach unten
+ *   → blitPanelsFromCanvas16() → mirrorPanelHorizontal() (beide Panels)
+ *   → rotatePanel180(panelTop)
+ *
+ * Zusammengefasst ergibt das pro Panel-Pixel (x, y):
+ *   - panelTop    (ledsBottom, Pin 26): canvas16(x,      15 - y)
+ *   - panelBottom (ledsTop,    Pin 25): canvas16(31 - x, y)
+ * mit canvas16(x, 0) = schwarz und canvas16(x, y) = Textzeile y - 1.
+ *
+ * Die Skalierung auf 16 Zeilen übernimmt inzwischen der TextStrip beim
+ * Rastern (geglätteter 16-px-Font), ein Canvas gibt es nicht mehr. Die
+ * Tabelle enthält für jedes Textpixel den LED-Index in panelLeds; die
+ * letzte Textzeile liegt wie früher unterhalb des Boards.
+ */
+
+#include "PanelBlit.h"
+#include "SharedLEDConfig.h"
+
+#define textRows  (2 * panelHeight)
+
+// Zeile * panelWidth + x → LED in panelLeds
+// [0 .. ledsPerPanel)               → ledsTop    (Pin 25, physisch unten)
+// [ledsPerPanel .. 2*ledsPerPanel)  → ledsBottom (Pin 26, physisch oben)
+static uint16_t textZiel[panelWidth * textRows];
+
+// VERTICAL_ZIGZAG_MATRIX: gerade Spalten abwärts, ungerade aufwärts
+static uint16_t panelIndex(uint8_t x, uint8_t y) {
+  if (x & 1) {
+    return (x + 1) * panelHeight - 1 - y;
+  }
+  return x * panelHeight + y;
+}
+
+// Pixel im 64x16-Canvas von früher (nach Verschiebung) → Textpixel
+static void zielSetzen(uint8_t x, uint8_t y16, uint16_t led) {
+  if (y16 == 0) return;   // freie oberste Zeile, bleibt schwarz
+  textZiel[(y16 - 1) * panelWidth + x] = led;
+}
+
+void initPanelBlit() {
+  for (uint16_t i = 0; i < panelWidth * textRows; i++) {
+    textZiel[i] = TEXT_STRIP_NO_PIXEL;
+  }
+
+  for (uint8_t y = 0; y < panelHeight; y++) {
+    for (uint8_t x = 0; x < panelWidth; x++) {
+      const uint16_t led = panelIndex(x, y);
+
+      // panelBottom: logisch oben, an der y-Achse gespiegelt
+      zielSetzen(panelWidth - 1 - x, y, led);
+
+      // panelTop: logisch unten, gespiegelt + 180° gedreht
+      zielSetzen(x, textRows - 1 - y, ledsPerPanel + led);
+    }
+  }
+}
+
+void drawTextToPanels(const TextStrip& text, CRGB* panelLeds) {
+  fill_solid(panelLeds, 2 * ledsPerPanel, CRGB::Black);
+  text.draw(panelLeds, textZiel);
+}
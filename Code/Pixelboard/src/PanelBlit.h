@@ -0,0 +1,27 @@
+#ifndef PANEL_BLIT_H
+#define PANEL_BLIT_H
+
+#include <FastLED.h>
+#include <TextStrip.h>
+
+/**
+ * @brief Baut die Tabelle Textpixel → LED für drawTextToPanels() auf.
+ *        Einmal in initAnzeige() aufrufen.
+ */
+void initPanelBlit();
+
+/**
+ * @brief Zeichnet das sichtbare Fenster der Laufschrift direkt in beide
+ *        Panels, ohne Zwischen-Canvas.
+ *
+ * Der Streifen ist panelWidth breit und 16 Zeilen hoch (TEXT_STRIP_SMOOTH_2X).
+ * Verschiebung um 1 Zeile, Spiegelung und 180°-Drehung stecken bereits in
+ * der Tabelle.
+ *
+ * @param text       Laufschrift, vorher update()
+ * @param panelLeds  ledsTop (Pin 25, physisch unten), direkt dahinter
+ *                   ledsBottom (Pin 26, physisch oben)
+ */
+void drawTextToPanels(const TextStrip& text, CRGB* panelLeds);
+
+#endif // PANEL_BLIT_H
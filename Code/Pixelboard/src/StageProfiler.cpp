@@ -0,0 +1,171 @@
+/**
+ * @file StageProfiler.cpp
+ * @brief Histogramme für die Render-Stufen, siehe StageProfiler.h.
+ *
+ * Die Buckets sind logarithmisch: pro Zweierpotenz vier Unterteilungen,
+ * also höchstens 25 % Abweichung beim p99. min, max und avg sind exakt.
+ * Keine Allokation, Aufzeichnung kostet ein paar Dutzend Takte.
+ */
+
+#include "StageProfiler.h"
+#include <PixelLog.h>
+
+#define BUCKETS_PER_OCTAVE  4
+#define BUCKET_COUNT        124   // Werte 0 .. 2^32-1
+#define REPORT_INTERVAL_MS  1000
+
+struct StageStats {
+  uint32_t count;
+  uint32_t minCycles;
+  uint32_t maxCycles;
+  uint64_t sumCycles;
+  uint32_t overruns;      // verlorene Frames, in denen diese Stufe die teuerste war
+  uint32_t buckets[BUCKET_COUNT];
+};
+
+static const char* const stageNames[STAGE_COUNT] = { "text", "blit", "show", "frame" };
+
+static StageStats stats[STAGE_COUNT];
+static uint32_t frameCycles[STAGE_COUNT];
+static uint32_t frameBudgetCycles = 0;
+static uint32_t droppedFrames = 0;
+
+// Letzter verlorener Frame, wird in profilerPoll() gemeldet
+static bool overrunPending = false;
+static uint32_t overrunFrameCycles = 0;
+static uint8_t overrunStage = 0;
+static uint32_t overrunStageCycles = 0;
+
+static uint32_t cpuMhz() {
+#if defined(ESP32)
+  return getCpuFrequencyMhz();
+#else
+  return PROFILER_HOST_MHZ;
+#endif
+}
+
+static float cyclesToUs(uint32_t cycles) {
+  return (float)cycles / cpuMhz();
+}
+
+static uint8_t bucketIndex(uint32_t cycles) {
+  if (cycles < BUCKETS_PER_OCTAVE) return cycles;
+  uint8_t msb = 31 - __builtin_clz(cycles);
+  uint8_t sub = (cycles >> (msb - 2)) & 0x03;
+  return (msb - 1) * BUCKETS_PER_OCTAVE + sub;
+}
+
+static uint32_t bucketUpperBound(uint8_t index) {
+  if (index < BUCKETS_PER_OCTAVE) return index;
+  uint8_t msb = index / BUCKETS_PER_OCTAVE + 1;
+  uint8_t sub = index % BUCKETS_PER_OCTAVE;
+  return (((uint64_t)(5 + sub)) << (msb - 2)) - 1;
+}
+
+static uint32_t percentile(const StageStats& s, uint8_t percent) {
+  if (s.count == 0) return 0;
+  uint32_t target = ((uint64_t)s.count * percent + 99) / 100;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < BUCKET_COUNT; i++) {
+    seen += s.buckets[i];
+    if (seen >= target) {
+      uint32_t bound = bucketUpperBound(i);
+      return bound > s.maxCycles ? s.maxCycles : bound;
+    }
+  }
+  return s.maxCycles;
+}
+
+// Frame ist zu Ende: Budget prüfen, teuerste Stufe festhalten
+static void closeFrame(uint32_t cycles) {
+  if (frameBudgetCycles > 0 && cycles > frameBudgetCycles) {
+    uint8_t worst = 0;
+    for (uint8_t i = 1; i < STAGE_FRAME; i++) {
+      if (frameCycles[i] > frameCycles[worst]) worst = i;
+    }
+    stats[worst].overruns++;
+    droppedFrames++;
+
+    overrunFrameCycles = cycles;
+    overrunStage = worst;
+    overrunStageCycles = frameCycles[worst];
+    overrunPending = true;
+  }
+
+  for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+    frameCycles[i] = 0;
+  }
+}
+
+void profilerInit(uint16_t frameBudgetMs) {
+  frameBudgetCycles = (uint32_t)frameBudgetMs * 1000 * cpuMhz();
+  profilerReset();
+}
+
+void profilerReset() {
+  memset(stats, 0, sizeof(stats));
+  for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+    stats[i].minCycles = UINT32_MAX;
+    frameCycles[i] = 0;
+  }
+  droppedFrames = 0;
+  overrunPending = false;
+}
+
+void profilerRecord(uint8_t stage, uint32_t cycles) {
+  if (stage >= STAGE_COUNT) return;
+
+  StageStats& s = stats[stage];
+  s.count++;
+  s.sumCycles += cycles;
+  if (cycles < s.minCycles) s.minCycles = cycles;
+  if (cycles > s.maxCycles) s.maxCycles = cycles;
+  s.buckets[bucketIndex(cycles)]++;
+
+  if (stage == STAGE_FRAME) {
+    closeFrame(cycles);
+  } else {
+    frameCycles[stage] += cycles;
+  }
+}
+
+void profilerDump() {
+  Serial.printf("\n%-6s %8s %9s %9s %9s %9s %9s\n",
+                "Stufe", "n", "min us", "avg us", "p99 us", "max us", "Verlust");
+  for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+    const StageStats& s = stats[i];
+    if (s.count == 0) {
+      Serial.printf("%-6s %8u\n", stageNames[i], 0u);
+      continue;
+    }
+    Serial.printf("%-6s %8u %9.1f %9.1f %9.1f %9.1f %9u\n",
+                  stageNames[i], s.count,
+                  cyclesToUs(s.minCycles),
+                  cyclesToUs((uint32_t)(s.sumCycles / s.count)),
+                  cyclesToUs(percentile(s, 99)),
+                  cyclesToUs(s.maxCycles),
+                  i == STAGE_FRAME ? droppedFrames : s.overruns);
+  }
+  Serial.printf("Budget %.1f us bei %u MHz\n",
+                cyclesToUs(frameBudgetCycles), cpuMhz());
+}
+
+void profilerPoll() {
+  while (Serial.available() > 0) {
+    int command = Serial.read();
+    if (command == 'p') profilerDump();
+    else if (command == 'r') profilerReset();
+  }
+
+  static uint32_t lastReportMs = 0;
+  const uint32_t now = millis();
+  if (!overrunPending || now - lastReportMs < REPORT_INTERVAL_MS) return;
+  lastReportMs = now;
+  overrunPending = false;
+
+  logLine("Frame verloren: %.1f us, davon %s %.1f us (%u seit Reset)",
+          cyclesToUs(overrunFrameCycles),
+          stageNames[overrunStage],
+          cyclesToUs(overrunStageCycles),
+          droppedFrames);
+}
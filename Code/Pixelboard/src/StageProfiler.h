@@ -0,0 +1,69 @@
+#ifndef STAGE_PROFILER_H
+#define STAGE_PROFILER_H
+
+#include <Arduino.h>
+
+/**
+ * @file StageProfiler.h
+ * @brief Taktgenaue Messung der Render-Stufen über das CCOUNT-Register.
+ *
+ * Jede Stufe bekommt ein Histogramm (min/avg/max/p99). Dauert ein Frame
+ * länger als das Frame-Intervall, wird die teuerste Stufe dieses Frames
+ * sofort gemeldet und ihr Überlauf-Zähler erhöht.
+ *
+ * Über Serial:  'p' → Tabelle ausgeben,  'r' → zurücksetzen.
+ */
+
+enum ProfilerStage : uint8_t {
+  STAGE_TEXT = 0,   // scrollingText.update()
+  STAGE_BLIT,       // drawTextToPanels()
+  STAGE_SHOW,       // FastLED.show()
+  STAGE_FRAME,      // ganzer Frame, schließt die Messung ab
+  STAGE_COUNT
+};
+
+// Außerhalb des ESP32 (env:native) wird aus micros() umgerechnet
+#define PROFILER_HOST_MHZ  240
+
+static inline uint32_t profilerCycles() {
+#if defined(__XTENSA__)
+  uint32_t ccount;
+  asm volatile("rsr %0, ccount" : "=a"(ccount));
+  return ccount;
+#else
+  return micros() * PROFILER_HOST_MHZ;
+#endif
+}
+
+/**
+ * @brief Setzt alle Histogramme zurück und merkt sich das Zeitbudget.
+ * @param frameBudgetMs  Frame-Intervall; längere Frames gelten als verloren
+ */
+void profilerInit(uint16_t frameBudgetMs);
+
+void profilerRecord(uint8_t stage, uint32_t cycles);
+void profilerReset();
+void profilerDump();
+
+/**
+ * @brief Statt debugAusgabe() in loop() aufrufen: wertet Serial-Befehle
+ *        aus und meldet verlorene Frames (höchstens einmal pro Sekunde).
+ */
+void profilerPoll();
+
+/**
+ * @brief Misst vom Konstruktor bis zum Ende des Blocks.
+ */
+class ProfilerScope {
+private:
+  uint8_t stage;
+  uint32_t start;
+
+public:
+  explicit ProfilerScope(uint8_t stage) : stage(stage), start(profilerCycles()) {}
+  ~ProfilerScope() { profilerRecord(stage, profilerCycles() - start); }
+};
+
+#define PROFILE_STAGE(stage) ProfilerScope profilerScope##stage(stage)
+
+#endif // STAGE_PROFILER_H
@@ -0,0 +1,20 @@
+#include "TickerText.h"
+
+// Stadtname statisch, weil Open-Meteo nur Koordinaten kennt
+void buildWeatherTicker(TextWriter& text, float temperature, const char* description) {
+  text.clear();
+  text.append("   INNSBRUCK ")
+      .appendFloat(temperature, 1)
+      .append("C ")
+      .append(description)
+      .append("   ");
+}
+
+void buildClockTicker(TextWriter& text, const struct tm& timeInfo) {
+  text.clear();
+  text.append("   ")
+      .appendUint(timeInfo.tm_hour, 2, '0')
+      .append(':')
+      .appendUint(timeInfo.tm_min, 2, '0')
+      .append("   ");
+}
@@ -0,0 +1,19 @@
+#ifndef TICKER_TEXT_H
+#define TICKER_TEXT_H
+
+#include <Arduino.h>
+#include <time.h>
+#include <TextWriter.h>
+
+/**
+ * @brief Wetter-Lauftext, z. B. "   INNSBRUCK 13.4C bedeckt   ".
+ *        Schreibt ab Anfang von text (vorher clear()), ohne Heap.
+ */
+void buildWeatherTicker(TextWriter& text, float temperature, const char* description);
+
+/**
+ * @brief Uhrzeit-Lauftext "   HH:MM   ".
+ */
+void buildClockTicker(TextWriter& text, const struct tm& timeInfo);
+
+#endif // TICKER_TEXT_H
@@ -1,9 +1,15 @@
 #include <Arduino.h>
 #include <WiFi.h>
-#include <HTTPClient.h>
 #include <ArduinoJson.h>
 
 #include "SharedLEDConfig.h"
+#include "PanelBlit.h"
+#include "StageProfiler.h"
+#include "TickerText.h"
+#include "OpenMeteo.h"
+#include <PixelLog.h>
+#include <PollClient.h>
+#include <WlanManager.h>
 
 // -----------------------------------------------------------------------------
 // WLAN-Konfiguration
@@ -24,7 +30,12 @@ extern uint32_t lastWeatherUpdateMs;
 
 // Puffer für aktuellen Lauftext
 static char laufTextBuffer[160];
-static size_t laufTextLen = 0;
+
+// Laufschrift und Frame-Takt wie in Laufschrift_2_panels.cpp
+#define scrollPxPerSec 12
+
+static uint32_t lastFrameMs = 0;
+static const uint16_t frameIntervalMs = 20;   // 50 Frames/s
 
 
 // -----------------------------------------------------------------------------
@@ -33,23 +44,12 @@ static size_t laufTextLen = 0;
 static void initAnzeige();
 static void updateAnzeige();
 static void startSequenz();
-static void debugAusgabe();
-
-static void scaleVertTo16();
-static void verschiebeCanvas16EineZeileNachUnten();
-static void blitPanelsFromCanvas16();
-
-static void mirrorPanelHorizontal(
-  cLEDMatrix<panelWidth, panelHeight, VERTICAL_ZIGZAG_MATRIX> &panel);
+static void showLaufschrift(const TextWriter& text);
 
-static void rotatePanel180(
-  cLEDMatrix<panelWidth, panelHeight, VERTICAL_ZIGZAG_MATRIX> &panel);
-
-// WLAN / Wetter - NOT static (linked from Laufschrift_2_panels.cpp)
-void connectToWifi();
+// Wetter - NOT static (linked from Laufschrift_2_panels.cpp)
 void updateWeatherIfNeeded();
 bool fetchWeatherAndBuildText();
-void setLaufschriftText(const String& text);
+void setLaufschriftText(const char* text);
 const char* mapWeatherCodeToText(int code);
 
 
@@ -69,20 +69,13 @@ static void initAnzeige() {
   panelTop.SetLEDArray(ledsBottom);   // Pin 26
   panelBottom.SetLEDArray(ledsTop);   // Pin 25
 
-  // Canvas binden
-  canvas8.SetLEDArray(canvas8Leds);
-  canvas16.SetLEDArray(canvas16Leds);
-
-  // LEDText vorbereiten, Starttext
-  scrollingText.SetFont(MatriseFontData);
-  scrollingText.Init(&canvas8,
-                     canvas8.Width(),
-                     canvas8.Height(),
-                     0, 0);
-  scrollingText.SetScrollDirection(SCROLL_LEFT);
-  scrollingText.SetFrameRate(30);
-  scrollingText.SetTextColrOptions(COLR_RGB | COLR_SINGLE,
-                                   255, 0, 255);
+  // Tabelle Textpixel → LED aufbauen
+  initPanelBlit();
+  profilerInit(frameIntervalMs);
+
+  // Laufschrift vorbereiten (16 Zeilen geglättet), Starttext
+  scrollingText.init(MatriseFontData, panelWidth, TEXT_STRIP_SMOOTH_2X);
+  scrollingText.setSpeed(TEXT_STRIP_SPEED(scrollPxPerSec));
 
   setLaufschriftText("   Verbinde WLAN & lade Wetterdaten...   ");
 }
@@ -92,99 +85,23 @@ static void updateAnzeige() {
   if (now - lastFrameMs < frameIntervalMs) return;
   lastFrameMs = now;
 
-  // 1) Text auf 64x8 rendern
-  if (scrollingText.UpdateText() == -1) {
-    scrollingText.SetText((unsigned char*)laufTextBuffer,
-                          laufTextLen);
-  }
-
-  // 2) Auf 64x16 skalieren
-  scaleVertTo16();
-
-  // 3) Eine Zeile nach unten schieben (oben schwarz)
-  verschiebeCanvas16EineZeileNachUnten();
-
-  // 4) 64x16 → zwei Panels
-  blitPanelsFromCanvas16();
-
-  FastLED.show();
-}
-
-static void scaleVertTo16() {
-  for (uint8_t y8 = 0; y8 < canvasHeight8; y8++) {
-    const uint8_t y16a = 2 * y8;
-    const uint8_t y16b = y16a + 1;
+  PROFILE_STAGE(STAGE_FRAME);
 
-    for (uint8_t x = 0; x < canvasWidth8; x++) {
-      const CRGB c = canvas8(x, y8);
-      canvas16(x, y16a) = c;
-      canvas16(x, y16b) = c;
-    }
+  // 1) Laufschrift weiterrücken
+  {
+    PROFILE_STAGE(STAGE_TEXT);
+    scrollingText.update(now);
   }
-}
 
-static void verschiebeCanvas16EineZeileNachUnten() {
-  for (int y = canvasHeight16 - 1; y > 0; y--) {
-    for (uint8_t x = 0; x < canvasWidth16; x++) {
-      canvas16(x, y) = canvas16(x, y - 1);
-    }
+  // 2) Sichtbares Fenster direkt in beide Panels (verschoben, gespiegelt, gedreht)
+  {
+    PROFILE_STAGE(STAGE_BLIT);
+    drawTextToPanels(scrollingText, panelLeds);
   }
 
-  for (uint8_t x = 0; x < canvasWidth16; x++) {
-    canvas16(x, 0) = CRGB::Black;
-  }
-}
-
-static void blitPanelsFromCanvas16() {
-  // Oberes physisches Panel (Pin 26) bekommt logisches UNTEN (y=8..15)
-  for (uint8_t y = 0; y < panelHeight; y++) {
-    const uint8_t ySrc = y + panelHeight; // 8..15
-    for (uint8_t x = 0; x < panelWidth; x++) {
-      panelTop(x, y) = canvas16(x, ySrc);
-    }
-  }
-
-  // Unteres physisches Panel (Pin 25) bekommt logisches OBEN (y=0..7)
-  for (uint8_t y = 0; y < panelHeight; y++) {
-    const uint8_t ySrc = y; // 0..7
-    for (uint8_t x = 0; x < panelWidth; x++) {
-      panelBottom(x, y) = canvas16(x, ySrc);
-    }
-  }
-
-  // y-Achse-Spiegelung auf beiden Panels
-  mirrorPanelHorizontal(panelTop);
-  mirrorPanelHorizontal(panelBottom);
-
-  // Kopfüber montiertes Panel (früher unten, jetzt oben) drehen
-  rotatePanel180(panelTop);
-}
-
-static void mirrorPanelHorizontal(
-  cLEDMatrix<panelWidth, panelHeight, VERTICAL_ZIGZAG_MATRIX> &panel
-) {
-  for (uint8_t y = 0; y < panelHeight; y++) {
-    for (uint8_t x = 0; x < panelWidth / 2; x++) {
-      const uint8_t xo = panelWidth - 1 - x;
-      CRGB tmp      = panel(x, y);
-      panel(x, y)   = panel(xo, y);
-      panel(xo, y)  = tmp;
-    }
-  }
-}
-
-static void rotatePanel180(
-  cLEDMatrix<panelWidth, panelHeight, VERTICAL_ZIGZAG_MATRIX> &panel
-) {
-  for (uint8_t y = 0; y < panelHeight; y++) {
-    for (uint8_t x = 0; x < panelWidth / 2; x++) {
-      const uint8_t xo = panelWidth - 1 - x;
-      const uint8_t yo = panelHeight - 1 - y;
-
-      CRGB tmp       = panel(x, y);
-      panel(x, y)    = panel(xo, yo);
-      panel(xo, yo)  = tmp;
-    }
+  {
+    PROFILE_STAGE(STAGE_SHOW);
+    FastLED.show();
   }
 }
 
@@ -208,29 +125,8 @@ static void startSequenz() {
 // -----------------------------------------------------------------------------
 // WLAN & Wetter
 // -----------------------------------------------------------------------------
-void connectToWifi() {
-  Serial.print(F("Verbinde mit WLAN: "));
-  Serial.println(wifiSsid);
-
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(wifiSsid, wifiPassword);
-
-  uint8_t tries = 0;
-  while (WiFi.status() != WL_CONNECTED && tries < 30) {
-    delay(500);
-    Serial.print(".");
-    tries++;
-  }
-  Serial.println();
-
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.print(F("WLAN verbunden, IP: "));
-    Serial.println(WiFi.localIP());
-  } else {
-    Serial.println(F("WLAN-Verbindung fehlgeschlagen (weiter im Offline-Modus)."));
-  }
-}
-
+// Läuft im Render-Loop und darf deshalb nie auf das WLAN warten: ohne
+// Verbindung bleibt das Update fällig und kommt, sobald sie steht.
 void updateWeatherIfNeeded() {
   const uint32_t now = millis();
 
@@ -238,20 +134,26 @@ void updateWeatherIfNeeded() {
     return;
   }
 
-  lastWeatherUpdateMs = now;
-
-  if (WiFi.status() != WL_CONNECTED) {
-    connectToWifi();
+  wlanBegin(wifiSsid, wifiPassword);
+  if (!wlanConnected()) {
+    return;
   }
 
+  lastWeatherUpdateMs = now;
+
   if (!fetchWeatherAndBuildText()) {
-    Serial.println(F("Wetter-Update fehlgeschlagen, behalte bisherigen Text."));
+    logLine("Wetter-Update fehlgeschlagen, behalte bisherigen Text.");
   }
 }
 
 /**
  * @brief Holt Wetterdaten von Open-Meteo und baut den Lauftext.
  *
+ * Der Body wird direkt vom Socket geparst (kein String dazwischen), der
+ * Filter in parseCurrentWeather() hält das Dokument auf zwei Zahlen klein – der Heap-Bedarf hängt
+ * damit nicht mehr von der Größe der Antwort ab. Die Verbindung bleibt
+ * zwischen den Abrufen offen, der Hostname kommt aus dem DNS-Cache.
+ *
  * Beispiel-JSON (gekürzt):
  * {
  *   "latitude": ...,
@@ -265,73 +167,58 @@ void updateWeatherIfNeeded() {
  * }
  */
 bool fetchWeatherAndBuildText() {
-  if (WiFi.status() != WL_CONNECTED) {
-    Serial.println(F("Kein WLAN, überspringe Wetter-Update."));
+  if (!wlanConnected()) {
+    logLine("Kein WLAN, überspringe Wetter-Update.");
     return false;
   }
 
-  HTTPClient http;
-  Serial.print(F("GET "));
-  Serial.println(weatherApiUrl);
+  // Bleibt über alle Abrufe bestehen, damit die Verbindung offen bleibt
+  static PollClient http;
+  logLine("GET %s", weatherApiUrl);
 
   http.begin(weatherApiUrl);
   http.setTimeout(8000);
 
   int httpCode = http.GET();
-  if (httpCode != HTTP_CODE_OK) {
-    Serial.print(F("HTTP Fehler: "));
-    Serial.println(httpCode);
+  if (httpCode != POLL_HTTP_OK) {
+    logLine("HTTP Fehler: %d", httpCode);
     http.end();
     return false;
   }
 
-  String payload = http.getString();
+  JsonDocument doc;
+  float temp;
+  int code;
+  bool parsed = parseCurrentWeather(http.getStream(), doc, temp, code);
   http.end();
-
-  StaticJsonDocument<1024> doc;
-  DeserializationError err = deserializeJson(doc, payload);
-  if (err) {
-    Serial.print(F("JSON Fehler: "));
-    Serial.println(err.c_str());
+  if (!parsed) {
     return false;
   }
 
-  JsonObject current = doc["current_weather"];
-  float temp = current["temperature"] | 0.0f;
-  int code   = current["weathercode"] | -1;
+  // Direkt in den Lauftext-Puffer, ohne String dazwischen
+  TextWriter text(laufTextBuffer, sizeof(laufTextBuffer));
+  buildWeatherTicker(text, temp, mapWeatherCodeToText(code));
+  showLaufschrift(text);
 
-  const char* descr = mapWeatherCodeToText(code);
-
-  // Stadtname statisch, weil Open-Meteo nur Koordinaten kennt
-  String text = "   INNSBRUCK ";
-  text += String(temp, 1);
-  text += "C ";
-  text += descr;
-  text += "   ";
-
-  Serial.print(F("Neuer Wetter-Text: "));
-  Serial.println(text);
-
-  setLaufschriftText(text);
+  logLine("Neuer Wetter-Text: %s", laufTextBuffer);
   return true;
 }
 
 /**
- * @brief Schreibt einen String in den globalen Lauftext-Puffer
- *        und setzt ihn im LEDText-Objekt.
+ * @brief Rastert den fertig geschriebenen Lauftext-Puffer einmal in den Streifen.
  */
-void setLaufschriftText(const String& text) {
-  laufTextLen = text.length();
-  if (laufTextLen >= sizeof(laufTextBuffer)) {
-    laufTextLen = sizeof(laufTextBuffer) - 1;
-  }
-
-  text.substring(0, laufTextLen).toCharArray(laufTextBuffer,
-                                             sizeof(laufTextBuffer));
-  laufTextBuffer[laufTextLen] = '\0';
+static void showLaufschrift(const TextWriter& text) {
+  scrollingText.setText(text.c_str(), text.size(), CRGB(255, 0, 255));
+}
 
-  scrollingText.SetText((unsigned char*)laufTextBuffer,
-                        laufTextLen);
+/**
+ * @brief Kopiert einen festen Text in den Lauftext-Puffer
+ *        und setzt ihn als Laufschrift.
+ */
+void setLaufschriftText(const char* text) {
+  TextWriter writer(laufTextBuffer, sizeof(laufTextBuffer));
+  writer.append(text);
+  showLaufschrift(writer);
 }
 
 /**
@@ -366,19 +253,3 @@ const char* mapWeatherCodeToText(int code) {
     default: return "Wettercode";
   }
 }
-
-// -----------------------------------------------------------------------------
-// Debug
-// -----------------------------------------------------------------------------
-static void debugAusgabe() {
-  static uint32_t lastMs = 0;
-  const uint32_t now = millis();
-  if (now - lastMs < 250) return;
-  lastMs = now;
-
-  Serial.print(now);            Serial.print(F(";"));
-  Serial.print(brightness);     Serial.print(F(";"));
-  Serial.print(30);             Serial.print(F(";"));
-  Serial.print(canvasWidth16);  Serial.print(F(";"));
-  Serial.println(canvasHeight16);
-}
@@ -0,0 +1,86 @@
+/**
+ * @file SnakeGame.cpp
+ * @brief Spielkern von Snake, siehe SnakeGame.h.
+ */
+
+#include "SnakeGame.h"
+
+SnakeGame::SnakeGame() {
+  reset();
+}
+
+void SnakeGame::reset() {
+  memset(board, 0, sizeof(board));
+
+  // Schwanz zuerst, der Kopf liegt rechts und landet in body[headSlot]
+  length = SNAKE_START_LENGTH;
+  for (uint16_t i = 0; i < length; i++) {
+    const uint16_t cell = cellAt(SNAKE_WIDTH / 2 - (length - 1 - i), SNAKE_HEIGHT / 2);
+    body[i] = cell;
+    occupy(cell);
+  }
+  headSlot = length - 1;
+
+  placeFood();
+}
+
+bool SnakeGame::isOccupied(int x, int y) const {
+  if (x < 0 || x >= SNAKE_WIDTH || y < 0 || y >= SNAKE_HEIGHT) return true;
+  return isOccupied(cellAt(x, y));
+}
+
+StepResult SnakeGame::step(Direction dir) {
+  const uint16_t head = body[headSlot];
+  int x = cellX(head);
+  int y = cellY(head);
+
+  switch (dir) {
+    case UP: y--; break;
+    case RIGHT: x++; break;
+    case DOWN: y++; break;
+    case LEFT: x--; break;
+  }
+  if (x < 0 || x >= SNAKE_WIDTH || y < 0 || y >= SNAKE_HEIGHT) return STEP_CRASHED;
+
+  const uint16_t next = cellAt(x, y);
+  const bool eats = next == food;
+
+  // Der Schwanz rückt im selben Schritt weiter (außer beim Fressen),
+  // seine Zelle ist für den Kopf also frei
+  const uint16_t tail = segment(length - 1);
+  if (isOccupied(next) && next != tail) return STEP_CRASHED;
+
+  if (!eats) release(tail);
+  occupy(next);
+  headSlot = (headSlot + 1) & (SNAKE_CELLS - 1);
+  body[headSlot] = next;
+  if (!eats) return STEP_MOVED;
+
+  length++;
+  return placeFood() ? STEP_ATE : STEP_WON;
+}
+
+bool SnakeGame::placeFood() {
+  uint16_t free = SNAKE_CELLS - length;
+  if (free == 0) {
+    food = SNAKE_NO_FOOD;
+    return false;
+  }
+
+  // k-te freie Zelle: erst das Wort über die Bitzählung, dann das Bit
+  uint16_t k = random(free);
+  for (uint8_t word = 0; word < SNAKE_BOARD_WORDS; word++) {
+    uint32_t bits = ~board[word];
+    const uint8_t count = __builtin_popcount(bits);
+    if (k >= count) {
+      k -= count;
+      continue;
+    }
+    while (k-- > 0) bits &= bits - 1;   // k niedrigste freie Bits überspringen
+    food = word * 32 + __builtin_ctz(bits);
+    return true;
+  }
+
+  food = SNAKE_NO_FOOD;   // Bitbrett und Länge passen nicht zusammen
+  return false;
+}
@@ -0,0 +1,93 @@
+#ifndef SNAKE_GAME_H
+#define SNAKE_GAME_H
+
+#include <Arduino.h>
+
+/**
+ * @file SnakeGame.h
+ * @brief Spielkern von Snake: Körper als Ringpuffer, Belegung als Bitbrett.
+ *
+ * Der Körper liegt als Zellenindex (y * SNAKE_WIDTH + x) in einem
+ * Ringpuffer, ein Schritt schreibt also nur den neuen Kopf und rückt den
+ * Schwanz weiter, statt alle Glieder zu verschieben. Welche Zellen belegt
+ * sind, steht zusätzlich in einem Bitbrett mit einem Bit pro Zelle
+ * (16 x uint32_t bei 32x16). Damit kostet die Kollisionsprüfung ein Bit,
+ * unabhängig von der Länge.
+ *
+ * Futter landet gleichverteilt auf einer freien Zelle: eine Zufallszahl
+ * k < freie Zellen, dann über die Bitzählung der 16 Wörter zum Wort mit
+ * der k-ten freien Zelle und darin zum Bit. Kein Verwerfen und Neuwürfeln
+ * mehr, auch nicht bei fast vollem Brett.
+ *
+ * Die Schlange darf das ganze Brett füllen (SNAKE_CELLS Glieder), dann
+ * liefert step() STEP_WON.
+ */
+
+#define SNAKE_WIDTH        32
+#define SNAKE_HEIGHT       16
+#define SNAKE_CELLS        (SNAKE_WIDTH * SNAKE_HEIGHT)
+#define SNAKE_BOARD_WORDS  (SNAKE_CELLS / 32)
+#define SNAKE_START_LENGTH 3
+#define SNAKE_NO_FOOD      0xFFFF
+
+static_assert((SNAKE_CELLS & (SNAKE_CELLS - 1)) == 0, "Ringpuffer braucht eine Zweierpotenz");
+static_assert(SNAKE_CELLS % 32 == 0, "Bitbrett braucht ganze Wörter");
+
+// Richtung
+enum Direction { UP, RIGHT, DOWN, LEFT };
+
+enum StepResult {
+  STEP_MOVED,
+  STEP_ATE,       // gewachsen, neues Futter liegt
+  STEP_CRASHED,   // Wand oder eigener Körper, Zustand bleibt wie vorher
+  STEP_WON        // Brett voll
+};
+
+class SnakeGame {
+private:
+  uint16_t body[SNAKE_CELLS];              // Ringpuffer, body[headSlot] = Kopf
+  uint32_t board[SNAKE_BOARD_WORDS];       // Bit (c & 31) in Wort c / 32 = Zelle c belegt
+  uint16_t headSlot;
+  uint16_t length;
+  uint16_t food;                           // Zelle oder SNAKE_NO_FOOD
+
+  void occupy(uint16_t cell) { board[cell >> 5] |= 1u << (cell & 31); }
+  void release(uint16_t cell) { board[cell >> 5] &= ~(1u << (cell & 31)); }
+
+public:
+  SnakeGame();
+
+  /**
+   * @brief Neues Spiel: SNAKE_START_LENGTH Glieder in der Mitte, Kopf
+   *        rechts, dazu das erste Futter.
+   */
+  void reset();
+
+  /**
+   * @brief Einen Schritt in Richtung dir. Der Kopf darf auf die Zelle, die
+   *        der Schwanz im selben Schritt verlässt.
+   */
+  StepResult step(Direction dir);
+
+  /**
+   * @brief Futter auf eine zufällige freie Zelle legen (random()).
+   * @return false, wenn keine Zelle mehr frei ist
+   */
+  bool placeFood();
+
+  bool isOccupied(uint16_t cell) const { return board[cell >> 5] & (1u << (cell & 31)); }
+  bool isOccupied(int x, int y) const;    // außerhalb des Bretts = belegt
+
+  uint16_t getLength() const { return length; }
+  uint16_t getFood() const { return food; }
+  uint16_t getHead() const { return body[headSlot]; }
+
+  // Glied i, 0 = Kopf, length - 1 = Schwanz
+  uint16_t segment(uint16_t i) const { return body[(headSlot - i) & (SNAKE_CELLS - 1)]; }
+
+  static uint8_t cellX(uint16_t cell) { return cell % SNAKE_WIDTH; }
+  static uint8_t cellY(uint16_t cell) { return cell / SNAKE_WIDTH; }
+  static uint16_t cellAt(uint8_t x, uint8_t y) { return y * SNAKE_WIDTH + x; }
+};
+
+#endif // SNAKE_GAME_H
@@ -1,15 +1,19 @@
 #include <FastLED.h>
-#include <LEDMatrix.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/queue.h>
+#include <PixelLog.h>
+#include <Snapshot.h>
+#include <GameLoop.h>
+#include <InputSampler.h>
+#include "SnakeGame.h"
 
 // LED Matrix Konfiguration
 #define NUM_LEDS_PER_STRIP 256
 #define DATA_PIN_UPPER 25
 #define DATA_PIN_LOWER 26
-#define MATRIX_WIDTH 32
-#define MATRIX_HEIGHT 16
-#define MATRIX_TYPE VERTICAL_ZIGZAG_MATRIX
+#define MATRIX_WIDTH SNAKE_WIDTH
+#define MATRIX_HEIGHT SNAKE_HEIGHT
 
 // Joystick Pins
 #define JOYSTICK_BUTTON_PIN 32
@@ -18,17 +22,51 @@
 
 #define TASK_DELAY 10
 
-// Richtung
-enum Direction { UP, RIGHT, DOWN, LEFT };
+// Spielschleife: fester Takt, ein Zug alle gameSpeed ms (ganze Takte)
+#define TICK_MS 10
+#define START_SPEED_MS 400
+#define MIN_SPEED_MS 80
+#define GAME_OVER_MS 3000
 
-// LED Arrays
+// Render-Task: einziger Besitzer der LED-Puffer, zeigt im festen Takt
+#define FRAME_MS 20
+#define FRAME_POOL 3             // Snake zeichnet in einen, einer wartet, einer Reserve
+#define RENDER_QUEUE_LENGTH 4
+
+// Aktive Anzeige
+#define TASK_SNAKE 0
+#define TASK_ANIMATION 1
+
+// LED Arrays, nur der Render-Task schreibt hinein
 CRGB leds_upper[NUM_LEDS_PER_STRIP];
 CRGB leds_lower[NUM_LEDS_PER_STRIP];
-CRGB leds_array[NUM_LEDS_PER_STRIP * 2];
-cLEDMatrix<-MATRIX_WIDTH, MATRIX_HEIGHT, MATRIX_TYPE> leds;
 
-// Globale Spielflags
-volatile int currentTask = 0;  // 0 = Snake, 1 = Testanimation
+// Aktive Anzeige: TASK_SNAKE oder TASK_ANIMATION. Schreibt nur der
+// Snake-Task (Tasterdruck), die anderen Tasks lesen.
+Snapshot<int> currentTask;
+
+// Ein fertiges Snake-Bild, zeilenweise in Brett-Koordinaten
+struct SnakeFrame {
+  CRGB pixels[MATRIX_WIDTH * MATRIX_HEIGHT];
+};
+
+enum RenderCommandType : uint8_t {
+  RENDER_FRAME,   // framePool[frame] anzeigen, danach zurück nach freeFrames
+  RENDER_FILL     // alle LEDs in color
+};
+
+struct RenderCommand {
+  RenderCommandType type;
+  uint8_t source;   // TASK_SNAKE oder TASK_ANIMATION
+  uint8_t frame;
+  CRGB color;
+};
+
+// Snake holt einen freien Puffer aus freeFrames, zeichnet und schickt
+// ihn über renderQueue. Bilder werden also nicht kopiert, nur Indizes.
+SnakeFrame framePool[FRAME_POOL];
+QueueHandle_t freeFrames;
+QueueHandle_t renderQueue;
 
 // Struktur für LED-Adresse
 struct LedAddress {
@@ -36,15 +74,17 @@ struct LedAddress {
   int index;
 };
 
-// Snake-Variablen
-int snakeX[100], snakeY[100];
-int snakeLength = 3;
+// Joystick und Taster, abgetastet im eigenen Task
+InputSampler input(JOYSTICK_BUTTON_PIN, JOYSTICK_X_PIN, JOYSTICK_Y_PIN);
+
+// Snake-Variablen, nur im Snake-Task
+SnakeGame game;
 Direction snakeDirection = RIGHT;
-int foodX, foodY;
-unsigned long lastMoveTime = 0;
-int gameSpeed = 400;
+int gameSpeed = START_SPEED_MS;
 bool gameOver = false;
 int score = 0;
+uint16_t moveTicks = 0;          // Takte seit dem letzten Zug bzw. seit Game Over
+uint16_t fadingTail = SNAKE_NO_FOOD;   // beim letzten Zug frei gewordene Zelle
 
 // Mapping-Funktion
 LedAddress mapXY(int x, int y) {
@@ -65,168 +105,225 @@ LedAddress mapXY(int x, int y) {
 }
 
 // Snake-Funktionen
-void generateFood() {
-  bool valid;
-  do {
-    valid = true;
-    foodX = random(MATRIX_WIDTH);
-    foodY = random(MATRIX_HEIGHT);
-    for (int i = 0; i < snakeLength; i++) {
-      if (foodX == snakeX[i] && foodY == snakeY[i]) valid = false;
-    }
-  } while (!valid);
-}
-
 void initGame() {
-  snakeLength = 3;
-  for (int i = 0; i < snakeLength; i++) {
-    snakeX[i] = MATRIX_WIDTH / 2 - i;
-    snakeY[i] = MATRIX_HEIGHT / 2;
-  }
+  game.reset();
   snakeDirection = RIGHT;
   score = 0;
-  generateFood();
-  gameSpeed = 400;
+  gameSpeed = START_SPEED_MS;
   gameOver = false;
-  lastMoveTime = millis();
+  moveTicks = 0;
+  fadingTail = SNAKE_NO_FOOD;
 }
 
-void readJoystick() {
-  int x = analogRead(JOYSTICK_X_PIN);
-  int y = analogRead(JOYSTICK_Y_PIN);
-  const int mid = 2048;
-  const int thresh = 1000;
-
-  if (y > mid + thresh && snakeDirection != LEFT) snakeDirection = RIGHT;
-  else if (y < mid - thresh && snakeDirection != RIGHT) snakeDirection = LEFT;
-  else if (x > mid + thresh && snakeDirection != DOWN) snakeDirection = UP;
-  else if (x < mid - thresh && snakeDirection != UP) snakeDirection = DOWN;
+// Lenken, aber nie direkt in die Gegenrichtung
+void steer(InputDirection direction) {
+  if (direction == INPUT_RIGHT && snakeDirection != LEFT) snakeDirection = RIGHT;
+  else if (direction == INPUT_LEFT && snakeDirection != RIGHT) snakeDirection = LEFT;
+  else if (direction == INPUT_UP && snakeDirection != DOWN) snakeDirection = UP;
+  else if (direction == INPUT_DOWN && snakeDirection != UP) snakeDirection = DOWN;
 }
 
 void moveSnake() {
-  if (millis() - lastMoveTime < gameSpeed || gameOver) return;
-  lastMoveTime = millis();
-
-  for (int i = snakeLength - 1; i > 0; i--) {
-    snakeX[i] = snakeX[i - 1];
-    snakeY[i] = snakeY[i - 1];
+  const uint16_t tail = game.segment(game.getLength() - 1);
+  fadingTail = SNAKE_NO_FOOD;
+
+  switch (game.step(snakeDirection)) {
+    case STEP_MOVED:
+      fadingTail = tail;
+      break;
+    case STEP_ATE:
+      score++;
+      gameSpeed = max(MIN_SPEED_MS, gameSpeed - 10);
+      break;
+    case STEP_WON:
+      score++;
+      logLine("Brett voll, Score %d", score);
+      gameOver = true;
+      break;
+    case STEP_CRASHED:
+      gameOver = true;
+      break;
   }
+}
 
-  switch (snakeDirection) {
-    case UP: snakeY[0]--; break;
-    case RIGHT: snakeX[0]++; break;
-    case DOWN: snakeY[0]++; break;
-    case LEFT: snakeX[0]--; break;
+// Ein Takt: Game Over abwarten oder, wenn fällig, einen Zug machen
+bool tickGame() {
+  moveTicks++;
+  if (gameOver) {
+    if (moveTicks < GAME_OVER_MS / TICK_MS) return false;
+    initGame();
+    return true;
   }
+  if (moveTicks < gameSpeed / TICK_MS) return false;
+  moveTicks = 0;
+  moveSnake();
+  return true;
+}
 
-  if (snakeX[0] < 0 || snakeX[0] >= MATRIX_WIDTH ||
-      snakeY[0] < 0 || snakeY[0] >= MATRIX_HEIGHT) {
-    gameOver = true;
-    return;
+// progress = Anteil am laufenden Zug in 1/256: der Kopf blendet über den
+// Zug hinweg von gut einem Drittel auf volle Helligkeit auf, die frei
+// gewordene Schwanzzelle aus
+void drawGame(SnakeFrame& frame, uint8_t progress, uint32_t nowMs) {
+  fill_solid(frame.pixels, MATRIX_WIDTH * MATRIX_HEIGHT, CRGB::Black);
+  const int snakeLength = game.getLength();
+  for (int i = 0; i < snakeLength; i++) {
+    frame.pixels[game.segment(i)] = (i == 0) ? CRGB::White :
+      CRGB(0, map(i, 1, snakeLength - 1, 200, 50), 0);
   }
+  if (gameOver) return;
 
-  for (int i = 1; i < snakeLength; i++) {
-    if (snakeX[0] == snakeX[i] && snakeY[0] == snakeY[i]) {
-      gameOver = true;
-      return;
-    }
+  frame.pixels[game.getHead()].nscale8_video(96 + scale8(progress, 159));
+  if (fadingTail != SNAKE_NO_FOOD) {
+    frame.pixels[fadingTail] = CRGB(0, 50, 0).nscale8_video(255 - progress);
   }
 
-  if (snakeX[0] == foodX && snakeY[0] == foodY) {
-    if (snakeLength < 100) snakeLength++;
-    score++;
-    gameSpeed = max(80, gameSpeed - 10);
-    generateFood();
+  // Pulsiert mit ~1,26 s Periode zwischen 50 und 250
+  if (game.getFood() != SNAKE_NO_FOOD) {
+    const uint8_t brightness = 150 + ((100 * (int32_t)sin16(nowMs * 52)) >> 15);
+    frame.pixels[game.getFood()] = CRGB(brightness, 0, 0);
   }
 }
 
-void drawGame() {
-  FastLED.clear();
-  for (int i = 0; i < snakeLength; i++) {
-    if (snakeX[i] >= 0 && snakeX[i] < MATRIX_WIDTH &&
-        snakeY[i] >= 0 && snakeY[i] < MATRIX_HEIGHT) {
-      LedAddress addr = mapXY(snakeX[i], snakeY[i]);
-      addr.array[addr.index] = (i == 0) ? CRGB::White :
-        CRGB(0, map(i, 1, snakeLength - 1, 200, 50), 0);
+// Bindet Snake an die Spielschleife; gezeichnet wird in einen freien
+// Puffer des Pools, der dann an den Render-Task geht
+class SnakeLoop : public Game {
+public:
+  bool tick() override { return tickGame(); }
+
+  bool render(uint8_t alpha, uint32_t nowMs) override {
+    // Kein Puffer frei: der Render-Task hängt hinterher, später nochmal
+    uint8_t frame;
+    if (xQueueReceive(freeFrames, &frame, 0) != pdTRUE) return false;
+
+    const uint16_t ticksPerMove = gameSpeed / TICK_MS;
+    const uint32_t progress = ((uint32_t)moveTicks * 256 + alpha) / ticksPerMove;
+    drawGame(framePool[frame], progress > 255 ? 255 : progress, nowMs);
+
+    RenderCommand command = { RENDER_FRAME, TASK_SNAKE, frame, CRGB::Black };
+    if (xQueueSend(renderQueue, &command, 0) != pdTRUE) {
+      xQueueSend(freeFrames, &frame, 0);
+      return false;
     }
+    return true;
   }
 
-  if (!gameOver) {
-    LedAddress addr = mapXY(foodX, foodY);
-    int brightness = 150 + 100 * sin(millis() / 200.0);
-    addr.array[addr.index] = CRGB(brightness, 0, 0);
+  // Futter pulsiert und Züge werden überblendet; im Game Over steht das Bild
+  bool animating() const override { return !gameOver; }
+};
+
+SnakeLoop snakeLoop;
+GameLoop gameLoop(snakeLoop, TICK_MS, 1000 / FRAME_MS);
+
+// Nur im Render-Task
+void applyRenderCommand(const RenderCommand& command) {
+  if (command.type == RENDER_FILL) {
+    fill_solid(leds_upper, NUM_LEDS_PER_STRIP, command.color);
+    fill_solid(leds_lower, NUM_LEDS_PER_STRIP, command.color);
+    return;
   }
 
-  FastLED.show();
+  const SnakeFrame& frame = framePool[command.frame];
+  for (int y = 0; y < MATRIX_HEIGHT; y++) {
+    for (int x = 0; x < MATRIX_WIDTH; x++) {
+      LedAddress addr = mapXY(x, y);
+      addr.array[addr.index] = frame.pixels[y * MATRIX_WIDTH + x];
+    }
+  }
 }
 
 // === TASKS ===
 
-void snakeTask(void* pvParameters) {
+// Einziger Task, der die LED-Puffer beschreibt und FastLED.show() aufruft.
+// Pro Takt werden alle wartenden Befehle abgearbeitet (bei mehreren Bildern
+// gewinnt das letzte) und höchstens einmal ausgegeben. Befehle der gerade
+// nicht aktiven Anzeige werden verworfen, ein Umschalten mitten im Frame
+// kann also kein fremdes Bild mehr auf die LEDs bringen. Die aktive Anzeige
+// wird pro Befehl gelesen: der Füllbefehl der Animation kommt erst nach dem
+// Umschalten in die Queue und darf nicht an einem veralteten Stand scheitern.
+void renderTask(void* pvParameters) {
+  TickType_t lastWake = xTaskGetTickCount();
+  RenderCommand command;
   while (1) {
-    if (currentTask == 0) {
-      readJoystick();
-      moveSnake();
-      drawGame();
-      if (gameOver && millis() - lastMoveTime > 3000) initGame();
+    bool changed = false;
+    while (xQueueReceive(renderQueue, &command, 0) == pdTRUE) {
+      if (command.source == currentTask.read()) {
+        applyRenderCommand(command);
+        changed = true;
+      }
+      if (command.type == RENDER_FRAME) xQueueSend(freeFrames, &command.frame, 0);
     }
-    vTaskDelay(pdMS_TO_TICKS(TASK_DELAY));
+    if (changed) FastLED.show();
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(FRAME_MS));
   }
 }
 
-void altAnimationTask(void* pvParameters) {
+void handleInput(const InputEvent& event) {
+  if (event.type == INPUT_PRESS) {
+    const int task = (currentTask.read() + 1) % 2;
+    currentTask.publish(task);
+    logLine("Switched to Task %d", task);
+  } else if (event.type == INPUT_DIRECTION && currentTask.read() == TASK_SNAKE) {
+    steer(event.direction);
+  }
+}
+
+// Wartet auf Eingaben, höchstens bis zum nächsten Takt oder Frame, den
+// gameLoop.run() nennt; eine Eingabe weckt den Task also sofort. Während
+// der Animation steht das Spiel, beim Zurückschalten beginnt das Raster
+// neu, statt die verpasste Zeit nachzuholen.
+void snakeTask(void* pvParameters) {
+  bool wasActive = false;
+  InputEvent event;
   while (1) {
-    if (currentTask == 1) {
-      for (int i = 0; i < NUM_LEDS_PER_STRIP * 2; i++) {
-        leds_array[i] = CRGB::Blue;
-      }
-      FastLED.show();
-    }
-    vTaskDelay(pdMS_TO_TICKS(TASK_DELAY));
+    const bool active = currentTask.read() == TASK_SNAKE;
+    if (active && !wasActive) gameLoop.start(micros());
+    wasActive = active;
+
+    const TickType_t wait = active ? pdMS_TO_TICKS(gameLoop.run(micros())) : portMAX_DELAY;
+    if (xQueueReceive(input.getEvents(), &event, wait) == pdTRUE) handleInput(event);
   }
 }
 
-void joystickButtonTask(void* pvParameters) {
-  bool lastState = HIGH;
+// Das Bild ist statisch: ein Füllbefehl beim Umschalten auf die Animation
+void altAnimationTask(void* pvParameters) {
+  SnapshotReader<int> reader(currentTask);
+  int task = TASK_SNAKE;
   while (1) {
-    bool currentState = digitalRead(JOYSTICK_BUTTON_PIN);
-    if (lastState == HIGH && currentState == LOW) {
-      currentTask = (currentTask + 1) % 2;
-      Serial.print("Switched to Task ");
-      Serial.println(currentTask);
-      delay(200); // Entprellung
+    if (reader.poll(task) && task == TASK_ANIMATION) {
+      RenderCommand command = { RENDER_FILL, TASK_ANIMATION, 0, CRGB::Blue };
+      xQueueSend(renderQueue, &command, pdMS_TO_TICKS(FRAME_MS));
     }
-    lastState = currentState;
-    vTaskDelay(pdMS_TO_TICKS(50));
+    vTaskDelay(pdMS_TO_TICKS(TASK_DELAY));
   }
 }
 
 void setup() {
   Serial.begin(115200);
-  pinMode(JOYSTICK_BUTTON_PIN, INPUT_PULLUP);
-  pinMode(JOYSTICK_X_PIN, INPUT);
-  pinMode(JOYSTICK_Y_PIN, INPUT);
+  logInit();
 
   FastLED.addLeds<WS2812B, DATA_PIN_UPPER, GRB>(leds_upper, NUM_LEDS_PER_STRIP);
   FastLED.addLeds<WS2812B, DATA_PIN_LOWER, GRB>(leds_lower, NUM_LEDS_PER_STRIP);
   FastLED.setBrightness(50);
 
-  for (int i = 0; i < NUM_LEDS_PER_STRIP; i++) {
-    leds_array[i] = leds_lower[i];
-    leds_array[i + NUM_LEDS_PER_STRIP] = leds_upper[i];
-  }
-  leds.SetLEDArray(leds_array);
-
   FastLED.clear();
   FastLED.show();
   randomSeed(analogRead(36));
 
   initGame();
 
-  // FreeRTOS Tasks
+  renderQueue = xQueueCreate(RENDER_QUEUE_LENGTH, sizeof(RenderCommand));
+  freeFrames = xQueueCreate(FRAME_POOL, sizeof(uint8_t));
+  for (uint8_t i = 0; i < FRAME_POOL; i++) {
+    xQueueSend(freeFrames, &i, 0);
+  }
+
+  // Eingaben kommen ab hier als Ereignisse (Timer und Pin-Interrupt)
+  if (!input.begin()) logLine("Eingabe-Task konnte nicht starten");
+
+  // FreeRTOS Tasks; ab hier ruft nur noch renderTask FastLED.show() auf
+  xTaskCreate(renderTask, "RenderTask", 2048, NULL, 2, NULL);
   xTaskCreate(snakeTask, "SnakeTask", 4096, NULL, 1, NULL);
   xTaskCreate(altAnimationTask, "AltTask", 2048, NULL, 1, NULL);
-  xTaskCreate(joystickButtonTask, "JoystickTask", 1024, NULL, 2, NULL);
 }
 
 void loop() {
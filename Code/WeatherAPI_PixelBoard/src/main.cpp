@@ -1,10 +1,15 @@
 #include <WiFi.h>
-#include <HTTPClient.h>
+#include <Preferences.h>
 #include <ArduinoJson.h>
 #include <FastLED.h>
 #include <LEDMatrix.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <PixelLog.h>
+#include <PollClient.h>
+#include <WlanManager.h>
+#include <TextWriter.h>
+#include <Snapshot.h>
 
 // WLAN-Zugangsdaten (iPhone Hotspot)
 // WICHTIG: iPhone Hotspot muss auf 2.4 GHz stehen!
@@ -77,11 +82,43 @@ const byte font3x5[][5] = {
   {0b000, 0b000, 0b111, 0b000, 0b000},  // - (17) - Minuszeichen
 };
 
-// Werte
-float temperature = 0.0;
-int humidity = 0;
-float windSpeed = 0.0;
-bool dataReceived = false;
+// Werte: schreibt der Abruf-Task (bzw. setup() aus dem Cache), liest der
+// Anzeige-Task. Immer als ganzer Datensatz, damit nie Temperatur der
+// neuen und Wind der alten Messung zusammen angezeigt werden.
+struct WeatherReading {
+  float temperature;
+  int humidity;
+  float windSpeed;
+  uint32_t observedAt;   // Unix-Zeit der Messung ("dt" der API)
+};
+
+// Version 0 = noch keine Daten
+Snapshot<WeatherReading> weatherReading;
+
+#define READING_PAGES     3
+#define READING_PAGE_MS   3000
+#define DISPLAY_POLL_MS   100
+
+// ==================== WETTER-CACHE (NVS) ====================
+
+#define WEATHER_CACHE_NAMESPACE  "weather"
+#define WEATHER_CACHE_VERSION    1
+
+// Letzte Messung, kompakt im NVS. Nach einem Neustart sofort angezeigt.
+struct __attribute__((packed)) WeatherCacheRecord {
+  uint8_t version;
+  int16_t temperatureCenti;   // °C x 100
+  uint8_t humidity;           // %
+  uint16_t windSpeedCenti;    // m/s x 100
+  uint32_t observedAt;        // Unix-Zeit der Messung
+};
+
+Preferences weatherCache;
+WeatherCacheRecord savedRecord = {};
+
+// Validatoren der letzten 200-Antwort, für If-None-Match / If-Modified-Since
+String cachedEtag;
+String cachedLastModified;
 
 // Alle LEDs sicher loeschen
 void clearAll() {
@@ -112,10 +149,10 @@ void drawChar(int index, int x, int y, CRGB color) {
 }
 
 // Textbreite berechnen (fuer Zentrierung)
-int getTextWidth(String text) {
+int getTextWidth(const char* text) {
   int width = 0;
-  for (unsigned int i = 0; i < text.length(); i++) {
-    char c = text.charAt(i);
+  for (const char* p = text; *p; p++) {
+    char c = *p;
     if (c >= '0' && c <= '9') width += 4;
     else if (c == '.') width += 4;
     else if (c == 'C') width += 4;
@@ -133,13 +170,13 @@ int getTextWidth(String text) {
 }
 
 // Text zentriert anzeigen
-void drawTextCentered(String text, int y, CRGB color) {
+void drawTextCentered(const char* text, int y, CRGB color) {
   int textW = getTextWidth(text);
   int x = (MATRIX_WIDTH - textW) / 2;  // Horizontal zentrieren
 
   int pos = 0;
-  for (unsigned int i = 0; i < text.length(); i++) {
-    char c = text.charAt(i);
+  for (const char* p = text; *p; p++) {
+    char c = *p;
     int index = -1;
 
     if (c >= '0' && c <= '9') index = c - '0';
@@ -160,147 +197,200 @@ void drawTextCentered(String text, int y, CRGB color) {
   }
 }
 
-// WLAN verbinden (mit Retries und Timeout)
-void connectWiFi() {
-  Serial.println();
-  Serial.println("===========================================");
-  Serial.println("ESP32 unterstuetzt NUR 2.4 GHz WLAN!");
-  Serial.println("iPhone: Einstellungen > Persoenlicher Hotspot");
-  Serial.println("  -> 'Kompatibilitaet maximieren' AKTIVIEREN");
-  Serial.println("===========================================");
-  Serial.println();
-
-  WiFi.mode(WIFI_STA);
-  WiFi.disconnect(true);
-  delay(100);
-
-  Serial.print("Verbinde mit: ");
-  Serial.println(ssid);
+// Cache lesen; ohne gültigen Eintrag gibt es auch keine Validatoren,
+// sonst könnte ein 304 kommen, ohne dass Werte da sind
+bool loadWeatherCache() {
+  WeatherCacheRecord record;
+  size_t size = 0;
+
+  weatherCache.begin(WEATHER_CACHE_NAMESPACE, true);
+  if (weatherCache.isKey("reading")) {
+    size = weatherCache.getBytes("reading", &record, sizeof(record));
+    cachedEtag = weatherCache.getString("etag", "");
+    cachedLastModified = weatherCache.getString("lastmod", "");
+  }
+  weatherCache.end();
 
-  WiFi.begin(ssid, password);
+  if (size != sizeof(record) || record.version != WEATHER_CACHE_VERSION) {
+    cachedEtag = "";
+    cachedLastModified = "";
+    return false;
+  }
 
-  int tries = 0;
-  int maxTries = 40;  // 20 Sekunden Timeout
+  savedRecord = record;
 
-  while (WiFi.status() != WL_CONNECTED && tries < maxTries) {
-    delay(500);
-    Serial.print(".");
-    tries++;
+  WeatherReading reading;
+  reading.temperature = record.temperatureCenti / 100.0f;
+  reading.humidity = record.humidity;
+  reading.windSpeed = record.windSpeedCenti / 100.0f;
+  reading.observedAt = record.observedAt;
+  weatherReading.publish(reading);
+  return true;
+}
 
-    // Nach 10 Versuchen nochmal neu versuchen
-    if (tries == 20) {
-      Serial.println();
-      Serial.println("Neuversuch...");
-      WiFi.disconnect(true);
-      delay(500);
-      WiFi.begin(ssid, password);
-    }
+// Schreibt nur, was sich geändert hat, um den Flash zu schonen
+void saveWeatherCache(const WeatherReading& reading, const String& etag, const String& lastModified) {
+  WeatherCacheRecord record;
+  record.version = WEATHER_CACHE_VERSION;
+  record.temperatureCenti = (int16_t)lroundf(reading.temperature * 100.0f);
+  record.humidity = (uint8_t)constrain(reading.humidity, 0, 100);
+  record.windSpeedCenti = (uint16_t)constrain(lroundf(reading.windSpeed * 100.0f), 0L, 65535L);
+  record.observedAt = reading.observedAt;
+
+  weatherCache.begin(WEATHER_CACHE_NAMESPACE, false);
+  if (memcmp(&record, &savedRecord, sizeof(record)) != 0) {
+    weatherCache.putBytes("reading", &record, sizeof(record));
+    savedRecord = record;
+  }
+  if (etag != cachedEtag) {
+    weatherCache.putString("etag", etag);
+    cachedEtag = etag;
+  }
+  if (lastModified != cachedLastModified) {
+    weatherCache.putString("lastmod", lastModified);
+    cachedLastModified = lastModified;
   }
+  weatherCache.end();
+}
 
-  Serial.println();
+// WLAN im Hintergrund verbinden, Neuversuche mit Backoff macht WlanManager
+void connectWiFi() {
+  logLine("===========================================");
+  logLine("ESP32 unterstuetzt NUR 2.4 GHz WLAN!");
+  logLine("iPhone: Einstellungen > Persoenlicher Hotspot");
+  logLine("  -> 'Kompatibilitaet maximieren' AKTIVIEREN");
+  logLine("===========================================");
 
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.print("WLAN verbunden! IP: ");
-    Serial.println(WiFi.localIP());
-  } else {
-    Serial.println("WLAN-Verbindung FEHLGESCHLAGEN!");
-    Serial.println("Pruefe: Ist 'Kompatibilitaet maximieren' aktiv?");
-    Serial.print("WiFi Status Code: ");
-    Serial.println(WiFi.status());
+  wlanBegin(ssid, password);
+}
+
+// Nur die angezeigten Felder behalten, der Rest der Antwort wird beim Lesen verworfen
+static const JsonDocument& weatherFilter() {
+  static JsonDocument filter;
+  if (filter.isNull()) {
+    filter["main"]["temp"] = true;
+    filter["main"]["humidity"] = true;
+    filter["wind"]["speed"] = true;
+    filter["dt"] = true;
   }
+  return filter;
 }
 
-// WLAN-Verbindung pruefen und ggf. neu verbinden
-void ensureWiFi() {
-  if (WiFi.status() != WL_CONNECTED) {
-    Serial.println("WLAN verloren, verbinde neu...");
-    connectWiFi();
+// Body einer 200-Antwort lesen, direkt vom Stream. doc gibt der Aufrufer,
+// damit der Bench messen kann, wie viel Speicher das Dokument hält.
+bool parseWeatherReading(Stream& body, JsonDocument& doc, WeatherReading& reading) {
+  DeserializationError error = deserializeJson(doc, body, DeserializationOption::Filter(weatherFilter()));
+  if (error) {
+    logLine("JSON Fehler: %s", error.c_str());
+    return false;
   }
+
+  reading.temperature = doc["main"]["temp"];
+  reading.humidity = doc["main"]["humidity"];
+  reading.windSpeed = doc["wind"]["speed"];
+  reading.observedAt = doc["dt"] | 0u;
+  return true;
 }
 
-// Wetterdaten abrufen
+// Wetterdaten abrufen, geparst wird direkt vom Socket. Mit gespeicherten
+// Validatoren antwortet der Server bei unveränderten Daten nur mit 304.
+// Die Verbindung bleibt zwischen den Abrufen offen (Keep-Alive).
 void fetchWeatherData(void *pvParameters) {
-  // Erstes Update sofort nach Verbindung
-  delay(2000);
+  PollClient http;
 
   while (true) {
-    ensureWiFi();
-
-    if (WiFi.status() == WL_CONNECTED) {
-      HTTPClient http;
-      http.setTimeout(10000);
-      http.begin(apiUrl);
-      int httpCode = http.GET();
-
-      if (httpCode == HTTP_CODE_OK) {
-        String payload = http.getString();
-        JsonDocument doc;
-        DeserializationError error = deserializeJson(doc, payload);
-
-        if (!error) {
-          temperature = doc["main"]["temp"];
-          humidity = doc["main"]["humidity"];
-          windSpeed = doc["wind"]["speed"];
-          dataReceived = true;
-          Serial.printf("Temp: %.1f°C | Humidity: %d%% | Wind: %.1f m/s\n",
-                        temperature, humidity, windSpeed);
-        } else {
-          Serial.print("JSON Fehler: ");
-          Serial.println(error.c_str());
-        }
-      } else {
-        Serial.print("HTTP Fehler: ");
-        Serial.println(httpCode);
+    // Abruf erst, wenn das WLAN steht; bis dahin wartet nur dieser Task
+    if (!wlanWaitConnected(60000)) continue;
+
+    http.setTimeout(10000);
+    http.begin(apiUrl);
+    if (cachedEtag.length() > 0) http.addHeader("If-None-Match", cachedEtag);
+    if (cachedLastModified.length() > 0) http.addHeader("If-Modified-Since", cachedLastModified);
+    int httpCode = http.GET();
+
+    if (httpCode == POLL_HTTP_NOT_MODIFIED) {
+      logLine("Wetter unveraendert (304)");
+    } else if (httpCode == POLL_HTTP_OK) {
+      JsonDocument doc;
+      WeatherReading reading;
+      if (parseWeatherReading(http.getStream(), doc, reading)) {
+        weatherReading.publish(reading);
+        logLine("Temp: %.1f°C | Humidity: %d%% | Wind: %.1f m/s",
+                reading.temperature, reading.humidity, reading.windSpeed);
+        saveWeatherCache(reading, http.header("ETag"), http.header("Last-Modified"));
       }
-      http.end();
+    } else {
+      logLine("HTTP Fehler: %d", httpCode);
     }
+    http.end();
     vTaskDelay(60000 / portTICK_PERIOD_MS);
   }
 }
 
-// Anzeige - zentriert und kompakt
+// Eine Seite der Anzeige zeichnen (ohne show), formatiert ohne Heap:
+// 0 = Temperatur, 1 = Luftfeuchtigkeit, 2 = Windgeschwindigkeit
+void drawReading(const WeatherReading& reading, uint8_t page) {
+  TextBuffer<16> text;
+  clearAll();
+
+  switch (page) {
+    case 0:   // vertikal: (16-5)/2 = 5
+      text.appendFloat(reading.temperature, 1).append("*C");
+      drawTextCentered(text.c_str(), 6, CRGB::Green);
+      break;
+    case 1:
+      text.appendInt(reading.humidity).append('%');
+      drawTextCentered(text.c_str(), 6, CRGB::Yellow);
+      break;
+    default:
+      text.appendFloat(reading.windSpeed, 1).append("m/s");
+      drawTextCentered(text.c_str(), 6, CRGB::Blue);
+      break;
+  }
+}
+
+// Anzeige - zentriert und kompakt. Gezeichnet wird nur, wenn die Seite
+// wechselt oder eine neue Messung veröffentlicht wurde; eine neue Messung
+// ist damit nach spätestens DISPLAY_POLL_MS zu sehen.
 void updateDisplay(void *pvParameters) {
-  // Warten bis erste Daten da sind
-  while (!dataReceived) {
+  SnapshotReader<WeatherReading> reader(weatherReading);
+  WeatherReading reading;
+
+  // Warten bis erste Daten da sind (entfällt, wenn der Cache etwas hatte)
+  if (!reader.poll(reading)) {
     clearAll();
     // "---" anzeigen waehrend geladen wird
     drawTextCentered("---", 6, CRGB(80, 80, 80));
     FastLED.show();
-    vTaskDelay(500 / portTICK_PERIOD_MS);
+    while (!reader.poll(reading)) {
+      vTaskDelay(DISPLAY_POLL_MS / portTICK_PERIOD_MS);
+    }
   }
 
-  while (true) {
-    char buffer[16];
+  uint8_t page = 0;
+  uint32_t pageStartMs = millis();
+  bool dirty = true;
 
-    // === Temperatur (zentriert, vertikal: (16-5)/2 = 5) ===
-    clearAll();
-    if (temperature < 0) {
-      snprintf(buffer, sizeof(buffer), "-%.1f*C", -temperature);
-    } else {
-      snprintf(buffer, sizeof(buffer), "%.1f*C", temperature);
+  while (true) {
+    if (reader.poll(reading)) dirty = true;
+    if (millis() - pageStartMs >= READING_PAGE_MS) {
+      page = (page + 1) % READING_PAGES;
+      pageStartMs += READING_PAGE_MS;
+      dirty = true;
     }
-    drawTextCentered(String(buffer), 6, CRGB::Green);
-    FastLED.show();
-    vTaskDelay(3000 / portTICK_PERIOD_MS);
-
-    // === Luftfeuchtigkeit (zentriert) ===
-    clearAll();
-    snprintf(buffer, sizeof(buffer), "%d%%", humidity);
-    drawTextCentered(String(buffer), 6, CRGB::Yellow);
-    FastLED.show();
-    vTaskDelay(3000 / portTICK_PERIOD_MS);
 
-    // === Windgeschwindigkeit (zentriert) ===
-    clearAll();
-    snprintf(buffer, sizeof(buffer), "%.1fm/s", windSpeed);
-    drawTextCentered(String(buffer), 6, CRGB::Blue);
-    FastLED.show();
-    vTaskDelay(3000 / portTICK_PERIOD_MS);
+    if (dirty) {
+      drawReading(reading, page);
+      FastLED.show();
+      dirty = false;
+    }
+    vTaskDelay(DISPLAY_POLL_MS / portTICK_PERIOD_MS);
   }
 }
 
 void setup() {
   Serial.begin(115200);
+  logInit();
   delay(100);
 
   FastLED.addLeds<WS2812B, DATA_PIN_UPPER, GRB>(leds_upper, NUM_LEDS_PER_STRIP);
@@ -316,12 +406,17 @@ void setup() {
   clearAll();
   FastLED.show();
 
+  // Letzte Messung sofort zeigen, noch bevor das WLAN steht
+  if (loadWeatherCache()) {
+    WeatherReading reading = weatherReading.read();
+    logLine("Wetter aus Cache: %.1f°C, Messung von %lu", reading.temperature, reading.observedAt);
+  }
+  xTaskCreatePinnedToCore(updateDisplay, "DisplayTask", 4096, NULL, 1, NULL, 1);
+
   // WLAN verbinden
   connectWiFi();
 
-  // FreeRTOS Tasks
   xTaskCreatePinnedToCore(fetchWeatherData, "WeatherTask", 8192, NULL, 1, NULL, 1);
-  xTaskCreatePinnedToCore(updateDisplay, "DisplayTask", 4096, NULL, 1, NULL, 1);
 }
 
 void loop() {
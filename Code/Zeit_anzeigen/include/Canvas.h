@@ -0,0 +1,197 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+// Pixelformate für Canvas<>. Indizierte Formate speichern pro Pixel nur
+// einen Palettenindex; die Farbe wird erst beim Blit auf die LEDs
+// nachgeschlagen (Canvas::color()).
+struct PixelRGB888 {
+  static constexpr uint8_t  BITS   = 24;
+  static constexpr uint16_t COLORS = 0;      // keine Palette
+};
+
+struct PixelIndexed8 {
+  static constexpr uint8_t  BITS   = 8;
+  static constexpr uint16_t COLORS = 256;
+};
+
+struct PixelIndexed4 {
+  static constexpr uint8_t  BITS   = 4;
+  static constexpr uint16_t COLORS = 16;     // zwei Pixel pro Byte, linkes im oberen Nibble
+};
+
+/**
+ * Zeilenweiser Canvas (wie HORIZONTAL_MATRIX) mit wählbarem Pixelformat.
+ *
+ * Bei indizierten Formaten baut set() die Palette selbst auf: bekannte
+ * Farben bekommen ihren Index, neue den nächsten freien, bei voller
+ * Palette die ähnlichste vorhandene. clear() leert auch die Palette
+ * (Index 0 = schwarz), wer jeden Frame neu zeichnet, hat also pro Frame
+ * die volle Palette.
+ *
+ * Die Palette hält Farben als 0xRRGGBB, so ist die Suche ein Vergleich
+ * pro Eintrag. Speicher bei 64x16: RGB888 3072 B, Indexed8 1024 B +
+ * 1024 B Palette, Indexed4 512 B + 64 B Palette.
+ *
+ * Beispiel:
+ *   Canvas<64, 16, PixelIndexed4> canvas;
+ *   canvas.clear();
+ *   canvas.set(3, 4, CRGB::Red);
+ *   BoardLayout::blit(canvas, leds);   // Palette wird erst hier aufgelöst
+ */
+template<uint16_t Width, uint16_t Height, typename Format = PixelRGB888>
+class Canvas {
+public:
+  static constexpr uint16_t WIDTH   = Width;
+  static constexpr uint16_t HEIGHT  = Height;
+  static constexpr uint16_t PIXELS  = Width * Height;
+  static constexpr bool     INDEXED = Format::COLORS > 0;
+  static constexpr size_t   BYTES   = INDEXED ? (size_t)PIXELS * Format::BITS / 8 + Format::COLORS * sizeof(uint32_t)
+                                              : (size_t)PIXELS * sizeof(CRGB);
+
+  static_assert(!INDEXED || (PIXELS * Format::BITS) % 8 == 0, "Canvas endet mitten in einem Byte");
+
+  Canvas() { clear(); }
+
+  void clear() {
+    if constexpr (INDEXED) {
+      memset(indices, 0, sizeof(indices));
+      palette[0] = 0;   // schwarz
+      paletteCount = 1;
+      memset(hints, 0, sizeof(hints));
+    } else {
+      fill_solid(pixels, PIXELS, CRGB::Black);
+    }
+  }
+
+  // x < WIDTH, y < HEIGHT prüft der Aufrufer
+  void set(uint16_t x, uint16_t y, const CRGB& color) {
+    const uint16_t i = y * Width + x;
+    if constexpr (INDEXED) {
+      setIndex(i, lookup(color));
+    } else {
+      pixels[i] = color;
+    }
+  }
+
+  CRGB get(uint16_t x, uint16_t y) const {
+    return color(y * Width + x);
+  }
+
+  // Farbe am zeilenweisen Index i, für den Blit
+  CRGB color(uint16_t i) const {
+    if constexpr (INDEXED) {
+      return CRGB(palette[indexAt(i)]);
+    } else {
+      return pixels[i];
+    }
+  }
+
+  // count Pixel der Zeile y ab Spalte 0 setzen
+  void setRow(uint16_t y, const CRGB* line, uint16_t count) {
+    if constexpr (INDEXED) {
+      for (uint16_t x = 0; x < count; x++) set(x, y, line[x]);
+    } else {
+      memcpy(pixels + y * Width, line, count * sizeof(CRGB));
+    }
+  }
+
+  // Nicht-schwarze Pixel der Zeile y (Spalten 0 .. count-1) über line
+  // legen, bei alpha < 255 anteilig gemischt. Schwarz ist durchsichtig;
+  // indiziert hat es immer Index 0, die Farbe muss also nicht geprüft werden.
+  void overlayRow(uint16_t y, CRGB* line, uint16_t count, uint8_t alpha = 255) const {
+    const uint16_t start = y * Width;
+    for (uint16_t x = 0; x < count; x++) {
+      CRGB c;
+      if constexpr (INDEXED) {
+        const uint8_t index = indexAt(start + x);
+        if (index == 0) continue;
+        c = CRGB(palette[index]);
+      } else {
+        c = pixels[start + x];
+        if (!c) continue;
+      }
+      line[x] = alpha == 255 ? c : blend(line[x], c, alpha);
+    }
+  }
+
+  // Belegte Paletteneinträge (RGB888: 0)
+  uint16_t colorsUsed() const {
+    if constexpr (INDEXED) {
+      return paletteCount;
+    } else {
+      return 0;
+    }
+  }
+
+  // FNV-1a über die Farben eines Ausschnitts
+  uint32_t hash(uint16_t x0, uint16_t y0, uint16_t w, uint16_t h) const {
+    uint32_t value = 2166136261u;
+    for (uint16_t y = y0; y < y0 + h; y++) {
+      for (uint16_t x = x0; x < x0 + w; x++) {
+        const CRGB c = color(y * Width + x);
+        value = (value ^ c.r) * 16777619u;
+        value = (value ^ c.g) * 16777619u;
+        value = (value ^ c.b) * 16777619u;
+      }
+    }
+    return value;
+  }
+
+private:
+  static constexpr uint16_t INDEX_BYTES  = INDEXED ? PIXELS * Format::BITS / 8 : 1;
+  static constexpr uint16_t PIXEL_COUNT  = INDEXED ? 1 : PIXELS;
+  static constexpr uint16_t PALETTE_SIZE = INDEXED ? Format::COLORS : 1;
+
+  CRGB pixels[PIXEL_COUNT];
+  uint8_t indices[INDEX_BYTES];
+  uint32_t palette[PALETTE_SIZE];   // 0xRRGGBB
+  uint16_t paletteCount;
+  uint8_t hints[INDEXED ? 32 : 1];   // Farbe (gestreut) → zuletzt gefundener Index
+
+  uint8_t indexAt(uint16_t i) const {
+    if constexpr (Format::BITS == 4) {
+      return (i & 1) ? indices[i >> 1] & 0x0F : indices[i >> 1] >> 4;
+    } else {
+      return indices[i];
+    }
+  }
+
+  void setIndex(uint16_t i, uint8_t index) {
+    if constexpr (Format::BITS == 4) {
+      uint8_t& pair = indices[i >> 1];
+      pair = (i & 1) ? (pair & 0xF0) | index : (pair & 0x0F) | (index << 4);
+    } else {
+      indices[i] = index;
+    }
+  }
+
+  uint8_t lookup(const CRGB& color) {
+    const uint32_t code = ((uint32_t)color.r << 16) | ((uint32_t)color.g << 8) | color.b;
+    uint8_t& hint = hints[(code * 2654435761u) >> 27];
+    if (palette[hint] == code) return hint;
+
+    for (uint16_t i = 0; i < paletteCount; i++) {
+      if (palette[i] == code) return hint = i;
+    }
+    if (paletteCount < PALETTE_SIZE) {
+      palette[paletteCount] = code;
+      return hint = paletteCount++;
+    }
+
+    // Palette voll: ähnlichste Farbe (Summe der Kanalabstände)
+    uint16_t best = 0;
+    uint16_t bestDistance = 0xFFFF;
+    for (uint16_t i = 0; i < paletteCount; i++) {
+      const CRGB entry(palette[i]);
+      const uint16_t distance = abs(entry.r - color.r) + abs(entry.g - color.g) +
+                                abs(entry.b - color.b);
+      if (distance < bestDistance) {
+        bestDistance = distance;
+        best = i;
+      }
+    }
+    return hint = best;
+  }
+};
@@ -3,9 +3,13 @@
 #include "MenuItem.h"
 #include "DisplayManager.h"
 #include <WiFi.h>
+#include <WlanManager.h>
 #include <time.h>
-#include <LEDText.h>
 #include <FontMatrise.h>
+#include <TextStrip.h>
+
+#define CLOCK_SCROLL_PX_PER_SEC  16   // unabhängig davon, wie oft update() läuft
+#define TIME_Y_OFFSET            4    // Zeit in den Zeilen 4-11
 
 class ClockApp : public BaseApp {
 private:
@@ -16,23 +20,25 @@ private:
   const int daylightOffsetSec = 0;
   const char* ntpServer1 = "pool.ntp.org";
   const char* ntpServer2 = "time.nist.gov";
-  cLEDText scrollingText;
-  CRGB canvas8Leds[64 * 8];
-  cLEDMatrix<64, 8, HORIZONTAL_MATRIX>* canvas8;
-  unsigned long lastUpdate;
+  TextStrip scrollingText;
   unsigned long lastTimeUpdate;
   int lastMinute;
   char timeBuffer[64];
-  bool wifiConnected;
-  bool ntpSynced;
+  bool ntpStarted;
+
+  // Ziel für TextStrip::drawTo(): Textzeilen ab TIME_Y_OFFSET ins Display
+  struct TextTarget {
+    DisplayManager* display;
+    uint8_t y;
+    void row(uint8_t row) { y = TIME_Y_OFFSET + row; }
+    void put(uint8_t x, const CRGB& color) { display->setPixel(x, y, color); }
+  };
 
-  void connectToWifi();
-  void initTimeNtp();
+  void initTimeNtpIfNeeded();
   void updateTimeText();
 
 public:
   ClockApp(const char* ssid, const char* password);
-  ~ClockApp();
   void init() override;
   void update() override;
   void render() override;
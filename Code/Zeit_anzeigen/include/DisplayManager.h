@@ -2,46 +2,116 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
-#include <LEDMatrix.h>
+#include <atomic>
+#include "Canvas.h"
+#include "Layers.h"
+#include <PanelLayout.h>
+#include "LedOutput.h"
+
+// Board-Aufbau: Kachelgröße, Raster, Datenpin und Ausrichtung je Kachel.
+// Für größere Boards nur hier weitere Tile<>-Einträge ergänzen.
+typedef PanelLayout<32, 8, 1, 2,
+                    Tile<25>,     // Zeilen 0-7
+                    Tile<26>      // Zeilen 8-15
+                   > BoardLayout;
 
 // Display-Konfiguration
-#define PIN_TOP         25
-#define PIN_BOTTOM      26
-#define PANEL_WIDTH     32
-#define PANEL_HEIGHT    8
-#define LEDS_PER_PANEL  (PANEL_WIDTH * PANEL_HEIGHT)
-#define CANVAS_WIDTH    64
-#define CANVAS_HEIGHT   16
+#define PANEL_COUNT     BoardLayout::TILE_COUNT
+#define LEDS_PER_PANEL  BoardLayout::LEDS_PER_TILE
+#define CANVAS_WIDTH    64  // mind. BoardLayout::WIDTH, Apps zeichnen 64 breit
+#define CANVAS_HEIGHT   BoardLayout::HEIGHT
 #define BRIGHTNESS      80  // Erhöht für bessere Sichtbarkeit (war 25)
 #define COLOR_ORDER     GRB
 #define CHIPSET         WS2812
 
+// Ausgabe-Task (LedOutput::show() läuft nicht im Render-Thread)
+#define FRAME_BUFFERS         3   // back (Render), ready (fertig), front (Ausgabe)
+#define OUTPUT_TASK_CORE      0   // menuTask / loop() laufen auf Core 1
+#define OUTPUT_TASK_PRIORITY  2
+#define OUTPUT_TASK_STACK     2048
+
+// Ebenen: clear()/setPixel() zeichnen in die Basis-Ebene, weitere Ebenen
+// legt createLayer() an (z kleiner = weiter unten)
+#define DISPLAY_MAX_LAYERS    4
+#define DISPLAY_BASE_Z        10
+
+static_assert(PANEL_COUNT <= 8, "Dirty-Maske hat nur 8 Bit");
+
+// Pixelformat der Ebenen: PixelRGB888 (3 KB), PixelIndexed8 (1 KB + Palette)
+// oder PixelIndexed4 (512 B + Palette, 16 Farben pro Ebene). Gemischt wird
+// in ein RGB-Bild in Board-Breite, die Panel-Puffer bleiben RGB.
+typedef Canvas<CANVAS_WIDTH, CANVAS_HEIGHT, PixelIndexed4> BoardCanvas;
+typedef Canvas<BoardLayout::WIDTH, CANVAS_HEIGHT, PixelRGB888> ComposedCanvas;
+typedef LayerStack<BoardCanvas, ComposedCanvas, DISPLAY_MAX_LAYERS> BoardLayers;
+typedef BoardLayers::Layer BoardLayer;
+
+// Ein fertig gemapptes Bild für alle Panels, Panel i ab i * LEDS_PER_PANEL.
+// dirty: Bit i = Panel i muss raus, wenn die Ausgabe dieses Bild übernimmt.
+struct PanelFrame {
+  CRGB leds[BoardLayout::LED_COUNT];
+  uint8_t dirty;
+};
+
 class DisplayManager {
 private:
   static DisplayManager* instance;
-  CRGB ledsTop[LEDS_PER_PANEL];
-  CRGB ledsBottom[LEDS_PER_PANEL];
-  CRGB canvasLeds[CANVAS_WIDTH * CANVAS_HEIGHT];
-  cLEDMatrix<PANEL_WIDTH, PANEL_HEIGHT, VERTICAL_ZIGZAG_MATRIX>* panelTop;
-  cLEDMatrix<PANEL_WIDTH, PANEL_HEIGHT, VERTICAL_ZIGZAG_MATRIX>* panelBottom;
-  cLEDMatrix<CANVAS_WIDTH, CANVAS_HEIGHT, HORIZONTAL_MATRIX>* canvas;
+
+  // Ebenen und ihr gemischtes Bild; show() mischt nur geänderte Zeilen
+  BoardLayer baseLayer;
+  BoardLayers layers;
+  ComposedCanvas composed;
   bool initialized;
+  LedOutput* output;
+  uint8_t brightness;
+
+  // Dreifach-Puffer: show() mappt in frames[backIndex] und tauscht ihn gegen
+  // den "ready"-Slot, der Ausgabe-Task tauscht "ready" gegen frames[frontIndex].
+  // Keiner der beiden wartet auf den anderen, und die Ausgabe liest nie einen
+  // Puffer, in den gerade geschrieben wird. Die Dirty-Maske reist mit dem
+  // Bild, damit Maske und Pixel immer zum selben Frame gehören.
+  PanelFrame frames[FRAME_BUFFERS];
+  uint8_t backIndex;                  // nur Render-Thread
+  uint8_t frontIndex;                 // nur Ausgabe-Task
+  std::atomic<uint8_t> readyState;    // Index des fertigen Puffers | READY_NEW
+  TaskHandle_t outputTaskHandle;
+
+  // Dirty-Tracking: Hash des sichtbaren Canvas-Bereichs je Panel
+  uint32_t panelHash[PANEL_COUNT];
+  bool forceRedraw;
+
+  // Statistik (nur Render-Thread schreibt)
+  uint32_t framesPushed;
+  uint32_t framesSkipped;
+  uint32_t panelPushes[PANEL_COUNT];
+
+  static const uint8_t READY_INDEX_MASK = 0x03;
+  static const uint8_t READY_NEW        = 0x80;
+
   DisplayManager();
-  void mirrorPanelHorizontal(cLEDMatrix<PANEL_WIDTH, PANEL_HEIGHT, VERTICAL_ZIGZAG_MATRIX>* panel);
-  void rotatePanel180(cLEDMatrix<PANEL_WIDTH, PANEL_HEIGHT, VERTICAL_ZIGZAG_MATRIX>* panel);
+  uint32_t hashPanelRegion(uint8_t panel) const;
+  uint8_t collectDirtyPanels(uint32_t changedRows);
+  void publishFrame(uint8_t dirty);
+  bool acquireFrame();
+  static void outputTask(void* parameter);
 
 public:
   static DisplayManager* getInstance();
-  void init();
+  void init(OutputBackend backend = OutputBackend::LED_OUTPUT_BACKEND);
   void clear();
-  void show();
+  void show();                // mischt, mappt und übergibt an den Ausgabe-Task, blockiert nicht
+  void invalidate();          // nächstes show() schiebt alle Panels raus
   void setBrightness(uint8_t brightness);
-  CRGB& pixel(uint8_t x, uint8_t y);
+  CRGB getPixel(uint8_t x, uint8_t y) const;
   void setPixel(uint8_t x, uint8_t y, CRGB color);
   void fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, CRGB color);
   void updatePanels();
   uint8_t getWidth() const { return CANVAS_WIDTH; }
   uint8_t getHeight() const { return CANVAS_HEIGHT; }
-  cLEDMatrix<CANVAS_WIDTH, CANVAS_HEIGHT, HORIZONTAL_MATRIX>* getCanvas() { return canvas; }
+  BoardLayer* getBaseLayer() { return &baseLayer; }
+  BoardLayer* createLayer(uint8_t z);   // nullptr, wenn DISPLAY_MAX_LAYERS erreicht
+  LedOutput* getOutput() { return output; }
+  uint32_t getFramesPushed() const { return framesPushed; }
+  uint32_t getFramesSkipped() const { return framesSkipped; }
+  uint32_t getPanelPushes(uint8_t panel) const { return panel < PANEL_COUNT ? panelPushes[panel] : 0; }
   ~DisplayManager();
 };
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "LedOutput.h"
+
+// Ausgabe über FastLED: ein Controller pro Kachel aus Layout.
+// Die Datenpins sind bei FastLED Template-Parameter, deshalb kommt das
+// Layout als Typ herein statt über die pins-Liste in begin().
+template<typename Layout,
+         template<uint8_t DATA_PIN, EOrder RGB_ORDER> class Chipset,
+         EOrder ColorOrder>
+class FastLedOutput : public LedOutput {
+private:
+  struct AddControllers {
+    CRGB* leds;
+
+    template<typename PanelTile>
+    void visit(uint8_t index) {
+      FastLED.addLeds<Chipset, PanelTile::pin, ColorOrder>(
+        leds + index * Layout::LEDS_PER_TILE, Layout::LEDS_PER_TILE);
+    }
+  };
+
+public:
+  void begin(CRGB* leds, const uint8_t* pins,
+             uint8_t stringCount, uint16_t ledsPerString) override {
+    AddControllers controllers = { leds };
+    Layout::forEachTile(controllers);
+  }
+
+  void show(const CRGB* leds, uint8_t mask, uint8_t brightness) override {
+    CRGB* data = const_cast<CRGB*>(leds);
+    for (uint8_t i = 0; i < Layout::TILE_COUNT; i++) {
+      FastLED[i].setLeds(data + i * Layout::LEDS_PER_TILE, Layout::LEDS_PER_TILE);
+    }
+
+    // Immer alle Controller: der RMT-Treiber von FastLED 3.6 sendet erst,
+    // wenn jeder angemeldete Controller show aufgerufen hat. Ein einzelnes
+    // showLeds() bliebe liegen und ginge erst mit dem nächsten Push raus,
+    // mit altem Bild im anderen Panel. Einzelne Panels schiebt nur
+    // RMT_PARALLEL raus. Auf der Hardware nicht nachgemessen.
+    if (mask == 0) return;
+    FastLED.setBrightness(brightness);
+    FastLED.show();
+  }
+
+  const char* getName() const override { return "FastLED"; }
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+/**
+ * Eine Zeichenebene für den DisplayManager: eigener Canvas, Position im
+ * Stapel (z, höher liegt oben), Deckkraft und Sichtbarkeit.
+ *
+ * Schwarz ist durchsichtig (Farbschlüssel), darunter liegende Ebenen
+ * scheinen dort durch – wie früher, als alles nacheinander in denselben
+ * Canvas gezeichnet wurde. Mit alpha < 255 wird jedes gesetzte Pixel mit
+ * dem darunter liegenden Bild gemischt.
+ *
+ * Jede Ebene merkt sich, welche Zeilen sich seit dem letzten Mischen
+ * geändert haben (dirtyRows) und in welchen überhaupt etwas steht
+ * (contentRows). clear() macht nur die belegten Zeilen schmutzig, eine
+ * Ebene, die niemand anfasst, kostet beim Mischen also nichts.
+ */
+template<typename CanvasType>
+class DisplayLayer {
+public:
+  static_assert(CanvasType::HEIGHT <= 32, "Zeilenmasken haben nur 32 Bit");
+
+  explicit DisplayLayer(uint8_t z = 0)
+    : z(z), alpha(255), visible(true), contentRows(0), dirtyRows(0) {}
+
+  void clear() {
+    dirtyRows |= contentRows;
+    contentRows = 0;
+    canvas.clear();
+  }
+
+  void setPixel(uint16_t x, uint16_t y, const CRGB& color) {
+    if (x >= CanvasType::WIDTH || y >= CanvasType::HEIGHT) return;
+    canvas.set(x, y, color);
+    dirtyRows |= 1u << y;
+    if (color) contentRows |= 1u << y;
+  }
+
+  void fillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const CRGB& color) {
+    for (uint16_t j = y; j < y + h && j < CanvasType::HEIGHT; j++) {
+      for (uint16_t i = x; i < x + w && i < CanvasType::WIDTH; i++) {
+        setPixel(i, j, color);
+      }
+    }
+  }
+
+  CRGB getPixel(uint16_t x, uint16_t y) const {
+    if (x >= CanvasType::WIDTH || y >= CanvasType::HEIGHT) return CRGB::Black;
+    return canvas.get(x, y);
+  }
+
+  void setVisible(bool visible) {
+    if (visible == this->visible) return;
+    this->visible = visible;
+    dirtyRows |= contentRows;
+  }
+
+  void setAlpha(uint8_t alpha) {
+    if (alpha == this->alpha) return;
+    this->alpha = alpha;
+    dirtyRows |= contentRows;
+  }
+
+  // Beim nächsten Mischen alle belegten Zeilen neu
+  void invalidate() { dirtyRows |= contentRows; }
+
+  uint8_t getZ() const { return z; }
+  uint8_t getAlpha() const { return alpha; }
+  bool isVisible() const { return visible; }
+  bool isDirty() const { return dirtyRows != 0; }
+  uint32_t getContentRows() const { return contentRows; }
+  const CanvasType& pixels() const { return canvas; }
+
+  // Für LayerStack::compose(): geänderte Zeilen abholen
+  uint32_t takeDirtyRows() {
+    const uint32_t rows = dirtyRows;
+    dirtyRows = 0;
+    return rows;
+  }
+
+private:
+  CanvasType canvas;
+  uint8_t z;
+  uint8_t alpha;
+  bool visible;
+  uint32_t contentRows;   // Bit y = Zeile y enthält nicht-schwarze Pixel
+  uint32_t dirtyRows;     // Bit y = Zeile y seit dem letzten Mischen geändert
+};
+
+/**
+ * Stapel aus höchstens MaxLayers Ebenen, nach z sortiert. compose()
+ * mischt nur die Zeilen neu in den Ausgabe-Canvas, die sich in einer
+ * Ebene geändert haben; alle anderen Zeilen bleiben, wie sie sind.
+ *
+ * Der Ausgabe-Canvas ist nur so breit wie das Board, Ebenen dürfen
+ * breiter sein (Apps zeichnen 64 breit).
+ *
+ * Beispiel:
+ *   LayerStack<BoardCanvas, ComposedCanvas, 4> layers;
+ *   layers.add(&border);                 // z = 0
+ *   layers.add(&menu);                   // z = 20
+ *   uint32_t rows = layers.compose(out);   // 0 = Bild unverändert
+ */
+template<typename LayerCanvas, typename OutputCanvas, uint8_t MaxLayers>
+class LayerStack {
+public:
+  typedef DisplayLayer<LayerCanvas> Layer;
+
+  static_assert(LayerCanvas::WIDTH >= OutputCanvas::WIDTH, "Ebene schmaler als die Ausgabe");
+  static_assert(LayerCanvas::HEIGHT == OutputCanvas::HEIGHT, "Ebene und Ausgabe verschieden hoch");
+
+  static constexpr uint32_t ALL_ROWS = OutputCanvas::HEIGHT >= 32 ? 0xFFFFFFFFu
+                                     : (1u << OutputCanvas::HEIGHT) - 1;
+
+  LayerStack() : count(0), pendingRows(ALL_ROWS) {}
+
+  /**
+   * @brief Ebene einsortieren (bei gleichem z über die vorhandenen).
+   * @return false, wenn der Stapel voll ist
+   */
+  bool add(Layer* layer) {
+    if (count >= MaxLayers) return false;
+    uint8_t i = count;
+    while (i > 0 && layers[i - 1]->getZ() > layer->getZ()) {
+      layers[i] = layers[i - 1];
+      i--;
+    }
+    layers[i] = layer;
+    count++;
+    pendingRows |= layer->getContentRows();
+    return true;
+  }
+
+  // Nächstes compose() mischt alle Zeilen neu
+  void invalidate() { pendingRows = ALL_ROWS; }
+
+  /**
+   * @brief Geänderte Zeilen aller Ebenen von unten nach oben mischen.
+   * @return Maske der neu gemischten Zeilen
+   */
+  uint32_t compose(OutputCanvas& out) {
+    uint32_t rows = pendingRows;
+    pendingRows = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      rows |= layers[i]->takeDirtyRows();
+    }
+    rows &= ALL_ROWS;
+
+    for (uint32_t remaining = rows; remaining != 0; remaining &= remaining - 1) {
+      composeRow(out, __builtin_ctz(remaining));
+    }
+    return rows;
+  }
+
+  uint8_t size() const { return count; }
+
+private:
+  Layer* layers[MaxLayers];
+  uint8_t count;
+  uint32_t pendingRows;
+
+  void composeRow(OutputCanvas& out, uint8_t y) {
+    CRGB line[OutputCanvas::WIDTH];
+    fill_solid(line, OutputCanvas::WIDTH, CRGB::Black);
+
+    const uint32_t row = 1u << y;
+    for (uint8_t i = 0; i < count; i++) {
+      const Layer& layer = *layers[i];
+      if (!layer.isVisible() || !(layer.getContentRows() & row)) continue;
+
+      layer.pixels().overlayRow(y, line, OutputCanvas::WIDTH, layer.getAlpha());
+    }
+    out.setRow(y, line, OutputCanvas::WIDTH);
+  }
+};
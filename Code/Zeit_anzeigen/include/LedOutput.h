@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+// WS2812B-Timing laut Datenblatt (T0H/T1H 0,4/0,8 µs ± 150 ns). Der
+// RMT-Treiber baut seine Pulse aus denselben Werten, das Zeitmodell
+// rechnet damit: 24 Bit à 1,25 µs pro LED, danach Reset-Pause.
+#define WS2812_T0H_NS       400
+#define WS2812_T0L_NS       850
+#define WS2812_T1H_NS       800
+#define WS2812_T1L_NS       450
+#define WS2812_BIT_NS       (WS2812_T0H_NS + WS2812_T0L_NS)
+#define WS2812_US_PER_LED   ((24 * WS2812_BIT_NS + 999) / 1000)
+#define WS2812_RESET_US     280
+
+static_assert(WS2812_T1H_NS + WS2812_T1L_NS == WS2812_BIT_NS,
+              "0- und 1-Bit müssen gleich lang sein");
+
+// Auswahl in DisplayManager::init()
+enum class OutputBackend {
+  FASTLED,        // ein FastLED-Controller pro Panel
+  RMT_PARALLEL,   // eigener RMT-Treiber, alle Datenleitungen gleichzeitig (nur ESP32)
+  TIMING_MODEL    // keine Hardware: kodiert und rechnet die Drahtzeit aus
+};
+
+// Ausgabe, wenn init() keine vorgibt; per Build-Flag wählbar, z. B.
+//   build_flags = -DLED_OUTPUT_BACKEND=RMT_PARALLEL
+#ifndef LED_OUTPUT_BACKEND
+#define LED_OUTPUT_BACKEND FASTLED
+#endif
+
+// Basis-Klasse für alle LED-Ausgaben.
+// Ein String ist eine Datenleitung (= ein Panel); die LEDs von String i
+// liegen in leds ab i * ledsPerString.
+class LedOutput {
+public:
+  virtual ~LedOutput() {}
+  virtual void begin(CRGB* leds, const uint8_t* pins,
+                     uint8_t stringCount, uint16_t ledsPerString) = 0;
+  // Schiebt alle Strings aus mask (Bit i = String i) raus und kehrt zurück,
+  // wenn der letzte fertig ist
+  virtual void show(const CRGB* leds, uint8_t mask, uint8_t brightness) = 0;
+  virtual const char* getName() const = 0;
+
+  // Drahtzeit eines Strings in µs inkl. Reset
+  static uint32_t wireTimeUs(uint16_t ledCount) {
+    return (uint32_t)ledCount * WS2812_US_PER_LED + WS2812_RESET_US;
+  }
+
+  // CRGB → Bytes in GRB-Reihenfolge, Helligkeit wie scale8() in FastLED
+  static void encodeGRB(const CRGB* leds, uint16_t count,
+                        uint8_t brightness, uint8_t* out) {
+    const uint16_t scale = (uint16_t)brightness + 1;
+    for (uint16_t i = 0; i < count; i++) {
+      *out++ = (leds[i].g * scale) >> 8;
+      *out++ = (leds[i].r * scale) >> 8;
+      *out++ = (leds[i].b * scale) >> 8;
+    }
+  }
+};
@@ -4,13 +4,17 @@
 #include <vector>
 #include "MenuItem.h"
 #include "DisplayManager.h"
-#include "Joystick/Joystick.h"
+#include <InputSampler.h>
 
 // Neue Display-Bereiche
 #define BORDER_ROW 0           // Oberste Zeile für weißen Rand
 #define TIME_START_ROW 4       // Zeit-Anzeige mittig (Zeilen 4-10)
 #define MENU_START_ROW 12      // Menü unten (Zeilen 12-15)
 
+// Ebenen: Rand unter den Apps (die Basis-Ebene, DISPLAY_BASE_Z), Menü darüber
+#define BORDER_LAYER_Z 0
+#define MENU_LAYER_Z   20
+
 class MenuManager {
 private:
   std::vector<MenuItem> menuItems;
@@ -18,29 +22,30 @@ private:
   AppState currentState;
   BaseApp* currentApp;
   DisplayManager* display;
-  Joystick* joystick;
+  BoardLayer* borderLayer;       // einmal in init() gezeichnet
+  BoardLayer* menuLayer;         // nur neu, wenn sich das Menü bewegt
+  QueueHandle_t inputEvents;     // von InputSampler, nur dieser Task liest
   unsigned long lastUpdate;
-  unsigned long lastNavigationTime;
-  bool joystickMoved;
   bool menuVisible;              // Menü sichtbar oder versteckt
   int menuScrollOffset;          // Für scrollendes PlayStation-Style Menü
   float menuAnimationOffset;     // Für sanfte Animation
+  int drawnMenuOffset;           // Stand der Menü-Ebene: gerundeter Offset
+  int drawnSelectedIndex;        // und Auswahl, -1 = neu zeichnen
 
   static const unsigned long MENU_UPDATE_INTERVAL = 50;
-  static const unsigned long JOYSTICK_DEBOUNCE = 200;
-  static const unsigned long LONG_PRESS_DURATION = 1000; // 1 Sekunde für langen Druck
 
   void drawBorderRow();
   void drawTime();
   void drawMenu();
-  void drawMenuItem(int index, float xOffset, bool selected);
-  void handleNavigation();
+  void drawMenuItem(int index, int startX, bool selected);
+  void handleInput(const InputEvent& event);
+  void handleNavigation(const InputEvent& event);
   void handleMenuToggle();
   void enterSelectedApp();
   void exitCurrentApp();
 
 public:
-  MenuManager(Joystick* joystick);
+  MenuManager(QueueHandle_t inputEvents);
   void init();
   void addMenuItem(const char* name, BaseApp* app, bool enabled = true);
   void update();
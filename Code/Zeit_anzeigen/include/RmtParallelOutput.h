@@ -0,0 +1,29 @@
+#pragma once
+
+#include "LedOutput.h"
+
+#ifdef ESP32
+
+#define RMT_OUTPUT_MAX_STRINGS  8   // RMT-Kanäle des ESP32
+
+// Eigener WS2812-Treiber auf dem RMT-Peripheral: jeder String bekommt einen
+// Kanal, alle Kanäle werden gestartet, bevor auf den ersten gewartet wird.
+// Die Bildzeit hängt damit vom längsten String ab, nicht von der Summe.
+// Die Bytes werden im RMT-Interrupt in Pulse übersetzt (rmt_translator),
+// RAM-Bedarf ist also nur 3 Byte pro LED.
+class RmtParallelOutput : public LedOutput {
+private:
+  uint8_t stringCount;
+  uint16_t ledsPerString;
+  uint8_t* encoded[RMT_OUTPUT_MAX_STRINGS];
+
+public:
+  RmtParallelOutput();
+  ~RmtParallelOutput();
+  void begin(CRGB* leds, const uint8_t* pins,
+             uint8_t stringCount, uint16_t ledsPerString) override;
+  void show(const CRGB* leds, uint8_t mask, uint8_t brightness) override;
+  const char* getName() const override { return "RMT parallel"; }
+};
+
+#endif
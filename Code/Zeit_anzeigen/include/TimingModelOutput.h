@@ -0,0 +1,38 @@
+#pragma once
+
+#include "LedOutput.h"
+
+#define TIMING_MODEL_MAX_STRINGS  8
+
+// Ausgabe ohne Hardware: kodiert die Strings genau wie RmtParallelOutput
+// und rechnet aus, wie lange der Draht belegt wäre. Damit lassen sich
+// Scheduling (welche Strings, parallel vs. nacheinander) und Kodierung
+// auf dem Host prüfen.
+class TimingModelOutput : public LedOutput {
+private:
+  uint8_t stringCount;
+  uint16_t ledsPerString;
+  uint8_t* encoded[TIMING_MODEL_MAX_STRINGS];
+
+  uint8_t lastMask;
+  uint32_t lastFrameUs;        // parallel: längster String
+  uint32_t lastSequentialUs;   // Vergleich: alle Strings nacheinander
+  uint32_t frameCount;
+  uint64_t totalWireUs;
+
+public:
+  TimingModelOutput();
+  ~TimingModelOutput();
+  void begin(CRGB* leds, const uint8_t* pins,
+             uint8_t stringCount, uint16_t ledsPerString) override;
+  void show(const CRGB* leds, uint8_t mask, uint8_t brightness) override;
+  const char* getName() const override { return "Timing model"; }
+
+  const uint8_t* getEncoded(uint8_t string) const;
+  uint16_t getEncodedSize() const { return ledsPerString * 3; }
+  uint8_t getLastMask() const { return lastMask; }
+  uint32_t getLastFrameUs() const { return lastFrameUs; }
+  uint32_t getLastSequentialUs() const { return lastSequentialUs; }
+  uint32_t getFrameCount() const { return frameCount; }
+  uint64_t getTotalWireUs() const { return totalWireUs; }
+};
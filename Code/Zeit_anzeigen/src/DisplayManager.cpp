@@ -1,11 +1,23 @@
 #include "DisplayManager.h"
+#include "FastLedOutput.h"
+#include "RmtParallelOutput.h"
+#include "TimingModelOutput.h"
+#include <PixelLog.h>
 
 DisplayManager* DisplayManager::instance = nullptr;
 
-DisplayManager::DisplayManager() : initialized(false) {
-  panelTop = new cLEDMatrix<PANEL_WIDTH, PANEL_HEIGHT, VERTICAL_ZIGZAG_MATRIX>();
-  panelBottom = new cLEDMatrix<PANEL_WIDTH, PANEL_HEIGHT, VERTICAL_ZIGZAG_MATRIX>();
-  canvas = new cLEDMatrix<CANVAS_WIDTH, CANVAS_HEIGHT, HORIZONTAL_MATRIX>();
+DisplayManager::DisplayManager()
+  : baseLayer(DISPLAY_BASE_Z), initialized(false), output(nullptr), brightness(BRIGHTNESS), backIndex(1), frontIndex(0), readyState(2),
+    outputTaskHandle(nullptr), forceRedraw(true),
+    framesPushed(0), framesSkipped(0) {
+  for (uint8_t i = 0; i < PANEL_COUNT; i++) {
+    panelHash[i] = 0;
+    panelPushes[i] = 0;
+  }
+  for (uint8_t i = 0; i < FRAME_BUFFERS; i++) {
+    frames[i].dirty = 0;
+  }
+  layers.add(&baseLayer);
 }
 
 DisplayManager* DisplayManager::getInstance() {
@@ -15,114 +27,169 @@ DisplayManager* DisplayManager::getInstance() {
   return instance;
 }
 
-void DisplayManager::init() {
+void DisplayManager::init(OutputBackend backend) {
   if (initialized) return;
 
-  FastLED.addLeds<CHIPSET, PIN_TOP, COLOR_ORDER>(ledsTop, LEDS_PER_PANEL);
-  FastLED.addLeds<CHIPSET, PIN_BOTTOM, COLOR_ORDER>(ledsBottom, LEDS_PER_PANEL);
-  FastLED.setBrightness(BRIGHTNESS);
-  FastLED.clear(true);
+  switch (backend) {
+#ifdef ESP32
+    case OutputBackend::RMT_PARALLEL:
+      output = new RmtParallelOutput();
+      break;
+#endif
+    case OutputBackend::TIMING_MODEL:
+      output = new TimingModelOutput();
+      break;
+    default:
+      output = new FastLedOutput<BoardLayout, CHIPSET, COLOR_ORDER>();
+      break;
+  }
 
-  // KORRIGIERT: Top Panel = ledsTop, Bottom Panel = ledsBottom
-  panelTop->SetLEDArray(ledsTop);
-  panelBottom->SetLEDArray(ledsBottom);
-  canvas->SetLEDArray(canvasLeds);
+  // Alle Panels einmal dunkel schalten
+  PanelFrame& front = frames[frontIndex];
+  fill_solid(front.leds, BoardLayout::LED_COUNT, CRGB::Black);
+  output->begin(front.leds, BoardLayout::pins, PANEL_COUNT, LEDS_PER_PANEL);
+  output->show(front.leds, (1 << PANEL_COUNT) - 1, brightness);
+
+  xTaskCreatePinnedToCore(outputTask, "LedOutput", OUTPUT_TASK_STACK, this,
+                          OUTPUT_TASK_PRIORITY, &outputTaskHandle,
+                          OUTPUT_TASK_CORE);
 
   initialized = true;
-  Serial.println(F("DisplayManager initialisiert"));
-  Serial.print(F("  PIN_TOP (25): "));
-  Serial.print(LEDS_PER_PANEL);
-  Serial.println(F(" LEDs"));
-  Serial.print(F("  PIN_BOTTOM (26): "));
-  Serial.print(LEDS_PER_PANEL);
-  Serial.println(F(" LEDs"));
+  logLine("DisplayManager initialisiert, Ausgabe: %s", output->getName());
+  logLine("  %u Panels à %u LEDs, Board %ux%u, Ebene %u B, Bild %u B",
+          PANEL_COUNT, LEDS_PER_PANEL, BoardLayout::WIDTH, BoardLayout::HEIGHT,
+          (unsigned)BoardCanvas::BYTES, (unsigned)ComposedCanvas::BYTES);
+}
+
+// Ebenen werden einmal beim Aufbau angelegt und nie freigegeben
+BoardLayer* DisplayManager::createLayer(uint8_t z) {
+  BoardLayer* layer = new BoardLayer(z);
+  if (!layers.add(layer)) {
+    delete layer;
+    logLine("DisplayManager: keine Ebene mehr frei (max. %u)", DISPLAY_MAX_LAYERS);
+    return nullptr;
+  }
+  return layer;
 }
 
 void DisplayManager::clear() {
-  memset(canvasLeds, 0, sizeof(canvasLeds));
+  baseLayer.clear();
 }
 
 void DisplayManager::show() {
+  // Nur Zeilen, die sich in einer Ebene geändert haben, neu mischen
+  uint32_t changedRows = layers.compose(composed);
+  uint8_t dirty = changedRows != 0 || forceRedraw ? collectDirtyPanels(changedRows) : 0;
+  if (dirty == 0) {
+    // Identisches Bild: weder mappen noch ausgeben
+    framesSkipped++;
+    return;
+  }
+
+  // Gemappt wird immer komplett – der Back-Puffer kann ein älteres Bild
+  // enthalten, nur die Ausgabe beschränkt sich auf die geänderten Panels.
   updatePanels();
-  FastLED.show();
-}
+  publishFrame(dirty);
 
-void DisplayManager::setBrightness(uint8_t brightness) {
-  FastLED.setBrightness(brightness);
+  framesPushed++;
+  for (uint8_t i = 0; i < PANEL_COUNT; i++) {
+    if (dirty & (1 << i)) panelPushes[i]++;
+  }
+
+  if (outputTaskHandle != nullptr) {
+    xTaskNotifyGive(outputTaskHandle);
+  }
 }
 
-CRGB& DisplayManager::pixel(uint8_t x, uint8_t y) {
-  if (x >= CANVAS_WIDTH) x = CANVAS_WIDTH - 1;
-  if (y >= CANVAS_HEIGHT) y = CANVAS_HEIGHT - 1;
-  return (*canvas)(x, y);
+void DisplayManager::invalidate() {
+  forceRedraw = true;
 }
 
-void DisplayManager::setPixel(uint8_t x, uint8_t y, CRGB color) {
-  if (x < CANVAS_WIDTH && y < CANVAS_HEIGHT) {
-    (*canvas)(x, y) = color;
-  }
+// FNV-1a über die Farben des gemischten Bildes, das ein Panel anzeigt.
+// Neu gemischte Zeilen können dasselbe ergeben wie vorher (Uhr wird
+// jeden Frame neu gezeichnet), erst der Hash entscheidet über den Push.
+uint32_t DisplayManager::hashPanelRegion(uint8_t panel) const {
+  return composed.hash(BoardLayout::tileX(panel), BoardLayout::tileY(panel),
+                     BoardLayout::TILE_WIDTH, BoardLayout::TILE_HEIGHT);
 }
 
-void DisplayManager::fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, CRGB color) {
-  for (uint8_t j = y; j < y + h && j < CANVAS_HEIGHT; j++) {
-    for (uint8_t i = x; i < x + w && i < CANVAS_WIDTH; i++) {
-      setPixel(i, j, color);
+// Bitmaske der Panels, deren Inhalt sich seit dem letzten Push geändert hat.
+// Panels ohne neu gemischte Zeile werden gar nicht erst gehasht.
+uint8_t DisplayManager::collectDirtyPanels(uint32_t changedRows) {
+  const uint32_t tileRows = (1u << BoardLayout::TILE_HEIGHT) - 1;
+  uint8_t dirty = 0;
+  for (uint8_t i = 0; i < PANEL_COUNT; i++) {
+    if (!forceRedraw && !(changedRows & (tileRows << BoardLayout::tileY(i)))) continue;
+    uint32_t hash = hashPanelRegion(i);
+    if (forceRedraw || hash != panelHash[i]) {
+      panelHash[i] = hash;
+      dirty |= (1 << i);
     }
   }
+  forceRedraw = false;
+  return dirty;
 }
 
-void DisplayManager::updatePanels() {
-  // Canvas: 64x16 Pixel
-  // Oberes Panel (PIN_TOP/25): Zeilen 0-7 des Canvas
-  // Unteres Panel (PIN_BOTTOM/26): Zeilen 8-15 des Canvas
-
-  // Oberes Panel: Canvas-Zeilen 0-7
-  for (uint8_t y = 0; y < PANEL_HEIGHT; y++) {
-    for (uint8_t x = 0; x < PANEL_WIDTH; x++) {
-      (*panelTop)(x, y) = (*canvas)(x, y);
-    }
-  }
+// Render-Thread: fertigen Back-Puffer gegen den "ready"-Slot tauschen.
+// Ein noch nicht abgeholtes älteres Bild wird verworfen, seine Panels
+// gehen mit dem neuen raus. Der Tausch gelingt nur, solange der Slot noch
+// das Bild enthält, dessen Maske übernommen wurde; hat die Ausgabe es
+// inzwischen abgeholt, zählt nur die eigene Maske.
+void DisplayManager::publishFrame(uint8_t dirty) {
+  PanelFrame& back = frames[backIndex];
+  uint8_t previous = readyState.load();
+  do {
+    back.dirty = dirty;
+    if (previous & READY_NEW) back.dirty |= frames[previous & READY_INDEX_MASK].dirty;
+  } while (!readyState.compare_exchange_weak(previous, backIndex | READY_NEW));
+  backIndex = previous & READY_INDEX_MASK;
+}
 
-  // Unteres Panel: Canvas-Zeilen 8-15
-  for (uint8_t y = 0; y < PANEL_HEIGHT; y++) {
-    uint8_t canvasY = y + PANEL_HEIGHT; // 8-15
-    for (uint8_t x = 0; x < PANEL_WIDTH; x++) {
-      (*panelBottom)(x, y) = (*canvas)(x, canvasY);
-    }
+// Ausgabe-Task: neuestes Bild übernehmen, false wenn keins da ist
+bool DisplayManager::acquireFrame() {
+  if ((readyState.load() & READY_NEW) == 0) return false;
+  uint8_t previous = readyState.exchange(frontIndex);
+  frontIndex = previous & READY_INDEX_MASK;
+  return true;
+}
+
+void DisplayManager::outputTask(void* parameter) {
+  DisplayManager* display = static_cast<DisplayManager*>(parameter);
+
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (!display->acquireFrame()) continue;
+
+    // Masken verworfener Zwischenbilder stecken schon in front.dirty
+    PanelFrame& front = display->frames[display->frontIndex];
+    display->output->show(front.leds, front.dirty, display->brightness);
   }
+}
 
-  // Falls nötig: Spiegelung und Rotation (abhängig von der physischen Verkabelung)
-  // Kommentiere diese aus, wenn die Anzeige falsch herum ist
-  // mirrorPanelHorizontal(panelTop);
-  // mirrorPanelHorizontal(panelBottom);
-  // rotatePanel180(panelTop);
+void DisplayManager::setBrightness(uint8_t brightness) {
+  this->brightness = brightness;
+  invalidate();
 }
 
-void DisplayManager::mirrorPanelHorizontal(cLEDMatrix<PANEL_WIDTH, PANEL_HEIGHT, VERTICAL_ZIGZAG_MATRIX>* panel) {
-  for (uint8_t y = 0; y < PANEL_HEIGHT; y++) {
-    for (uint8_t x = 0; x < PANEL_WIDTH / 2; x++) {
-      uint8_t xo = PANEL_WIDTH - 1 - x;
-      CRGB tmp = (*panel)(x, y);
-      (*panel)(x, y) = (*panel)(xo, y);
-      (*panel)(xo, y) = tmp;
-    }
-  }
+// Basis-Ebene, nicht das gemischte Bild
+CRGB DisplayManager::getPixel(uint8_t x, uint8_t y) const {
+  return baseLayer.getPixel(x, y);
 }
 
-void DisplayManager::rotatePanel180(cLEDMatrix<PANEL_WIDTH, PANEL_HEIGHT, VERTICAL_ZIGZAG_MATRIX>* panel) {
-  for (uint8_t y = 0; y < PANEL_HEIGHT; y++) {
-    for (uint8_t x = 0; x < PANEL_WIDTH / 2; x++) {
-      uint8_t xo = PANEL_WIDTH - 1 - x;
-      uint8_t yo = PANEL_HEIGHT - 1 - y;
-      CRGB tmp = (*panel)(x, y);
-      (*panel)(x, y) = (*panel)(xo, yo);
-      (*panel)(xo, yo) = tmp;
-    }
-  }
+void DisplayManager::setPixel(uint8_t x, uint8_t y, CRGB color) {
+  baseLayer.setPixel(x, y, color);
+}
+
+void DisplayManager::fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, CRGB color) {
+  baseLayer.fillRect(x, y, w, h, color);
+}
+
+void DisplayManager::updatePanels() {
+  // Immer in den Back-Puffer, den liest der Ausgabe-Task nicht.
+  // Position, Spiegelung und Rotation der Panels stehen in BoardLayout.
+  BoardLayout::blit(composed, frames[backIndex].leds);
 }
 
 DisplayManager::~DisplayManager() {
-  delete panelTop;
-  delete panelBottom;
-  delete canvas;
+  delete output;
 }
@@ -1,40 +1,43 @@
 #include "MenuManager.h"
 #include <LEDText.h>
+#include <PixelLog.h>
 
-MenuManager::MenuManager(Joystick* joystick)
+MenuManager::MenuManager(QueueHandle_t inputEvents)
   : selectedIndex(0), currentState(AppState::MENU), currentApp(nullptr),
-    display(DisplayManager::getInstance()), joystick(joystick),
-    lastUpdate(0), lastNavigationTime(0), joystickMoved(false),
-    menuVisible(false), menuScrollOffset(0), menuAnimationOffset(0.0f) {}
+    display(DisplayManager::getInstance()), borderLayer(nullptr), menuLayer(nullptr),
+    inputEvents(inputEvents), lastUpdate(0),
+    menuVisible(false), menuScrollOffset(0), menuAnimationOffset(0.0f),
+    drawnMenuOffset(0), drawnSelectedIndex(-1) {}
 
 void MenuManager::init() {
   display->init();
-  Serial.println(F("MenuManager initialisiert"));
-  Serial.print(F("Anzahl Menü-Items: "));
-  Serial.println(menuItems.size());
-  Serial.println(F("Langer Tasterdruck (1s) zum Öffnen/Schließen des Menüs"));
+  borderLayer = display->createLayer(BORDER_LAYER_Z);
+  menuLayer = display->createLayer(MENU_LAYER_Z);
+  drawBorderRow();
+  logLine("MenuManager initialisiert, %u Menü-Items", menuItems.size());
+  logLine("Langer Tasterdruck (1s) zum Öffnen/Schließen des Menüs");
 }
 
 void MenuManager::addMenuItem(const char* name, BaseApp* app, bool enabled) {
   menuItems.push_back(MenuItem(name, app, enabled));
-  Serial.print(F("Menü-Item hinzugefügt: "));
-  Serial.println(name);
+  drawnSelectedIndex = -1;
+  logLine("Menü-Item hinzugefügt: %s", name);
 }
 
 void MenuManager::update() {
   unsigned long now = millis();
-  joystick->update();
 
-  // Prüfe auf langen Tasterdruck für Menü-Toggle
-  handleMenuToggle();
+  // Alle Eingaben seit dem letzten Frame, ohne zu warten; abgetastet
+  // werden Joystick und Taster im Eingabe-Task
+  InputEvent event;
+  while (xQueueReceive(inputEvents, &event, 0) == pdTRUE) {
+    handleInput(event);
+  }
 
   if (now - lastUpdate >= MENU_UPDATE_INTERVAL) {
     lastUpdate = now;
 
-    if (currentState == AppState::MENU && menuVisible) {
-      // Im Menü: Navigation und Auswahl
-      handleNavigation();
-    } else if (currentState == AppState::RUNNING_APP) {
+    if (currentState == AppState::RUNNING_APP) {
       // In App: Zurück zum Menü mit langem Druck (wird in handleMenuToggle behandelt)
       if (currentApp != nullptr) {
         currentApp->update();
@@ -48,62 +51,54 @@ void MenuManager::update() {
   }
 }
 
+void MenuManager::handleInput(const InputEvent& event) {
+  // Langer Tasterdruck zum Öffnen/Schließen des Menüs, auch aus einer App
+  if (event.type == INPUT_LONG_PRESS) {
+    handleMenuToggle();
+  } else if (currentState == AppState::MENU && menuVisible) {
+    // Im Menü: Navigation und Auswahl
+    handleNavigation(event);
+  }
+}
+
 void MenuManager::handleMenuToggle() {
-  // Langer Tasterdruck zum Öffnen/Schließen des Menüs
-  if (joystick->wasLongPressed(LONG_PRESS_DURATION)) {
-    if (currentState == AppState::RUNNING_APP) {
-      // Aus App zurück zum Menü
-      Serial.println(F("Langer Druck: Zurück zum Menü"));
-      exitCurrentApp();
-      menuVisible = true;
-    } else {
-      // Menü öffnen/schließen
-      menuVisible = !menuVisible;
-      Serial.print(F("Menü "));
-      Serial.println(menuVisible ? F("geöffnet") : F("geschlossen"));
-
-      if (!menuVisible) {
-        // Menü geschlossen: Zurück zur Uhr
-        if (currentApp != nullptr) {
-          currentApp->cleanup();
-          currentApp = nullptr;
-        }
-        currentState = AppState::MENU;
+  if (currentState == AppState::RUNNING_APP) {
+    // Aus App zurück zum Menü
+    logLine("Langer Druck: Zurück zum Menü");
+    exitCurrentApp();
+    menuVisible = true;
+  } else {
+    // Menü öffnen/schließen
+    menuVisible = !menuVisible;
+    logLine("Menü %s", menuVisible ? "geöffnet" : "geschlossen");
+
+    if (!menuVisible) {
+      // Menü geschlossen: Zurück zur Uhr
+      if (currentApp != nullptr) {
+        currentApp->cleanup();
+        currentApp = nullptr;
       }
+      currentState = AppState::MENU;
     }
   }
 }
 
-void MenuManager::handleNavigation() {
+void MenuManager::handleNavigation(const InputEvent& event) {
   if (menuItems.empty()) return;
-  unsigned long now = millis();
-  int yValue = joystick->getYValue();
 
-  // Navigation mit Joystick
-  if (yValue < 1500 && !joystickMoved && (now - lastNavigationTime > JOYSTICK_DEBOUNCE)) {
+  // Ein Schritt pro Auslenkung; gehalten wird nicht wiederholt, erst
+  // zurück in die Mitte (eigenes Ereignis) und wieder hinaus
+  if (event.type == INPUT_DIRECTION && event.direction == INPUT_LEFT) {
     selectedIndex--;
     if (selectedIndex < 0) selectedIndex = menuItems.size() - 1;
-    joystickMoved = true;
-    lastNavigationTime = now;
-    Serial.print(F("Menü nach oben: "));
-    Serial.println(menuItems[selectedIndex].name);
-  }
-  else if (yValue > 2500 && !joystickMoved && (now - lastNavigationTime > JOYSTICK_DEBOUNCE)) {
+    logLine("Menü nach links: %s", menuItems[selectedIndex].name);
+  } else if (event.type == INPUT_DIRECTION && event.direction == INPUT_RIGHT) {
     selectedIndex++;
     if (selectedIndex >= menuItems.size()) selectedIndex = 0;
-    joystickMoved = true;
-    lastNavigationTime = now;
-    Serial.print(F("Menü nach unten: "));
-    Serial.println(menuItems[selectedIndex].name);
-  }
-  else if (yValue >= 1500 && yValue <= 2500) {
-    joystickMoved = false;
-  }
-
-  // Auswahl mit kurzem Tasterdruck
-  if (joystick->wasPressed()) {
-    Serial.print(F("Menü-Item ausgewählt: "));
-    Serial.println(menuItems[selectedIndex].name);
+    logLine("Menü nach rechts: %s", menuItems[selectedIndex].name);
+  } else if (event.type == INPUT_CLICK) {
+    // Auswahl mit kurzem Tasterdruck
+    logLine("Menü-Item ausgewählt: %s", menuItems[selectedIndex].name);
     enterSelectedApp();
   }
 }
@@ -117,8 +112,7 @@ void MenuManager::enterSelectedApp() {
       menuVisible = false; // Menü ausblenden wenn App läuft
       display->clear();
       currentApp->init();
-      Serial.print(F("App gestartet: "));
-      Serial.println(item.name);
+      logLine("App gestartet: %s", item.name);
     }
   }
 }
@@ -131,34 +125,38 @@ void MenuManager::exitCurrentApp() {
   currentState = AppState::MENU;
   menuVisible = true;
   display->clear();
-  Serial.println(F("App beendet, zurück zum Menü"));
+  logLine("App beendet, zurück zum Menü");
 }
 
 void MenuManager::render() {
+  // Nur die Basis-Ebene (App bzw. Uhr) wird jeden Frame neu gezeichnet.
+  // Rand und Menü liegen auf eigenen Ebenen, show() mischt nur die
+  // Zeilen neu, in denen sich etwas geändert hat.
   display->clear();
 
-  // Immer anzeigen: Weißer Rand oben
-  drawBorderRow();
-
   if (currentState == AppState::RUNNING_APP && currentApp != nullptr) {
-    // App läuft: App rendert den kompletten Bildschirm
+    // App läuft: App rendert den kompletten Bildschirm (über dem Rand)
     currentApp->render();
   } else {
     // Menü-Modus: Zeit + optional Menü
     drawTime();
+  }
 
-    if (menuVisible) {
-      drawMenu();
-    }
+  bool showMenu = currentState == AppState::MENU && menuVisible;
+  if (menuLayer != nullptr) {
+    menuLayer->setVisible(showMenu);
+    if (showMenu) drawMenu();
   }
 
   display->show();
 }
 
 void MenuManager::drawBorderRow() {
-  // Oberste Zeile: Weiße LEDs als Orientierungshilfe
+  // Oberste Zeile: Weiße LEDs als Orientierungshilfe, bleibt stehen
+  if (borderLayer == nullptr) return;
+  borderLayer->clear();
   for (uint8_t x = 0; x < display->getWidth(); x++) {
-    display->setPixel(x, BORDER_ROW, CRGB::White);
+    borderLayer->setPixel(x, BORDER_ROW, CRGB::White);
   }
 }
 
@@ -181,14 +179,21 @@ void MenuManager::drawMenu() {
   float targetOffset = -selectedIndex * spacing;
   menuAnimationOffset += (targetOffset - menuAnimationOffset) * 0.2f;
 
+  // Ebene nur neu zeichnen, wenn sich die Balken um ein Pixel bewegt
+  // haben oder die Auswahl gewechselt hat; steht das Menü, kostet es nichts
+  int offset = lroundf(menuAnimationOffset);
+  if (offset == drawnMenuOffset && selectedIndex == drawnSelectedIndex) return;
+  drawnMenuOffset = offset;
+  drawnSelectedIndex = selectedIndex;
+
+  menuLayer->clear();
   for (int i = 0; i < menuItems.size(); i++) {
-    float xOffset = menuAnimationOffset + (i * spacing);
     bool selected = (i == selectedIndex);
-    drawMenuItem(i, xOffset + 32, selected); // Zentriert bei x=32
+    drawMenuItem(i, offset + i * spacing + 32, selected); // Zentriert bei x=32
   }
 }
 
-void MenuManager::drawMenuItem(int index, float xOffset, bool selected) {
+void MenuManager::drawMenuItem(int index, int startX, bool selected) {
   if (index < 0 || index >= menuItems.size()) return;
 
   const MenuItem& item = menuItems[index];
@@ -205,7 +210,6 @@ void MenuManager::drawMenuItem(int index, float xOffset, bool selected) {
   }
 
   // Einfache Text-Darstellung (erste Buchstaben des Namens)
-  int startX = (int)xOffset;
   int len = strlen(item.name);
 
   // Zeichne einen Balken für das Item
@@ -215,7 +219,7 @@ void MenuManager::drawMenuItem(int index, float xOffset, bool selected) {
         int px = startX + x;
         int py = yPos + y;
         if (px >= 0 && px < display->getWidth() && py < display->getHeight()) {
-          display->setPixel(px, py, color);
+          menuLayer->setPixel(px, py, color);
         }
       }
     }
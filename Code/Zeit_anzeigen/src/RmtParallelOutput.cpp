@@ -0,0 +1,105 @@
+#include "RmtParallelOutput.h"
+#include <PixelLog.h>
+
+#ifdef ESP32
+
+#include <driver/rmt.h>
+
+// RMT-Takt 80 MHz / 2 = 40 MHz → 25 ns pro Tick. Pulse aus LedOutput.h,
+// damit Treiber und wireTimeUs() dieselbe Bitzeit haben.
+#define RMT_CLOCK_DIV   2
+#define RMT_NS_PER_TICK 25
+#define WS2812_T0H      (WS2812_T0H_NS / RMT_NS_PER_TICK)  // 16
+#define WS2812_T0L      (WS2812_T0L_NS / RMT_NS_PER_TICK)  // 34
+#define WS2812_T1H      (WS2812_T1H_NS / RMT_NS_PER_TICK)  // 32
+#define WS2812_T1L      (WS2812_T1L_NS / RMT_NS_PER_TICK)  // 18
+
+// Übersetzt GRB-Bytes in RMT-Pulse, läuft im RMT-Interrupt
+static void IRAM_ATTR ws2812Translate(const void* src, rmt_item32_t* dest,
+                                      size_t srcSize, size_t wantedNum,
+                                      size_t* translatedSize, size_t* itemNum) {
+  if (src == nullptr || dest == nullptr) {
+    *translatedSize = 0;
+    *itemNum = 0;
+    return;
+  }
+
+  rmt_item32_t bit0;
+  bit0.duration0 = WS2812_T0H; bit0.level0 = 1;
+  bit0.duration1 = WS2812_T0L; bit0.level1 = 0;
+  rmt_item32_t bit1;
+  bit1.duration0 = WS2812_T1H; bit1.level0 = 1;
+  bit1.duration1 = WS2812_T1L; bit1.level1 = 0;
+
+  const uint8_t* bytes = static_cast<const uint8_t*>(src);
+  size_t size = 0;
+  size_t num = 0;
+  while (size < srcSize && num + 8 <= wantedNum) {
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      dest->val = (bytes[size] & (0x80 >> bit)) ? bit1.val : bit0.val;
+      dest++;
+    }
+    num += 8;
+    size++;
+  }
+  *translatedSize = size;
+  *itemNum = num;
+}
+
+RmtParallelOutput::RmtParallelOutput() : stringCount(0), ledsPerString(0) {
+  for (uint8_t i = 0; i < RMT_OUTPUT_MAX_STRINGS; i++) {
+    encoded[i] = nullptr;
+  }
+}
+
+RmtParallelOutput::~RmtParallelOutput() {
+  for (uint8_t i = 0; i < stringCount; i++) {
+    rmt_driver_uninstall((rmt_channel_t)i);
+    delete[] encoded[i];
+  }
+}
+
+void RmtParallelOutput::begin(CRGB* leds, const uint8_t* pins,
+                              uint8_t stringCount, uint16_t ledsPerString) {
+  if (stringCount > RMT_OUTPUT_MAX_STRINGS) {
+    logLine("RMT: mehr Strings als Kanäle, Rest wird ignoriert");
+    stringCount = RMT_OUTPUT_MAX_STRINGS;
+  }
+  this->stringCount = stringCount;
+  this->ledsPerString = ledsPerString;
+
+  for (uint8_t i = 0; i < stringCount; i++) {
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)pins[i], (rmt_channel_t)i);
+    config.clk_div = RMT_CLOCK_DIV;
+    rmt_config(&config);
+    rmt_driver_install(config.channel, 0, 0);
+    rmt_translator_init(config.channel, ws2812Translate);
+
+    encoded[i] = new uint8_t[ledsPerString * 3];
+  }
+}
+
+void RmtParallelOutput::show(const CRGB* leds, uint8_t mask, uint8_t brightness) {
+  // Erst alles kodieren, damit die Kanäle möglichst gleichzeitig starten
+  for (uint8_t i = 0; i < stringCount; i++) {
+    if (mask & (1 << i)) {
+      encodeGRB(leds + i * ledsPerString, ledsPerString, brightness, encoded[i]);
+    }
+  }
+
+  for (uint8_t i = 0; i < stringCount; i++) {
+    if (mask & (1 << i)) {
+      rmt_write_sample((rmt_channel_t)i, encoded[i], ledsPerString * 3, false);
+    }
+  }
+
+  for (uint8_t i = 0; i < stringCount; i++) {
+    if (mask & (1 << i)) {
+      rmt_wait_tx_done((rmt_channel_t)i, portMAX_DELAY);
+    }
+  }
+
+  delayMicroseconds(WS2812_RESET_US);
+}
+
+#endif
@@ -0,0 +1,53 @@
+#include "TimingModelOutput.h"
+
+TimingModelOutput::TimingModelOutput()
+  : stringCount(0), ledsPerString(0), lastMask(0), lastFrameUs(0),
+    lastSequentialUs(0), frameCount(0), totalWireUs(0) {
+  for (uint8_t i = 0; i < TIMING_MODEL_MAX_STRINGS; i++) {
+    encoded[i] = nullptr;
+  }
+}
+
+TimingModelOutput::~TimingModelOutput() {
+  for (uint8_t i = 0; i < stringCount; i++) {
+    delete[] encoded[i];
+  }
+}
+
+void TimingModelOutput::begin(CRGB* leds, const uint8_t* pins,
+                              uint8_t stringCount, uint16_t ledsPerString) {
+  if (stringCount > TIMING_MODEL_MAX_STRINGS) {
+    stringCount = TIMING_MODEL_MAX_STRINGS;
+  }
+  this->stringCount = stringCount;
+  this->ledsPerString = ledsPerString;
+
+  for (uint8_t i = 0; i < stringCount; i++) {
+    encoded[i] = new uint8_t[ledsPerString * 3];
+  }
+}
+
+void TimingModelOutput::show(const CRGB* leds, uint8_t mask, uint8_t brightness) {
+  uint32_t longest = 0;
+  uint32_t sum = 0;
+
+  for (uint8_t i = 0; i < stringCount; i++) {
+    if ((mask & (1 << i)) == 0) continue;
+
+    encodeGRB(leds + i * ledsPerString, ledsPerString, brightness, encoded[i]);
+
+    uint32_t wire = wireTimeUs(ledsPerString);
+    if (wire > longest) longest = wire;
+    sum += wire;
+  }
+
+  lastMask = mask;
+  lastFrameUs = longest;
+  lastSequentialUs = sum;
+  frameCount++;
+  totalWireUs += longest;
+}
+
+const uint8_t* TimingModelOutput::getEncoded(uint8_t string) const {
+  return string < stringCount ? encoded[string] : nullptr;
+}
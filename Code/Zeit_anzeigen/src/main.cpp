@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include <FastLED.h>
+#include <PixelLog.h>
 
 // LED Strips - 2 rows only!
 #define PIN_TOP    25    // Top row: 32 LEDs
@@ -66,8 +67,9 @@ void drawMenu() {
 
 void setup() {
   Serial.begin(115200);
+  logInit();
   delay(1000);
-  Serial.println(F("Menu System - Snake/Exit"));
+  logLine("Menu System - Snake/Exit");
 
   // Initialize LEDs
   FastLED.addLeds<WS2812, PIN_TOP, GRB>(ledsTop, NUM_LEDS_PER_ROW);
@@ -75,7 +77,7 @@ void setup() {
   FastLED.setBrightness(80);
   FastLED.clear(true);
 
-  Serial.println(F("Setup complete. Menu initialized."));
+  logLine("Setup complete. Menu initialized.");
 }
 
 void loop() {